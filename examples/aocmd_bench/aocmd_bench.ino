@@ -0,0 +1,192 @@
+// aocmd_bench.ino - measures the command interpreter on recorded workloads
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <aospi.h>          // aospi_init()
+#include <aoosp.h>          // aoosp_init()
+#include <aocmd.h>          // generic include for whole aocmd lib
+
+
+/*
+DESCRIPTION
+This demo measures how long the command interpreter takes for typical 
+command lines. It has recorded workloads (lists of command lines, as a 
+host like osplink.py would send them) and feeds them with aocmd_cint_addstr() 
+to the interpreter, just like aocmd_cint_pollserial() would. The output 
+goes to a sink that only counts bytes, so the measurement excludes the UART. 
+Each workload is run twice: once with the counting sink, and once with 
+the null sink (which skips formatting). The difference is the formatting 
+cost. The demo adds command "bench" to rerun the measurement.
+
+HARDWARE
+The demo runs on the OSP32 board. The "offline" workload needs no demo 
+board. The "chain" workload sends telegrams; for realistic timing attach 
+a chain (e.g. SAIDbasic in BiDir), otherwise the telegrams time out. 
+In Arduino select board "ESP32S3 Dev Module".
+
+BEHAVIOR
+The "chain" workload switches on the first node of the chain.
+
+OUTPUT (numbers depend on board, chain, and library configuration)
+Welcome to aocmd_bench.ino
+spi: init
+osp: init
+cmd: init
+
+Type 'help' for help
+Try 'bench' and 'bench 100 chain'
+>> bench
+workload  lines   reps   us/line  us/line(null)  bytes/line
+offline       8     10       ...            ...         ...
+>> 
+*/
+
+
+// A workload is a list of command lines (each ending in \n)
+typedef struct bench_workload_s {
+  const char *         name;
+  const char * const * lines;
+  int                  count;
+} bench_workload_t;
+
+
+// Workload "offline": commands that do not send telegrams.
+static const char * const bench_lines_offline[] = {
+  "echo line Hello, world!\n",
+  "help osp send\n",
+  "osp fields A0 04 02 A9\n",
+  #if AOCMD_CONFIG_OSP_INFO
+  "osp info setpwmchn\n",
+  #endif
+  "osp format\n",
+  "file list\n",
+  "version\n",
+  "@echo wait 0 // comment\n",
+};
+
+
+// Workload "chain": a typical host sequence to switch on the first node.
+static const char * const bench_lines_chain[] = {
+  "osp resetinit\n",
+  "osp send 001 clrerror\n",
+  "osp send 001 goactive\n",
+  "osp send 001 setpwmchn 00 FF 33 33 00 00 00 00\n",
+  "osp send 001 readstat\n",
+  "osp send 001 readpwmchn 00\n",
+};
+
+
+#define BENCH_WORKLOAD(name,lines) { name, lines, sizeof(lines)/sizeof(lines[0]) }
+static const bench_workload_t bench_workloads[] = {
+  BENCH_WORKLOAD( "offline", bench_lines_offline ),
+  BENCH_WORKLOAD( "chain"  , bench_lines_chain   ),
+};
+#define BENCH_WORKLOAD_COUNT ( sizeof(bench_workloads)/sizeof(bench_workloads[0]) )
+
+
+// An output sink that only counts the bytes written
+class bench_countsink_c : public Print {
+  public:
+    uint32_t count;
+    size_t write(uint8_t ch) override { (void)ch; count++; return 1; }
+    size_t write(const uint8_t * buf, size_t size) override { (void)buf; count+=size; return size; }
+};
+static bench_countsink_c bench_countsink;
+
+
+// Feeds all lines of workload `wl` `reps` times to the command interpreter, returns the time in us.
+static uint32_t bench_time( const bench_workload_t * wl, int reps ) {
+  uint32_t t0= micros();
+  for( int r=0; r<reps; r++ )
+    for( int i=0; i<wl->count; i++ ) aocmd_cint_addstr(wl->lines[i]);
+  return micros()-t0;
+}
+
+
+// Runs workload `wl` `reps` times with the counting sink, and with the null sink, and prints the results
+static void bench_run( const bench_workload_t * wl, int reps ) {
+  Print * out= aocmd_cint_out_get(); 
+  bench_countsink.count= 0;
+  aocmd_cint_out_set(&bench_countsink);
+  uint32_t us_count= bench_time(wl,reps);
+  aocmd_cint_out_set(0);
+  uint32_t us_null= bench_time(wl,reps);
+  aocmd_cint_out_set(out);
+  int lines= wl->count*reps;
+  aocmd_cint_printf("%-8s %6d %6d %9lu %14lu %11lu\n", wl->name, wl->count, reps, 
+    (unsigned long)(us_count/lines), (unsigned long)(us_null/lines), (unsigned long)(bench_countsink.count/lines) );
+}
+
+
+// The command handler for the "bench" command
+static void cmdbench_main(int argc, char * argv[]) {
+  if( argc>3 ) { aocmd_cint_printf("ERROR: bench: too many args\n"); return; }
+  int reps= 10;
+  if( argc>=2 ) {
+    bool ok= aocmd_cint_parse_dec(argv[1],&reps);
+    if( !ok || reps<1 ) { aocmd_cint_printf("ERROR: bench: <reps> must be positive decimal, not '%s'\n",argv[1]); return; }
+  }
+  // Select workloads now: the interpreter reuses the buffer argv points into
+  int select= -1; // all workloads
+  if( argc==3 ) {
+    for( int i=0; i<BENCH_WORKLOAD_COUNT; i++ ) if( strcmp(argv[2],bench_workloads[i].name)==0 ) select= i;
+    if( select==-1 ) { aocmd_cint_printf("ERROR: bench: unknown workload '%s'\n",argv[2]); return; }
+  }
+  aocmd_cint_printf("workload  lines   reps   us/line  us/line(null)  bytes/line\n");
+  for( int i=0; i<BENCH_WORKLOAD_COUNT; i++ ) {
+    if( select==i || (select==-1 && i==0) ) bench_run(&bench_workloads[i],reps); // "chain" only on request
+  }
+}
+
+
+// The long help for the "bench" command
+static const char cmdbench_longhelp[] = 
+  "SYNTAX: bench [ <reps> [ <workload> ] ]\n"
+  "- runs the recorded <workload> <reps> times (default 10), and prints time per line\n"
+  "- without <workload> runs 'offline'; <workload> is 'offline' or 'chain'\n"
+  "- 'chain' sends telegrams (attach a chain)\n"
+;
+
+
+// Registers "bench" command
+static void cmdbench_register() {
+  aocmd_cint_register(cmdbench_main, "bench", "measures the command interpreter on recorded workloads", cmdbench_longhelp);
+}
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf("\n\nWelcome to aocmd_bench.ino\n");
+
+  aospi_init(); // used by command "osp" in aocmd
+  aoosp_init(); // used by command "osp" in aocmd
+  aocmd_init();
+  aocmd_register(); // register all commands in aocmd lib
+  cmdbench_register(); // register own command
+  Serial.printf("\n");
+
+  Serial.print( "Type 'help' for help\n" );
+  Serial.print( "Try 'bench' and 'bench 100 chain'\n" );
+  aocmd_cint_prompt();
+}
+
+
+void loop() {
+  aocmd_cint_pollserial();
+}
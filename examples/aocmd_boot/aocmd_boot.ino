@@ -104,17 +104,17 @@ static uint32_t cmdwait_ms = 30*1000;
 // The command handler for the "wait" command
 static void cmdwait_main(int argc, char * argv[]) {
   if( argc==1  ) { 
-    Serial.printf("wait: %lu ms\n", cmdwait_ms);
+    aocmd_cint_printf("wait: %lu ms\n", cmdwait_ms);
     return;
   }
   if( argc==2 ) {
     int val;
     bool ok= aocmd_cint_parse_dec(argv[1],&val) ;
-    if( !ok || val<0) { Serial.printf("ERROR: wait: value must be non-negative decimal '%s'\n",argv[1]); return; }
+    if( !ok || val<0) { aocmd_cint_printf("ERROR: wait: value must be non-negative decimal '%s'\n",argv[1]); return; }
     cmdwait_ms= val;
     return;
   }
-  Serial.printf("ERROR: wait: unknown argument\n");
+  aocmd_cint_printf("ERROR: wait: unknown argument\n");
 }
 
 
@@ -164,6 +164,10 @@ void setup() {
 void loop() {
   // Processing of incoming commands
   aocmd_cint_pollserial();
+  // Background work of 'osp monitor', 'said sample' and 'board perf'
+  aocmd_osp_monitor_poll();
+  aocmd_said_sample_poll();
+  aocmd_board_perf_poll();
 
   // Main application
   if( millis()-last > cmdwait_ms ) {
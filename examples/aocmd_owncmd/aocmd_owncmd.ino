@@ -82,15 +82,15 @@ static void cmdstat_main(int argc, char * argv[]) {
   if( argc==2 && aocmd_cint_isprefix("reset",argv[1]) ) { 
     cmdstat_count= 0;
     cmdstat_sum= 0;
-    Serial.printf("stat: reset\n");
+    aocmd_cint_printf("stat: reset\n");
     return;
   }
   if( argc==1 || (argc==2 && aocmd_cint_isprefix("show",argv[1])) ) {
-    Serial.printf("stat: %d/%d", cmdstat_sum, cmdstat_count); 
+    aocmd_cint_printf("stat: %d/%d", cmdstat_sum, cmdstat_count); 
     if( cmdstat_count>0 ) { 
-      Serial.printf("=%0.2f\n",(float)cmdstat_sum/cmdstat_count); 
+      aocmd_cint_printf("=%0.2f\n",(float)cmdstat_sum/cmdstat_count); 
     } else {
-      Serial.printf("\n");
+      aocmd_cint_printf("\n");
     }
     return;
   }
@@ -98,7 +98,7 @@ static void cmdstat_main(int argc, char * argv[]) {
     uint16_t val;
     bool ok= aocmd_cint_parse_hex(argv[i],&val) ;
     if( !ok ) {
-      Serial.printf("ERROR: sum: value must be hex (is '%s')\n",argv[i]);
+      aocmd_cint_printf("ERROR: sum: value must be hex (is '%s')\n",argv[i]);
       return;
     }
     cmdstat_sum+= val;
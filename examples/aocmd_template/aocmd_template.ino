@@ -69,15 +69,15 @@ file    : aocmd_template.ino
 // Library aocmd "upcalls" via aocmd_version_app() to allow the application to print its version.
 // If not implemented, version command prints "no application version registered\n".
 void aocmd_version_app() {
-  Serial.printf("%s %s\n", AOCMD_TEMPLATE_LONGNAME, AOCMD_TEMPLATE_VERSION );
+  aocmd_cint_printf("%s %s\n", AOCMD_TEMPLATE_LONGNAME, AOCMD_TEMPLATE_VERSION );
 }
 
 
 // Library aocmd "upcalls" via aocmd_version_app() to allow the application to print extra version info
 // Implementing this function is optional.
 void aocmd_version_extra() {
-  Serial.printf( "file    : %s\n", aoresult_shorten(__FILE__) ); // just a (silly) example
-  // Serial.printf( "aolibs  : ui32 %s mw %s apps %s\n", AOUI32_VERSION, AOMW_VERSION, AOAPPS_VERSION);
+  aocmd_cint_printf( "file    : %s\n", aoresult_shorten(__FILE__) ); // just a (silly) example
+  // aocmd_cint_printf( "aolibs  : ui32 %s mw %s apps %s\n", AOUI32_VERSION, AOMW_VERSION, AOAPPS_VERSION);
 }
 
 
@@ -101,6 +101,9 @@ void setup() {
 
 void loop() {
   aocmd_cint_pollserial();
+  aocmd_osp_monitor_poll(); // background work of 'osp monitor'
+  aocmd_said_sample_poll(); // background work of 'said sample'
+  aocmd_board_perf_poll();  // background work of 'board perf'
   
   // ... other processing ...
 }
@@ -3,6 +3,8 @@
 
 
 import re
+import time
+import zlib
 from time import sleep
 from serial import SerialException
 from libosplink.cmdint import CmdIntException, CmdInt, cmdint_ports
@@ -14,6 +16,11 @@ class OSPlinkException(Exception):
 
 
 class OSPlink(CmdInt):
+    def parse(self,regex,res,cmd):
+        """Returns the match of 'regex' in response 'res' of command 'cmd'; raises an exception when the response format is not as expected (e.g. changed firmware)."""
+        found= re.search(regex,res)
+        if not found : raise OSPlinkException(f"'{cmd}' response has unexpected format (expected /{regex}/, got '{res.strip()}')")
+        return found
     def open(self,port):
         """Opens serial port 'port' towards OSPlink."""
         super(OSPlink,self).open(port)
@@ -22,11 +29,11 @@ class OSPlink(CmdInt):
     def version(self,fmt="%La %Va"):
         """Returns the version; the 'fmt' can have % followed by a char (v,a,La,Va,r,c,i,t); these are replaced by version components.""" 
         v= self.exec("version")
-        ga= re.search(r"app     : ((.*) (.*))\n",v)
-        gr= re.search(r"runtime : (.*)\n",v)
-        gc= re.search(r"compiler: (.*)\n",v);
-        gi= re.search(r"arduino : (.*)\n",v);
-        gt= re.search(r"compiled: (.*)\n",v);
+        ga= self.parse(r"app     : ((.*) (.*))\n",v,"version")
+        gr= self.parse(r"runtime : (.*)\n",v,"version")
+        gc= self.parse(r"compiler: (.*)\n",v,"version")
+        gi= self.parse(r"arduino : (.*)\n",v,"version")
+        gt= self.parse(r"compiled: (.*)\n",v,"version")
         fmt= fmt.replace("%v",v)
         fmt= fmt.replace("%a",ga.group(1))         # a ='OSPlink 1.1'                     # all
         fmt=   fmt.replace("%La",ga.group(2))      # La='OSPlink'                         # long
@@ -40,23 +47,46 @@ class OSPlink(CmdInt):
         """Reboots the ESP32 (without running boot.cmd)"""
         self.exec(f"board reboot")
         self.exec(f"echo disabled") # this disables echo again AND has as side effect an rxbuf sync
+    def file_upload(self,name,data,timeout_sec=2.5):
+        """Uploads bytes 'data' to file 'name' (sends no more than the credit granted by the board), returns the bytes/s reported."""
+        self.serial.write(f"file upload {name} {len(data)} {zlib.crc32(data):08X}\n".encode())
+        if self.logfile!=None: self.log(f"file upload {name} {len(data)} {zlib.crc32(data):08X}\n",">")
+        sent,time0 = 0,time.time()
+        while True:
+            self.rxbuf+= self.serial.read(1000)
+            found= re.search(rb"upload: credit (\d+)\n",self.rxbuf)
+            if found :
+                credit= int(found.group(1))
+                self.rxbuf= self.rxbuf[found.end():]
+                self.serial.write(data[sent:sent+credit])
+                sent,time0 = sent+credit,time.time()
+                continue
+            pos= self.rxbuf.find(b">> ")
+            if pos>=0 : break
+            if time.time()-time0>timeout_sec : raise OSPlinkException(f"file_upload failed (timeout, {sent} of {len(data)} bytes sent)")
+        res= self.rxbuf[:pos].decode()
+        self.rxbuf= self.rxbuf[pos+3:]
+        if self.logfile!=None: self.log(res+">> ","<")
+        found = re.search(r"file: upload '.*' .* bytes \((.*) bytes/s\)",res);
+        if not found : raise OSPlinkException(f"file_upload failed ({res.strip()})")
+        return int(found.group(1))
     def osp_resetinit(self):
         """Sends reset and init telegram (auto configure dirmux), returns (direction:string,nodecount:int)"""
         res = self.exec(f"osp resetinit")
-        found = re.search(r"resetinit: (.*) (.*) \((.*)\)",res);
+        found = self.parse(r"resetinit: (.*) (.*) \((.*)\)",res,"osp resetinit")
         if found.group(3)!="ok" : raise OSPlinkException(f"resetinit failed {found.group(3)}")
         return found.group(1), int(found.group(2),16)
     def osp_clrerror(self,addr) :
         res = self.exec(f"@osp send {addr:X} clrerror")
-        found = re.search(r"rx none (.*)",res);
+        found = self.parse(r"rx none (.*)",res,"osp send clrerror")
         if found.group(1)!="ok" : raise OSPlinkException(f"clrerror failed {found.group(1)}")
     def osp_goactive(self,addr) :
         res = self.exec(f"@osp send {addr:X} goactive")
-        found = re.search(r"rx none (.*)",res);
+        found = self.parse(r"rx none (.*)",res,"osp send goactive")
         if found.group(1)!="ok" : raise OSPlinkException(f"goactive failed {found.group(1)}")
     def osp_setpwmchn(self,addr,chn,red,grn,blu) :
         res = self.exec(f"@osp send {addr:X} setpwmchn {chn:X} ff {red//256:X} {red%256:X} {grn//256:X} {grn%256:X} {blu//256:X} {blu%256:X}")
-        found = re.search(r"rx none (.*)",res);
+        found = self.parse(r"rx none (.*)",res,"osp send setpwmchn")
         if found.group(1)!="ok" : raise OSPlinkException(f"setpwmchn failed {found.group(1)}")
 
 
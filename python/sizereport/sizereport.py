@@ -0,0 +1,111 @@
+# sizereport.py - reports the flash and RAM used per module of aocmd, from a GNU ld map file
+#
+# Usage: python sizereport.py <mapfile> [ <prefix> ]
+#   <mapfile> is the map file written by the linker (e.g. osplink.ino.map in the build directory)
+#   <prefix>  selects the object files to report (default "aocmd"), use "" to report all
+
+import os
+import re
+import sys
+
+
+# Input section name prefixes, mapped to the column they count for.
+# Initialized data ('data') occupies RAM and (for its initial values) flash.
+KINDS = [
+  ( ".iram"        , "iram"  ),
+  ( ".rtc"         , "rtc"   ),
+  ( ".noinit"      , "rtc"   ),
+  ( ".text"        , "code"  ),
+  ( ".literal"     , "code"  ),
+  ( ".flash.text"  , "code"  ),
+  ( ".rodata"      , "const" ),
+  ( ".flash.rodata", "const" ),
+  ( ".data"        , "data"  ),
+  ( ".dram"        , "data"  ),
+  ( ".sdata"       , "data"  ),
+  ( ".bss"         , "bss"   ),
+  ( ".sbss"        , "bss"   ),
+  ( "COMMON"       , "bss"   ),
+]
+COLUMNS = [ "code", "const", "iram", "data", "bss", "rtc" ]
+
+
+def kind_of(section) :
+  for prefix,kind in KINDS :
+    if section.startswith(prefix) : return kind
+  return None
+
+
+# An input section line is " <section> 0x<addr> 0x<size> <object>".
+# When <section> is long, the linker wraps the line after the section name.
+RE_FULL = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+RE_HEAD = re.compile(r"^ (\S+)$")
+RE_TAIL = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+# Returns the module name for an object path like ".../aocmd_osp.cpp.o" or "lib.a(aocmd_osp.cpp.o)".
+def module_of(obj) :
+  m = re.search(r"\(([^)]+)\)$", obj)
+  if m : obj = m.group(1)
+  name = os.path.basename(obj.strip())
+  for ext in [".o", ".obj", ".cpp", ".c", ".S"] :
+    if name.endswith(ext) : name = name[:-len(ext)]
+  return name
+
+
+# Parses the memory map part of `mapfile`, returns dict module -> dict column -> bytes.
+def parse(mapfile, prefix) :
+  sizes = {}
+  inmap = False
+  section = None
+  with open(mapfile, "r", errors="replace") as f :
+    for line in f :
+      line = line.rstrip("\r\n")
+      if not inmap :
+        inmap = line.startswith("Linker script and memory map")
+        continue
+      m = RE_FULL.match(line)
+      if m :
+        section, size, obj = m.group(1), int(m.group(3),16), m.group(4)
+      else :
+        m = RE_TAIL.match(line) if section else None
+        if m :
+          size, obj = int(m.group(2),16), m.group(3)
+        else :
+          m = RE_HEAD.match(line)
+          section = m.group(1) if m else None
+          continue
+      kind = kind_of(section)
+      section = None
+      if kind is None or size==0 : continue
+      module = module_of(obj)
+      if not module.startswith(prefix) : continue
+      sizes.setdefault(module, dict.fromkeys(COLUMNS,0))[kind] += size
+  if not inmap : sys.exit(f"ERROR: '{mapfile}' is not a GNU ld map file (no memory map found)")
+  return sizes
+
+
+def report(sizes) :
+  width = max( [len(m) for m in sizes] + [len("module")] )
+  print( f"{'module':<{width}}" + "".join(f" {c:>7}" for c in COLUMNS) + f" {'flash':>7} {'ram':>7}" )
+  total = dict.fromkeys(COLUMNS,0)
+  rows = sorted(sizes.items(), key=lambda kv: -sum(kv[1].values()))
+  for module,col in rows + [("total",None)] :
+    if col is None : col = total
+    else :
+      for c in COLUMNS : total[c] += col[c]
+    flash = col["code"] + col["const"] + col["iram"] + col["data"]
+    ram = col["iram"] + col["data"] + col["bss"]
+    print( f"{module:<{width}}" + "".join(f" {col[c]:>7}" for c in COLUMNS) + f" {flash:>7} {ram:>7}" )
+
+
+def main() :
+  if len(sys.argv) not in (2,3) : sys.exit(f"usage: python {os.path.basename(sys.argv[0])} <mapfile> [ <prefix> ]")
+  prefix = sys.argv[2] if len(sys.argv)==3 else "aocmd"
+  sizes = parse(sys.argv[1], prefix)
+  if not sizes : sys.exit(f"ERROR: no objects starting with '{prefix}' found in '{sys.argv[1]}'")
+  report(sizes)
+
+
+if __name__ == "__main__" :
+  main()
@@ -27,26 +27,42 @@
 /*!
     @brief  Registers all commands contained in library aocmd with the command interpreter.
     @note   These commands are registered: echo, help, version, board, file, tele, said.
+            Commands compiled out via aocmd_config.h are not registered.
     @note   If client code wants a subset of the commands it should call the individual 
             aocmd_xxx_register() functions.
     @note   Order of registration is not relevant (command interpreter keeps them alphabetically). 
 */
 void aocmd_register() {
+  #if AOCMD_CONFIG_ECHO
   aocmd_echo_register(); 
+  #endif
+  #if AOCMD_CONFIG_HELP
   aocmd_help_register(); 
+  #endif
+  #if AOCMD_CONFIG_VERSION
   aocmd_version_register(); 
+  #endif
+  #if AOCMD_CONFIG_BOARD
   aocmd_board_register(); 
+  #endif
+  #if AOCMD_CONFIG_FILE
   aocmd_file_register(); 
+  #endif
+  #if AOCMD_CONFIG_OSP
   aocmd_osp_register(); 
+  #endif
+  #if AOCMD_CONFIG_SAID
   aocmd_said_register(); 
+  #endif
 }
 
 
 /*!
     @brief  Initializes the aocmd library 
-            (command interpreter, file system, telegram parser).
+            (command interpreter, crash log, file system, telegram parser).
     @note   In setup(), make sure Serial.begin() is called before aocmd_init().
-            Library aocmd reads/writes chars from/to Serial.
+            Library aocmd reads chars from Serial, and writes chars to the output 
+            sink, which is Serial unless changed with aocmd_cint_out_set().
     @note   In setup(), register commands, eg by calling aocmd_register().
     @note   In setup(), print the initial prompt with aocmd_cint_prompt().
     @note   In loop(), process incoming commands with aocmd_cint_pollserial().
@@ -58,7 +74,8 @@ void aocmd_register() {
 */
 void aocmd_init() {
   aocmd_cint_init();
+  aocmd_board_init(); // The "board" command also keeps the breadcrumbs for the crash log.
   aocmd_file_init(); // The "file" command also contains the file system implementation.
   aocmd_osp_init(); // The "osp" command also contains the tx/rx parser implementation.
-  Serial.printf("cmd: init\n");
+  aocmd_cint_printf("cmd: init\n");
 }
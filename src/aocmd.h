@@ -27,6 +27,7 @@
 
 
 // Include the (headers of the) modules of this app
+#include <aocmd_config.h>  // selection of the commands compiled into the library
 #include <aocmd_cint.h>    // the command interpreter
 #include <aocmd_echo.h>    // the command handler for "echo" 
 #include <aocmd_help.h>    // the command handler for "help" 
@@ -25,13 +25,20 @@
 #include <esp_chip_info.h>  // esp_chip_info_t
 #include <esp_mac.h>        // esp_efuse_mac_get_default()
 #include <esp_flash.h>      // esp_flash_get_size()
+#include <esp_attr.h>       // RTC_NOINIT_ATTR
+#include <esp_idf_version.h> // ESP_IDF_VERSION_MAJOR
+#include <freertos/FreeRTOS.h> // configGENERATE_RUN_TIME_STATS
+#include <freertos/task.h>  // uxTaskGetSystemState(), uxTaskGetStackHighWaterMark()
 #include <aoresult.h>       // AORESULT_ASSERT
 #include <aocmd_cint.h>     // aocmd_cint_register, aocmd_cint_isprefix, ...
 #include <aocmd_board.h>    // own
 
 
+#if AOCMD_CONFIG_BOARD
+
+
 // If the top-level application needs more board info to be printed, 
-// it should implement this function and print that to Serial.
+// it should implement this function and print that to the output sink (aocmd_cint_printf).
 void __attribute__((weak)) aocmd_board_extra() {
   // empty
 }
@@ -57,7 +64,7 @@ static const char * aocmd_board_resetreason() {
 
 
 static void aocmd_board_clk_show() {
-  Serial.printf( "clk  : %lu MHz (xtal %lu MHz)\n",getCpuFrequencyMhz(), getXtalFrequencyMhz() );
+  aocmd_cint_printf( "clk  : %lu MHz (xtal %lu MHz)\n",(unsigned long)getCpuFrequencyMhz(), (unsigned long)getXtalFrequencyMhz() );
 }
 
 
@@ -66,30 +73,293 @@ void aocmd_board_mac_show() {
 	if( esp_efuse_mac_get_default(mac)!=ESP_OK ) {
     memset( mac, 0, sizeof(mac) );
   } 
-  Serial.printf("mac  : %02X:%02X:%02X:%02X %02X:%02X:%02X:%02X\n", mac[0],mac[1],mac[2],mac[3],mac[4],mac[5],mac[6],mac[7]);
+  aocmd_cint_printf("mac  : %02X:%02X:%02X:%02X %02X:%02X:%02X:%02X\n", mac[0],mac[1],mac[2],mac[3],mac[4],mac[5],mac[6],mac[7]);
 }
 
 
 static void aocmd_board_show() {
-  Serial.printf( "chip : model %s (%d cores) rev %d\n",ESP.getChipModel(),ESP.getChipCores(), ESP.getChipRevision() );
+  aocmd_cint_printf( "chip : model %s (%d cores) rev %d\n",ESP.getChipModel(),ESP.getChipCores(), ESP.getChipRevision() );
   aocmd_board_clk_show();
-  Serial.printf( "ftrs :");
+  aocmd_cint_printf( "ftrs :");
     esp_chip_info_t info;
     esp_chip_info(&info);
-    if( info.features & BIT(0) ) Serial.printf(" Embedded-Flash");
-    if( info.features & BIT(1) ) Serial.printf(" 2.4GHz-WiFi");
-    if( info.features & BIT(4) ) Serial.printf(" Bluetooth-LE");
-    if( info.features & BIT(5) ) Serial.printf(" Bluetooth-classic");
-    Serial.printf( "\n");
+    if( info.features & BIT(0) ) aocmd_cint_printf(" Embedded-Flash");
+    if( info.features & BIT(1) ) aocmd_cint_printf(" 2.4GHz-WiFi");
+    if( info.features & BIT(4) ) aocmd_cint_printf(" Bluetooth-LE");
+    if( info.features & BIT(5) ) aocmd_cint_printf(" Bluetooth-classic");
+    aocmd_cint_printf( "\n");
   aocmd_board_mac_show();
   uint32_t flashsize; esp_flash_get_size(NULL,&flashsize);
-  Serial.printf( "flash: %ld byte %s flash\n", flashsize, (info.features & CHIP_FEATURE_EMB_FLASH) ? "embedded" : "external");
-  Serial.printf( "app  : %lu byte\n", ESP.getSketchSize() );
-  Serial.printf( "reset: %s\n",aocmd_board_resetreason() );
+  aocmd_cint_printf( "flash: %lu byte %s flash\n", (unsigned long)flashsize, (info.features & CHIP_FEATURE_EMB_FLASH) ? "embedded" : "external");
+  aocmd_cint_printf( "app  : %lu byte\n", (unsigned long)ESP.getSketchSize() );
+  aocmd_cint_printf( "reset: %s\n",aocmd_board_resetreason() );
   aocmd_board_extra();
 }
 
 
+// === board perf ===
+
+
+// The runtime statistics are sampled every AOCMD_BOARD_PERF_PERIOD_MS by aocmd_board_perf_poll().
+#define AOCMD_BOARD_PERF_PERIOD_MS  1000
+#define AOCMD_BOARD_PERF_MAXTASKS   32     // size of task table for uxTaskGetSystemState()
+
+
+// Runtime statistics (reset by 'board perf reset')
+static struct {
+  uint32_t tstart;                         // start of current period (ms)
+  uint32_t loops;                          // number of aocmd_board_perf_poll() calls in current period
+  int      samples;                        // number of periods sampled since reset
+  uint32_t rate, ratemin;                  // loop iterations per second (last period, min)
+  int      load[portNUM_PROCESSORS];       // CPU load in % per core (last period, -1 if not available)
+  int      loadmax[portNUM_PROCESSORS];    // CPU load in % per core (max)
+  uint32_t idle[portNUM_PROCESSORS];       // run time counter of idle task per core at start of period
+  uint32_t total;                          // total run time counter at start of period
+  uint32_t heapmin;                        // free heap (min)
+  int      rxmax;                          // bytes waiting in UART RX buffer (max)
+  int      txfreemin;                      // bytes free in UART TX buffer (min)
+} aocmd_board_perf;
+static bool aocmd_board_perf_started;      // false until first aocmd_board_perf_poll()
+
+
+// Gets the run time counters of the idle tasks; returns false if FreeRTOS does not collect run time stats.
+static bool aocmd_board_perf_idle(uint32_t idle[portNUM_PROCESSORS], uint32_t * total) {
+  #if configGENERATE_RUN_TIME_STATS
+    static TaskStatus_t tasks[AOCMD_BOARD_PERF_MAXTASKS];
+    UBaseType_t num= uxTaskGetSystemState(tasks, AOCMD_BOARD_PERF_MAXTASKS, total);
+    if( num==0 ) return false; // too many tasks
+    for( int core=0; core<portNUM_PROCESSORS; core++ ) {
+      #if ESP_IDF_VERSION_MAJOR>=5
+        TaskHandle_t h= xTaskGetIdleTaskHandleForCore(core);
+      #else
+        TaskHandle_t h= xTaskGetIdleTaskHandleForCPU(core);
+      #endif
+      idle[core]= 0;
+      for( UBaseType_t ix=0; ix<num; ix++ ) if( tasks[ix].xHandle==h ) idle[core]= tasks[ix].ulRunTimeCounter;
+    }
+    return true;
+  #else
+    (void)idle; (void)total;
+    return false;
+  #endif
+}
+
+
+// Resets the runtime statistics.
+static void aocmd_board_perf_reset() {
+  memset(&aocmd_board_perf, 0, sizeof aocmd_board_perf);
+  aocmd_board_perf.tstart= millis();
+  aocmd_board_perf.ratemin= UINT32_MAX;
+  aocmd_board_perf.heapmin= UINT32_MAX;
+  aocmd_board_perf.txfreemin= INT_MAX;
+  for( int core=0; core<portNUM_PROCESSORS; core++ ) aocmd_board_perf.load[core]= aocmd_board_perf.loadmax[core]= -1;
+  aocmd_board_perf_idle(aocmd_board_perf.idle, &aocmd_board_perf.total);
+}
+
+
+// Closes the current period: computes loop rate and CPU load, samples heap and UART.
+static void aocmd_board_perf_sample(uint32_t now) {
+  uint32_t rate= (uint64_t)aocmd_board_perf.loops*1000/(now-aocmd_board_perf.tstart);
+  aocmd_board_perf.rate= rate;
+  if( rate<aocmd_board_perf.ratemin ) aocmd_board_perf.ratemin= rate;
+  uint32_t idle[portNUM_PROCESSORS], total;
+  if( aocmd_board_perf_idle(idle, &total) && total!=aocmd_board_perf.total ) {
+    for( int core=0; core<portNUM_PROCESSORS; core++ ) {
+      int load= 100 - (int)((uint64_t)(idle[core]-aocmd_board_perf.idle[core])*100/(total-aocmd_board_perf.total));
+      if( load<0 ) load= 0;
+      aocmd_board_perf.load[core]= load;
+      if( load>aocmd_board_perf.loadmax[core] ) aocmd_board_perf.loadmax[core]= load;
+      aocmd_board_perf.idle[core]= idle[core];
+    }
+    aocmd_board_perf.total= total;
+  }
+  uint32_t heap= ESP.getFreeHeap();
+  if( heap<aocmd_board_perf.heapmin ) aocmd_board_perf.heapmin= heap;
+  int rx= Serial.available();
+  if( rx>aocmd_board_perf.rxmax ) aocmd_board_perf.rxmax= rx;
+  int txfree= Serial.availableForWrite();
+  if( txfree<aocmd_board_perf.txfreemin ) aocmd_board_perf.txfreemin= txfree;
+  aocmd_board_perf.samples++;
+  aocmd_board_perf.loops= 0;
+  aocmd_board_perf.tstart= now;
+}
+
+
+/*!
+    @brief  Collects the runtime statistics shown by 'board perf'.
+    @note   The application should call this function from loop(), 
+            once per iteration; it is cheap (a counter increment) 
+            except once per second when the statistics are sampled.
+*/
+void aocmd_board_perf_poll() {
+  if( !aocmd_board_perf_started ) { aocmd_board_perf_reset(); aocmd_board_perf_started= true; }
+  aocmd_board_perf.loops++;
+  uint32_t now= millis();
+  if( now-aocmd_board_perf.tstart>=AOCMD_BOARD_PERF_PERIOD_MS ) aocmd_board_perf_sample(now);
+}
+
+
+// Shows the runtime statistics.
+static void aocmd_board_perf_show() {
+  if( aocmd_board_perf.samples==0 ) {
+    aocmd_cint_printf( "loop : no samples (yet), aocmd_board_perf_poll() must be called from loop()\n");
+  } else {
+    aocmd_cint_printf( "loop : %lu /s (min %lu /s), %d samples\n", (unsigned long)aocmd_board_perf.rate, (unsigned long)aocmd_board_perf.ratemin, aocmd_board_perf.samples);
+    for( int core=0; core<portNUM_PROCESSORS; core++ ) {
+      if( aocmd_board_perf.load[core]<0 ) aocmd_cint_printf( "cpu%d : load not available (needs FreeRTOS run time stats)\n", core);
+      else aocmd_cint_printf( "cpu%d : load %d%% (max %d%%)\n", core, aocmd_board_perf.load[core], aocmd_board_perf.loadmax[core]);
+    }
+  }
+  uint32_t heapmin= ESP.getFreeHeap(); 
+  if( aocmd_board_perf.samples>0 && aocmd_board_perf.heapmin<heapmin ) heapmin= aocmd_board_perf.heapmin;
+  aocmd_cint_printf( "heap : %lu free, %lu largest block, ", (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMaxAllocHeap() );
+  aocmd_cint_printf( "%lu min free (%lu since boot)\n", (unsigned long)heapmin, (unsigned long)ESP.getMinFreeHeap() );
+  aocmd_cint_printf( "stack: %lu byte never used (interpreter task)\n", (unsigned long)uxTaskGetStackHighWaterMark(NULL) );
+  if( aocmd_board_perf.samples>0 ) aocmd_cint_printf( "uart : rx %d byte waiting (max), tx %d byte free (min)\n", aocmd_board_perf.rxmax, aocmd_board_perf.txfreemin );
+}
+
+
+// Shows the resource usage per command (measured by the command interpreter).
+static void aocmd_board_perf_cmds() {
+  #if AOCMD_CINT_STATS
+    if( aocmd_cint_stats_enabled() ) aocmd_cint_printf("command   calls  measured  stack(max)  heap(max)  heap(last)\n");
+    else aocmd_cint_printf("command   calls  (stack and heap not measured, see 'board perf cmds on')\n");
+  #else
+    aocmd_cint_printf("command   calls  (stack and heap not measured, AOCMD_CINT_STATS is 0)\n");
+  #endif
+  aocmd_cint_stats_t stats;
+  const char * name;
+  for( int ix=0; (name=aocmd_cint_stats_get(ix,&stats))!=0; ix++ ) {
+    aocmd_cint_printf("%-8s %6lu", name, (unsigned long)stats.calls);
+    if( aocmd_cint_stats_enabled() && stats.measured>0 ) aocmd_cint_printf("  %8lu  %s%9lu  %9ld  %10ld", (unsigned long)stats.measured, stats.stackmax==stats.paintsize?">":" ", (unsigned long)stats.stackmax, (long)stats.heapmax, (long)stats.heaplast);
+    aocmd_cint_printf("\n");
+  }
+}
+
+
+// === board crashlog ===
+
+
+// The breadcrumbs (last commands, telegrams, checkpoints) are kept in a ring in RTC memory that is 
+// not initialized on a (non power-on) reset. At init, the ring of the previous run is copied for 
+// 'board crashlog' and the ring restarts. Adding a crumb is a millis() and a short memcpy().
+#define AOCMD_BOARD_CRUMB_NUM       32         // number of crumbs in the ring
+#define AOCMD_BOARD_CRUMB_DATASIZE  26         // max bytes per crumb (makes a crumb 32 bytes)
+#define AOCMD_BOARD_CRUMB_MAGIC     0xC7B0A5E1 // marks ring as initialized
+
+
+// One breadcrumb
+typedef struct aocmd_board_crumb_s {
+  uint32_t ms;                                 // millis() when added
+  uint8_t  type;                               // AOCMD_BOARD_CRUMB_CMD, _TELE or _MARK
+  uint8_t  size;                               // bytes used in data
+  uint8_t  data[AOCMD_BOARD_CRUMB_DATASIZE];   // (start of) command line, telegram bytes, or checkpoint tag
+} aocmd_board_crumb_t;
+
+
+// A ring of breadcrumbs
+typedef struct aocmd_board_crumbring_s {
+  uint32_t magic;                              // AOCMD_BOARD_CRUMB_MAGIC when ring is valid
+  uint32_t count;                              // total number of crumbs added (next goes to count%AOCMD_BOARD_CRUMB_NUM)
+  aocmd_board_crumb_t crumbs[AOCMD_BOARD_CRUMB_NUM];
+} aocmd_board_crumbring_t;
+
+
+RTC_NOINIT_ATTR static aocmd_board_crumbring_t aocmd_board_crumbring; // survives non power-on resets
+static aocmd_board_crumbring_t aocmd_board_crashlog;                   // ring of the previous run (copied at init)
+static const char *             aocmd_board_crashlog_reason;           // reset reason that ended the previous run
+
+
+// Adds a crumb to the ring.
+static void aocmd_board_crumb_add(uint8_t type, const void * data, int size) {
+  if( aocmd_board_crumbring.magic!=AOCMD_BOARD_CRUMB_MAGIC ) return; // aocmd_board_init() not yet called
+  aocmd_board_crumb_t * crumb= &aocmd_board_crumbring.crumbs[aocmd_board_crumbring.count%AOCMD_BOARD_CRUMB_NUM];
+  if( size>AOCMD_BOARD_CRUMB_DATASIZE ) size= AOCMD_BOARD_CRUMB_DATASIZE;
+  crumb->ms= millis();
+  crumb->type= type;
+  crumb->size= size;
+  memcpy(crumb->data, data, size);
+  aocmd_board_crumbring.count++;
+}
+
+
+/*!
+    @brief  Adds a breadcrumb for a command (for 'board crashlog').
+    @param  argc, argv
+            The command being executed (only the first bytes are kept).
+    @note   Called by the command interpreter before it executes a command.
+*/
+void aocmd_board_crumb_cmd(int argc, char * argv[]) {
+  char buf[AOCMD_BOARD_CRUMB_DATASIZE];
+  int size= 0;
+  for( int i=0; i<argc && size<AOCMD_BOARD_CRUMB_DATASIZE; i++ ) {
+    if( i>0 ) buf[size++]= ' ';
+    for( const char * s=argv[i]; *s!=0 && size<AOCMD_BOARD_CRUMB_DATASIZE; s++ ) buf[size++]= *s;
+  }
+  aocmd_board_crumb_add(AOCMD_BOARD_CRUMB_CMD, buf, size);
+}
+
+
+/*!
+    @brief  Adds a breadcrumb for a telegram (for 'board crashlog').
+    @param  tele
+            The telegram bytes being sent.
+    @param  telesize
+            The number of bytes in the telegram.
+*/
+void aocmd_board_crumb_tele(const uint8_t * tele, int telesize) {
+  aocmd_board_crumb_add(AOCMD_BOARD_CRUMB_TELE, tele, telesize);
+}
+
+
+/*!
+    @brief  Adds a timing checkpoint breadcrumb (for 'board crashlog').
+    @param  tag
+            A short text identifying the checkpoint (only the first bytes are kept).
+    @note   An application may call this in its hot paths, it is cheap.
+*/
+void aocmd_board_crumb_mark(const char * tag) {
+  aocmd_board_crumb_add(AOCMD_BOARD_CRUMB_MARK, tag, strlen(tag));
+}
+
+
+/*!
+    @brief  Initializes the board module: moves the breadcrumbs of the previous 
+            run (if the ESP did not start from power-on) to the crash log.
+    @note   The aocmd_init calls this function.
+*/
+void aocmd_board_init() {
+  aocmd_board_crashlog.magic= 0;
+  if( esp_reset_reason()!=ESP_RST_POWERON && aocmd_board_crumbring.magic==AOCMD_BOARD_CRUMB_MAGIC ) {
+    aocmd_board_crashlog= aocmd_board_crumbring;
+    aocmd_board_crashlog_reason= aocmd_board_resetreason();
+  }
+  aocmd_board_crumbring.magic= AOCMD_BOARD_CRUMB_MAGIC;
+  aocmd_board_crumbring.count= 0;
+}
+
+
+// Prints the crumbs in ring (oldest first).
+static void aocmd_board_crashlog_show(const aocmd_board_crumbring_t * ring) {
+  uint32_t num= ring->count<AOCMD_BOARD_CRUMB_NUM ? ring->count : AOCMD_BOARD_CRUMB_NUM;
+  for( uint32_t ix=ring->count-num; ix!=ring->count; ix++ ) {
+    const aocmd_board_crumb_t * crumb= &ring->crumbs[ix%AOCMD_BOARD_CRUMB_NUM];
+    int size= crumb->size<=AOCMD_BOARD_CRUMB_DATASIZE ? crumb->size : AOCMD_BOARD_CRUMB_DATASIZE;
+    aocmd_cint_printf("%8lu ms ", (unsigned long)crumb->ms);
+    if( crumb->type==AOCMD_BOARD_CRUMB_TELE ) {
+      aocmd_cint_printf("tele");
+      for( int i=0; i<size; i++ ) aocmd_cint_printf(" %02X",crumb->data[i]);
+    } else {
+      aocmd_cint_printf("%s %.*s", crumb->type==AOCMD_BOARD_CRUMB_CMD ? "cmd " : "mark", size, (const char *)crumb->data);
+    }
+    aocmd_cint_printf("\n");
+  }
+}
+
+
+// === board misc ===
+
+
 // Next function deliberately causes a stack overflow
 // The pragma's suppress a warning for that
 #pragma GCC diagnostic push
@@ -116,11 +386,49 @@ static void aocmd_board_main( int argc, char * argv[] ) {
     }
     int clk;
     bool ok = aocmd_cint_parse_dec(argv[2],&clk) ;
-    if( !ok ) { Serial.printf("ERROR: 'cpu' expects frequency, not '%s'\n",argv[2]); return; }
+    if( !ok ) { aocmd_cint_printf("ERROR: 'cpu' expects frequency, not '%s'\n",argv[2]); return; }
     setCpuFrequencyMhz(clk); //  240, 160, 80
     if( argv[0][0]!='@' ) aocmd_board_clk_show();
     return;
   }
+  if( argc>=2 && aocmd_cint_isprefix("perf",argv[1])) {
+    if( argc==2 ) {
+      aocmd_board_perf_show();
+      return;
+    }
+    if( argc==3 && aocmd_cint_isprefix("cmds",argv[2])) {
+      aocmd_board_perf_cmds();
+      return;
+    }
+    if( argc==4 && aocmd_cint_isprefix("cmds",argv[2])) {
+      bool on= aocmd_cint_isprefix("on",argv[3]);
+      if( !on && !aocmd_cint_isprefix("off",argv[3]) ) { aocmd_cint_printf("ERROR: 'cmds' expects 'on' or 'off', not '%s'\n", argv[3] ); return; }
+      if( on && AOCMD_CINT_STATS==0 ) { aocmd_cint_printf("ERROR: stack and heap not measured, AOCMD_CINT_STATS is 0\n"); return; }
+      aocmd_cint_stats_enable(on);
+      if( argv[0][0]!='@' ) aocmd_cint_printf("perf: stack and heap measurement per command %s\n", on?"on":"off");
+      return;
+    }
+    if( argc==3 && aocmd_cint_isprefix("reset",argv[2])) {
+      aocmd_board_perf_reset();
+      aocmd_cint_stats_reset();
+      if( argv[0][0]!='@' ) aocmd_cint_printf("perf: reset\n");
+      return;
+    }
+    aocmd_cint_printf("ERROR: 'perf' expects 'cmds' or 'reset', not '%s'\n", argv[2] ); return;
+  }
+  if( argc>=2 && aocmd_cint_isprefix("crashlog",argv[1])) {
+    if( argc==2 ) {
+      if( aocmd_board_crashlog.magic!=AOCMD_BOARD_CRUMB_MAGIC ) { aocmd_cint_printf("crashlog: empty (ESP started from power-on)\n"); return; }
+      aocmd_cint_printf("crashlog: last %d of %lu crumbs before reset '%s'\n", aocmd_board_crashlog.count<AOCMD_BOARD_CRUMB_NUM ? (int)aocmd_board_crashlog.count : AOCMD_BOARD_CRUMB_NUM, (unsigned long)aocmd_board_crashlog.count, aocmd_board_crashlog_reason );
+      aocmd_board_crashlog_show(&aocmd_board_crashlog);
+      return;
+    }
+    if( argc==3 && aocmd_cint_isprefix("live",argv[2])) {
+      aocmd_board_crashlog_show(&aocmd_board_crumbring);
+      return;
+    }
+    aocmd_cint_printf("ERROR: 'crashlog' expects 'live', not '%s'\n", argv[2] ); return;
+  }
   if( argc==2 && aocmd_cint_isprefix("reboot",argv[1])) {
     ESP.restart();
   }
@@ -130,7 +438,7 @@ static void aocmd_board_main( int argc, char * argv[] ) {
   if( argc==2 && aocmd_cint_isprefix("assert",argv[1])) {
     AORESULT_ASSERT( 0==1 );
   }
-  Serial.printf("ERROR: 'board' has unknown argument ('%s')\n", argv[1] ); return;
+  aocmd_cint_printf("ERROR: 'board' has unknown argument ('%s')\n", argv[1] ); return;
 }
 
 
@@ -143,6 +451,20 @@ static const char aocmd_board_longhelp[] =
   "- without arguments shows cpu clock frequency\n"
   "- with argument sets cpu clock frequency\n"
   "- valid values are 10, 20, 40, 80, 160, 240\n"
+  "SYNTAX: board perf [cmds [on|off] | reset]\n"
+  "- without arguments shows runtime statistics: loop() rate, CPU load per core,\n"
+  "  heap (free, largest block, minimum), unused stack, UART buffer fill\n"
+  "- needs aocmd_board_perf_poll() in loop()\n"
+  "- with 'cmds' shows per command: calls, and when measured, max stack bytes\n"
+  "  used by the handler ('>' means at least; may include an interrupt frame)\n"
+  "  and heap bytes retained by the handler (max, last)\n"
+  "- with 'cmds on' or 'cmds off' switches measuring stack and heap (off at\n"
+  "  startup; painting the stack costs time for every command)\n"
+  "- with 'reset' restarts the statistics\n"
+  "SYNTAX: board crashlog [live]\n"
+  "- shows the breadcrumbs (commands, telegrams, checkpoints) of the run before\n"
+  "  the last (non power-on) reset, e.g. a panic or watchdog\n"
+  "- with 'live' shows the breadcrumbs of the current run\n"
   "SYNTAX: board reboot | stackoverflow | assert\n"
   "- resets the ESP (controlled or with a stack overflow, or an assert)\n"
   "- this does not reset other components (OSP nodes, OLED) on the board\n"
@@ -159,6 +481,8 @@ static const char aocmd_board_longhelp[] =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_board_register() {
-  return aocmd_cint_register(aocmd_board_main, "board", "board info and commands", aocmd_board_longhelp);
+  return aocmd_cint_register(aocmd_board_main, "board", "board info and commands", AOCMD_LONGHELP(aocmd_board_longhelp));
 }
 
+
+#endif // AOCMD_CONFIG_BOARD
@@ -22,8 +22,42 @@
 #define _AOCMD_BOARD_H_
 
 
+#include <aocmd_config.h> // AOCMD_CONFIG_BOARD
+
+
 // Registers the built-in "board" command with the command interpreter.
 int aocmd_board_register();
 
 
+#if AOCMD_CONFIG_BOARD
+// Collects the runtime statistics for 'board perf'; should be called from loop().
+void aocmd_board_perf_poll();
+
+
+// Moves the breadcrumbs of the previous run (if not started from power-on) to the crash log.
+void aocmd_board_init();
+#endif
+
+
+// Breadcrumb types (see 'board crashlog')
+#define AOCMD_BOARD_CRUMB_CMD  1 // a command line
+#define AOCMD_BOARD_CRUMB_TELE 2 // a telegram sent
+#define AOCMD_BOARD_CRUMB_MARK 3 // a timing checkpoint
+#if AOCMD_CONFIG_BOARD
+// Adds a breadcrumb for a command being executed.
+void aocmd_board_crumb_cmd(int argc, char * argv[]);
+// Adds a breadcrumb for a telegram being sent.
+void aocmd_board_crumb_tele(const uint8_t * tele, int telesize);
+// Adds a breadcrumb for a timing checkpoint (tag is a short text).
+void aocmd_board_crumb_mark(const char * tag);
+#else
+// The "board" command is compiled out (see aocmd_config.h); these stubs keep the callers unchanged.
+static inline void aocmd_board_perf_poll() {}
+static inline void aocmd_board_init() {}
+static inline void aocmd_board_crumb_cmd(int argc, char * argv[]) { (void)argc; (void)argv; }
+static inline void aocmd_board_crumb_tele(const uint8_t * tele, int telesize) { (void)tele; (void)telesize; }
+static inline void aocmd_board_crumb_mark(const char * tag) { (void)tag; }
+#endif
+
+
 #endif
@@ -26,6 +26,12 @@
 //#include <avr/pgmspace.h> // This library assumes most strings (command help texts) are in PROGMEM (flash, not RAM)
 #include <Arduino.h>
 #include <aocmd_cint.h>
+#include <aocmd_board.h> // aocmd_board_crumb_cmd()
+#include <aocmd_help.h>  // aocmd_help_index_insert()
+#if AOCMD_CINT_STATS
+#include <freertos/FreeRTOS.h> // pxTaskGetStackStart()
+#include <freertos/task.h>
+#endif
 
 
 // Some definitions are needed by a friend module (aocmd_echo, aocmd_help).
@@ -45,18 +51,21 @@ FRIEND typedef struct aocmd_cint_desc_s {
 // All command descriptors
 FRIEND int aocmd_cint_descs_count= 0;
 FRIEND aocmd_cint_desc_t aocmd_cint_descs[AOCMD_CINT_REGISTRATION_SLOTS];
+// Resource usage of the handlers (same index as aocmd_cint_descs)
+static aocmd_cint_stats_t aocmd_cint_stats[AOCMD_CINT_REGISTRATION_SLOTS];
 
 
 // The registration function for command descriptors (all strings in PROGMEM!)
 // Returns number of remaining free slots (or -1 and a Serial print if registration failed)
 int aocmd_cint_register(aocmd_cint_func_t main, const char * name, const char * shorthelp, const char * longhelp) {
   // Is there still a free slot?
-  if( aocmd_cint_descs_count >= AOCMD_CINT_REGISTRATION_SLOTS ) { Serial.printf("ERROR: command '%s' can not be registered (too many)\n",name); return -1; }
+  if( aocmd_cint_descs_count >= AOCMD_CINT_REGISTRATION_SLOTS ) { aocmd_cint_printf("ERROR: command '%s' can not be registered (too many)\n",name); return -1; }
   int slot = aocmd_cint_descs_count;
   #if 1
     // command list is kept in alphabetical order
     while( slot>0 && strcmp(name,aocmd_cint_descs[slot-1].name)<0 ) {
       aocmd_cint_descs[slot] = aocmd_cint_descs[slot-1];
+      aocmd_cint_stats[slot] = aocmd_cint_stats[slot-1];
       slot--;
     }
   #endif
@@ -66,6 +75,8 @@ int aocmd_cint_register(aocmd_cint_func_t main, const char * name, const char *
   aocmd_cint_descs[slot].name= name;
   aocmd_cint_descs[slot].shorthelp= shorthelp;
   aocmd_cint_descs[slot].longhelp= longhelp;
+  memset(&aocmd_cint_stats[slot], 0, sizeof aocmd_cint_stats[slot]);
+  aocmd_help_index_insert(slot, longhelp);
   
   return AOCMD_CINT_REGISTRATION_SLOTS - aocmd_cint_descs_count;
 }
@@ -74,7 +85,7 @@ int aocmd_cint_register(aocmd_cint_func_t main, const char * name, const char *
 // Finds the command descriptor for a command with name `name`.
 // When not found, returns 0.
 FRIEND aocmd_cint_desc_t * aocmd_cint_find(char * name ) {
-  if( aocmd_cint_descs_count==0 ) { Serial.printf("ERROR: no commands registered\n"); return 0; }
+  if( aocmd_cint_descs_count==0 ) { aocmd_cint_printf("ERROR: no commands registered\n"); return 0; }
   for( int i=0; i<aocmd_cint_descs_count; i++ ) {
     if( aocmd_cint_isprefix(aocmd_cint_descs[i].name,name) ) return &aocmd_cint_descs[i];
   }
@@ -85,6 +96,7 @@ FRIEND aocmd_cint_desc_t * aocmd_cint_find(char * name ) {
 // The state machine for receiving characters via Serial
 static char       aocmd_cint_buf[AOCMD_CINT_BUFSIZE];              // Incoming chars
 static int        aocmd_cint_ix;                                   // Fill pointer into aocmd_cint_buf
+static int        aocmd_cint_eolch;                                // The char that terminated the line in aocmd_cint_buf
 FRIEND bool       aocmd_cint_echo;                                 // Command interpreter should echo incoming chars
 static aocmd_cint_func_t aocmd_cint_streamfunc;                    // If 0, no streaming, else the streaming handler
 static char       aocmd_cint_streamprompt[AOCMD_CINT_PROMPT_SIZE]; // If streaming (aocmd_cint_stream_main!=0), the streaming prompt
@@ -93,9 +105,9 @@ static char       aocmd_cint_streamprompt[AOCMD_CINT_PROMPT_SIZE]; // If streami
 // Print the prompt when waiting for input (special variant when in streaming mode). Needed once after init().
 void aocmd_cint_prompt() {
   if( aocmd_cint_streamfunc ) {
-    Serial.print( aocmd_cint_streamprompt );
+    aocmd_cint_out->print( aocmd_cint_streamprompt );
   } else {
-    Serial.print( F(">> ") );  
+    aocmd_cint_out->print( F(">> ") );  
   }
 }
 
@@ -109,6 +121,180 @@ void aocmd_cint_init() {
 }
 
 
+// Resource usage of command handlers.
+// Before the handler runs, the free stack below the dispatcher is painted with a pattern;
+// afterwards the deepest overwritten word gives the stack depth of the handler. 
+// Free heap before and after gives the heap retained by the handler.
+// The depth is an upper bound: an interrupt during the handler saves its context on the task stack.
+#if AOCMD_CINT_STATS
+#define AOCMD_CINT_STATS_PATTERN 0x5AC3A53Cu
+#define AOCMD_CINT_STATS_SKIP    16  // bytes below the stack pointer that a register window spill of the painter may write (base save area)
+#define AOCMD_CINT_STATS_MARGIN  512 // bytes never painted at the end of the stack
+
+
+static bool      aocmd_cint_stats_on;    // measurement switched on
+static uintptr_t aocmd_cint_stats_top;   // address of highest painted word (stack grows down)
+static int       aocmd_cint_stats_words; // number of painted words
+
+
+// Paints the unused stack below the own frame, down to the start of the task stack (minus margin).
+static void __attribute__((noinline)) aocmd_cint_stats_paint() {
+  volatile uint32_t here= 0;
+  uintptr_t bottom= (uintptr_t)pxTaskGetStackStart(NULL) + AOCMD_CINT_STATS_MARGIN; // lowest address of the task stack
+  uintptr_t top= ((uintptr_t)&here - AOCMD_CINT_STATS_SKIP) & ~(uintptr_t)3;
+  int size= top>bottom ? (int)(top-bottom) : 0;
+  if( size>AOCMD_CINT_STATS_PAINTSIZE ) size= AOCMD_CINT_STATS_PAINTSIZE;
+  aocmd_cint_stats_top= top;
+  aocmd_cint_stats_words= size/4;
+  for( int i=0; i<aocmd_cint_stats_words; i++ ) *(volatile uint32_t *)(top-4*i)= AOCMD_CINT_STATS_PATTERN;
+}
+
+
+// Returns the number of painted stack bytes that are overwritten.
+static uint32_t aocmd_cint_stats_depth() {
+  int i= aocmd_cint_stats_words-1; 
+  while( i>=0 && *(volatile uint32_t *)(aocmd_cint_stats_top-4*i)==AOCMD_CINT_STATS_PATTERN ) i--;
+  return (i+1)*4;
+}
+#endif
+
+
+// Runs the handler of descriptor d, and measures its resource usage.
+FRIEND void aocmd_cint_run(aocmd_cint_desc_t * d, int argc, char * argv[]) {
+  aocmd_board_crumb_cmd(argc, argv);
+  aocmd_cint_stats_t * stats= &aocmd_cint_stats[d-aocmd_cint_descs];
+  stats->calls++;
+  #if AOCMD_CINT_STATS
+    if( aocmd_cint_stats_on ) {
+      int32_t heap= ESP.getFreeHeap();
+      aocmd_cint_stats_paint();
+      d->main(argc, argv);
+      uint32_t depth= aocmd_cint_stats_depth();
+      heap-= ESP.getFreeHeap();
+      stats->measured++;
+      if( depth>=stats->stackmax ) { stats->stackmax= depth; stats->paintsize= aocmd_cint_stats_words*4; }
+      if( stats->measured==1 || heap>stats->heapmax ) stats->heapmax= heap;
+      stats->heaplast= heap;
+      return;
+    }
+  #endif
+  d->main(argc, argv);
+}
+
+
+// Gets the resource usage of registered command ix; returns its name, or 0 when ix is past the last command.
+const char * aocmd_cint_stats_get(int ix, aocmd_cint_stats_t * stats) {
+  if( ix<0 || ix>=aocmd_cint_descs_count ) return 0;
+  *stats= aocmd_cint_stats[ix];
+  return aocmd_cint_descs[ix].name;
+}
+
+
+// Clears the resource usage of all commands.
+void aocmd_cint_stats_reset( void ) {
+  memset(aocmd_cint_stats, 0, sizeof aocmd_cint_stats);
+}
+
+
+// Switches the measurement of stack and heap per command on or off (off at startup; calls are always counted).
+void aocmd_cint_stats_enable( bool enable ) {
+  #if AOCMD_CINT_STATS
+    aocmd_cint_stats_on= enable;
+  #else
+    (void)enable;
+  #endif
+}
+
+
+// Returns true iff stack and heap per command are measured (always false when AOCMD_CINT_STATS is 0).
+bool aocmd_cint_stats_enabled( void ) {
+  #if AOCMD_CINT_STATS
+    return aocmd_cint_stats_on;
+  #else
+    return false;
+  #endif
+}
+
+
+// Executes one command (or passes it to the streaming function)
+static void aocmd_cint_exec1(int argc, char * argv[]) {
+  // Check from streaming
+  if( aocmd_cint_streamfunc ) {
+    aocmd_cint_streamfunc(argc, argv); // Streaming mode is active pass the data
+    return;
+  }
+  // Bail out when empty
+  if( argc==0 ) {
+    // Empty command entered
+    return; 
+  }
+  // Find the command
+  char * s= argv[0];
+  if( *s=='@' ) s++;
+  aocmd_cint_desc_t * d= aocmd_cint_find(s);
+  // If a command is found, execute it 
+  if( d!=0 ) {
+    aocmd_cint_ix = 0; // Added because there might be a command that issues a command
+    aocmd_cint_run(d, argc, argv ); // Execute handler of command
+    return;
+  } 
+  aocmd_cint_out->print(F("ERROR: command '")); 
+  aocmd_cint_out->print(s); 
+  aocmd_cint_out->println(F("' not found (try help)")); 
+}
+
+
+// While a line with AOCMD_CINT_SEPAND executes, this sink is put in front of the output sink.
+// It passes all output on, and spots error messages (by convention lines starting with "ERROR").
+class aocmd_cint_errsink_c : public Print {
+  public:
+    Print * out;   // the output sink output is passed on to
+    int     match; // number of chars of "ERROR" matched at the start of the current line (-1 for no match)
+    bool    error; // an error message was printed
+    size_t write(uint8_t ch) override { check(ch); return out->write(ch); }
+    size_t write(const uint8_t * buf, size_t size) override { for( size_t i=0; i<size; i++ ) check(buf[i]); return out->write(buf,size); }
+  private:
+    void check(uint8_t ch) {
+      if( ch=='\n' ) { match= 0; return; }
+      if( match<0 || match==5 ) return;
+      if( ch=="ERROR"[match] ) { if( ++match==5 ) error= true; } else match= -1;
+    }
+};
+
+
+// Executes a line with several commands; argv[] is split on AOCMD_CINT_SEP and AOCMD_CINT_SEPAND.
+// A command after AOCMD_CINT_SEPAND is skipped when the command before it printed an error (or was skipped).
+static void aocmd_cint_exec_multi(int argc, char * argv[]) {
+  // A handler may feed the interpreter itself (e.g. 'file exec'), overwriting aocmd_cint_buf, so run the commands from a copy
+  char buf[AOCMD_CINT_BUFSIZE];
+  memcpy(buf, aocmd_cint_buf, AOCMD_CINT_BUFSIZE);
+  bool track= false; // only track errors if there is an AOCMD_CINT_SEPAND
+  for( int i=0; i<argc; i++ ) {
+    argv[i]= buf + (argv[i]-aocmd_cint_buf);
+    if( strcmp(argv[i],AOCMD_CINT_SEPAND)==0 ) track= true;
+  }
+  aocmd_cint_errsink_c errsink;
+  errsink.out= aocmd_cint_out;
+  if( track ) aocmd_cint_out= &errsink;
+  bool failed= false;
+  int start= 0;
+  while( true ) {
+    int end= start;
+    while( end<argc && strcmp(argv[end],AOCMD_CINT_SEP)!=0 && strcmp(argv[end],AOCMD_CINT_SEPAND)!=0 ) end++;
+    bool skip= failed && start>0 && strcmp(argv[start-1],AOCMD_CINT_SEPAND)==0;
+    if( !skip ) {
+      errsink.match= 0;
+      errsink.error= false;
+      aocmd_cint_exec1(end-start, argv+start);
+      failed= errsink.error;
+    }
+    if( end==argc ) break;
+    start= end+1;
+  }
+  if( aocmd_cint_out==&errsink ) aocmd_cint_out= errsink.out;
+}
+
+
 // Execute the entered command (terminated with a press on RETURN key)
 static void aocmd_cint_exec() {
   char * argv[ AOCMD_CINT_MAXARGS ];
@@ -124,50 +310,35 @@ static void aocmd_cint_exec() {
     if( !(ix<aocmd_cint_ix) ) break;
     argv[argc]= &aocmd_cint_buf[ix];
     argc++;
-    if( argc>AOCMD_CINT_MAXARGS ) { Serial.println(F("ERROR: too many arguments"));  return; }
+    if( argc>AOCMD_CINT_MAXARGS ) { aocmd_cint_out->println(F("ERROR: too many arguments"));  return; }
     // scan for end of word (ie space)
     while( (ix<aocmd_cint_ix) && ( aocmd_cint_buf[ix]!=' ' && aocmd_cint_buf[ix]!='\t' ) ) ix++;
     aocmd_cint_buf[ix]= '\0';
     ix++;
   }
-  //for(ix=0; ix<argc; ix++) { Serial.print(ix); Serial.print("='"); Serial.print(argv[ix]); Serial.print("'"); Serial.println(""); }
-  // Check from streaming
-  if( aocmd_cint_streamfunc ) {
-    aocmd_cint_streamfunc(argc, argv); // Streaming mode is active pass the data
-    return;
-  }
-  // Bail out when empty
-  if( argc==0 ) {
-    // Empty command entered
-    return; 
+  //for(ix=0; ix<argc; ix++) { aocmd_cint_out->print(ix); aocmd_cint_out->print("='"); aocmd_cint_out->print(argv[ix]); aocmd_cint_out->print("'"); aocmd_cint_out->println(""); }
+  // A line with separators has several commands (but streaming data is passed as is)
+  if( aocmd_cint_streamfunc==0 ) {
+    for( int i=0; i<argc; i++ ) {
+      if( strcmp(argv[i],AOCMD_CINT_SEP)==0 || strcmp(argv[i],AOCMD_CINT_SEPAND)==0 ) { aocmd_cint_exec_multi(argc, argv); return; }
+    }
   }
-  // Find the command
-  char * s= argv[0];
-  if( *s=='@' ) s++;
-  aocmd_cint_desc_t * d= aocmd_cint_find(s);
-  // If a command is found, execute it 
-  if( d!=0 ) {
-    aocmd_cint_ix = 0; // Added because there might be a command that issues a command
-    d->main(argc, argv ); // Execute handler of command
-    return;
-  } 
-  Serial.print(F("ERROR: command '")); 
-  Serial.print(s); 
-  Serial.println(F("' not found (try help)")); 
+  aocmd_cint_exec1(argc, argv);
 }
 
 
 // Add characters to the state machine of the command interpreter (firing a command on <CR>)
 void aocmd_cint_add(int ch) {
   if( ch=='\n' || ch=='\r' ) {
-    if( aocmd_cint_echo ) Serial.println();
+    if( aocmd_cint_echo ) aocmd_cint_out->println();
     aocmd_cint_buf[aocmd_cint_ix]= '\0'; // Terminate (make aocmd_cint_buf a c-string)
+    aocmd_cint_eolch= ch;
     aocmd_cint_exec();
     aocmd_cint_ix=0;
     aocmd_cint_prompt(); // trigger for tests that cmd is finished
   } else if( ch=='\b' ) {
     if( aocmd_cint_ix>0 ) {
-      if( aocmd_cint_echo ) Serial.print( F("\b \b") );
+      if( aocmd_cint_echo ) aocmd_cint_out->print( F("\b \b") );
       aocmd_cint_ix--;
     } else {
       // backspace with no more chars in buf; ignore
@@ -175,10 +346,10 @@ void aocmd_cint_add(int ch) {
   } else {
     if( aocmd_cint_ix<AOCMD_CINT_BUFSIZE-1 ) {
       aocmd_cint_buf[aocmd_cint_ix++]= ch;
-      if( aocmd_cint_echo ) Serial.print( (char)ch );
+      if( aocmd_cint_echo ) aocmd_cint_out->print( (char)ch );
     } else {
       // Input buffer full, send "alarm" back, even with echo off
-      Serial.print( F("_\b") ); // Prefer visual instead of \a (bell)
+      aocmd_cint_out->print( F("_\b") ); // Prefer visual instead of \a (bell)
     }
   }
 }
@@ -203,6 +374,12 @@ int aocmd_cint_pendingschars() {
 }
 
 
+// Returns the char ('\r' or '\n') that terminated the line being (or last) executed.
+int aocmd_cint_eol() {
+  return aocmd_cint_eolch;
+}
+
+
 // Helpers =========================================================================
 
 
@@ -288,30 +465,63 @@ bool aocmd_cint_isprefix(const char *str, const char *prefix) {
 }
 
 
-// A (formatting) printf towards Serial
+// The null sink: discards all output.
+class aocmd_cint_nullsink_c : public Print {
+  public:
+    size_t write(uint8_t ch) override { (void)ch; return 1; }
+    size_t write(const uint8_t * buf, size_t size) override { (void)buf; return size; }
+};
+static aocmd_cint_nullsink_c aocmd_cint_nullsink;
+
+
+// The output sink of the interpreter and all handlers
+Print * aocmd_cint_out= &Serial;
+
+
+// Sets the output sink; 0 selects the null sink.
+void aocmd_cint_out_set(Print * out) {
+  aocmd_cint_out= out==0 ? &aocmd_cint_nullsink : out;
+}
+
+
+// Returns the output sink (0 for the null sink).
+Print * aocmd_cint_out_get() {
+  return aocmd_cint_out==&aocmd_cint_nullsink ? 0 : aocmd_cint_out;
+}
+
+
+// Formats `format` with `args` to the output sink, via a fixed buffer (longer output is truncated and flagged with OVERFLOW).
+static char aocmd_cint_printf_buf[AOCMD_CINT_PRT_SIZE];
+static int aocmd_cint_vprintf(bool progmem, const char *format, va_list args) {
+  int result = progmem ? vsnprintf_P(aocmd_cint_printf_buf, AOCMD_CINT_PRT_SIZE, format, args) : vsnprintf(aocmd_cint_printf_buf, AOCMD_CINT_PRT_SIZE, format, args);
+  if( result<0 ) return result;
+  aocmd_cint_out->write((const uint8_t *)aocmd_cint_printf_buf, result<AOCMD_CINT_PRT_SIZE ? result : AOCMD_CINT_PRT_SIZE-1);
+  if( result>=AOCMD_CINT_PRT_SIZE ) aocmd_cint_out->print(F("\nOVERFLOW\n"));
+  return result;
+}
+
+
+// A (formatting) printf towards the output sink (nothing is formatted for the null sink)
 // Note: to print string from PROGMEM use %S (capital S), and PSTR for the string (but F also works)
 //   aocmd_cint_printf( "%S/%S\n", PSTR("foo"), F("bar") );
-static char aocmd_cint_printf_buf[AOCMD_CINT_PRT_SIZE];
 int aocmd_cint_printf(const char *format, ...) {
+  if( aocmd_cint_out==&aocmd_cint_nullsink ) return 0;
   va_list args;
   va_start(args, format);
-  int result = vsnprintf(aocmd_cint_printf_buf, AOCMD_CINT_PRT_SIZE, format, args);
-  Serial.print(aocmd_cint_printf_buf);
-  if( result>=AOCMD_CINT_PRT_SIZE ) Serial.print(F("\nOVERFLOW\n"));
+  int result = aocmd_cint_vprintf(false, format, args);
   va_end(args);
   return result;
 }
 
 
-// A (formatting) printf towards Serial (the format string is in PROGMEM)
+// A (formatting) printf towards the output sink (the format string is in PROGMEM)
 // Note: to print string from PROGMEM use %S (capital S), and PSTR for the string (but F also works). Format string must be PSTR()
 //   aocmd_cint_printf_P( PSTR("%S/%S\n"), PSTR("foo"), F("bar") );
 int aocmd_cint_printf_P(/*PROGMEM*/const char *format, ...) {
+  if( aocmd_cint_out==&aocmd_cint_nullsink ) return 0;
   va_list args;
   va_start(args, format);
-  int result = vsnprintf_P(aocmd_cint_printf_buf, AOCMD_CINT_PRT_SIZE, format, args);
-  Serial.print(aocmd_cint_printf_buf);
-  if( result>=AOCMD_CINT_PRT_SIZE ) Serial.print(F("\nOVERFLOW\n"));
+  int result = aocmd_cint_vprintf(true, format, args);
   va_end(args);
   return result;
 }
@@ -350,7 +560,7 @@ void aocmd_cint_pollserial( void ) {
 #endif
     ) {
       aocmd_cint_steperrorcount();
-      Serial.println(); Serial.println( F("WARNING: serial overflow") ); Serial.println(); 
+      aocmd_cint_out->println(); aocmd_cint_out->println( F("WARNING: serial overflow") ); aocmd_cint_out->println(); 
     }
     // Process read char by feeding it to command interpreter
     aocmd_cint_add(ch);
@@ -42,8 +42,23 @@
 #define AOCMD_CINT_REGISTRATION_SLOTS 20
 // Size of buffer for the streaming prompt
 #define AOCMD_CINT_PROMPT_SIZE 10 
+// A line may have several commands, separated by these words (they must be separate words, so surrounded by spaces).
+// The command after AOCMD_CINT_SEP always runs; the one after AOCMD_CINT_SEPAND only when the previous one printed no ERROR.
+#define AOCMD_CINT_SEP    ";"
+#define AOCMD_CINT_SEPAND "&&"
 // Size of buffer for aocmd_cint_prt
 #define AOCMD_CINT_PRT_SIZE 80 
+// When 1, the dispatcher can measure stack depth (by stack painting) and heap delta of every command handler (ESP32 only).
+// The measurement is off at startup; it is switched with aocmd_cint_stats_enable() (command 'board perf cmds on|off').
+#ifndef AOCMD_CINT_STATS
+#if defined(ESP32)
+#define AOCMD_CINT_STATS 1
+#else
+#define AOCMD_CINT_STATS 0
+#endif
+#endif
+// Max number of stack bytes painted before a command handler runs (more costs more time per command).
+#define AOCMD_CINT_STATS_PAINTSIZE 6144
 
 
 // A command must implement a 'main' function. It is much like C's main, it has argc and argv.
@@ -67,6 +82,8 @@ void aocmd_cint_addstr(const char * str);
 void aocmd_cint_addstr_P(/*PROGMEM*/const char * str); 
 // Returns the number of (not yet executed) chars.
 int  aocmd_cint_pendingschars(); 
+// Returns the char ('\r' or '\n') that terminated the line being (or last) executed.
+int  aocmd_cint_eol(); 
 
 
 // The command handler can support streaming: sending data without commands. 
@@ -94,10 +111,33 @@ bool aocmd_cint_parse_hex(const char*s,uint16_t*v) ;
 bool aocmd_cint_isprefix(/*PROGMEM*/const char *str, const char *prefix);
 // Reads Serial and calls aocmd_cint_add()
 void aocmd_cint_pollserial( void );
-// A print towards Serial, just like Serial.print, but now with formatting as printf()
-int aocmd_cint_printf(const char *format, ...);
-// A print towards Serial, just like Serial.print, but now with formatting as printf(), now from progmem
+// The output sink of the command interpreter and all command handlers (Serial by default). Never 0, so print via aocmd_cint_out->print().
+extern Print * aocmd_cint_out;
+// Sets the output sink (e.g. to capture output in memory); 0 selects the null sink, which discards all output.
+void aocmd_cint_out_set(Print * out);
+// Returns the output sink (0 for the null sink).
+Print * aocmd_cint_out_get();
+// A print towards the output sink, just like Serial.print, but now with formatting as printf() (skips formatting for the null sink)
+int aocmd_cint_printf(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
+// A print towards the output sink, just like Serial.print, but now with formatting as printf(), now from progmem
 int aocmd_cint_printf_P(/*PROGMEM*/const char *format, ...);
+// Resource usage of the handler of a command (see AOCMD_CINT_STATS).
+typedef struct aocmd_cint_stats_s {
+  uint32_t calls;     // number of times the handler was called
+  uint32_t measured;  // number of those calls for which stack and heap were measured
+  uint32_t stackmax;  // max stack bytes used by handler (stackmax==paintsize means at least)
+  uint32_t paintsize; // stack bytes painted for the call that set stackmax
+  int32_t  heapmax;   // max heap bytes retained by handler (free heap before minus after)
+  int32_t  heaplast;  // heap bytes retained by handler, last call
+} aocmd_cint_stats_t;
+// Gets the resource usage of registered command ix; returns its name, or 0 when ix is past the last command.
+const char * aocmd_cint_stats_get(int ix, aocmd_cint_stats_t * stats);
+// Clears the resource usage of all commands.
+void aocmd_cint_stats_reset( void );
+// Switches the measurement of stack and heap per command on or off (off at startup; calls are always counted).
+void aocmd_cint_stats_enable( bool enable );
+// Returns true iff stack and heap per command are measured (always false when AOCMD_CINT_STATS is 0).
+bool aocmd_cint_stats_enabled( void );
 // When aocmd_cint_pollserial() detects Serial buffer overflows it steps an error counter
 void aocmd_cint_steperrorcount( void );
 // The current error counter can be obtained with this function; as a side effect it clears the counter.
@@ -0,0 +1,77 @@
+// aocmd_config.h - compile-time selection of the command set
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _AOCMD_CONFIG_H_
+#define _AOCMD_CONFIG_H_
+
+
+// These macros select which commands are compiled into the library. A command that is 
+// compiled out costs no flash or RAM (its handler, tables, help text, and state are gone),
+// and aocmd_register() does not register it. Calls from other modules (e.g. "osp" adding 
+// breadcrumbs for "board") are compiled out as well.
+// To change a setting, either edit this file, or pass it as a build flag
+// (e.g. -DAOCMD_CONFIG_SAID=0 in build_opt.h of the sketch, or build_flags in PlatformIO).
+
+
+#ifndef AOCMD_CONFIG_ECHO
+#define AOCMD_CONFIG_ECHO     1 // command "echo"
+#endif
+#ifndef AOCMD_CONFIG_HELP
+#define AOCMD_CONFIG_HELP     1 // command "help"
+#endif
+#ifndef AOCMD_CONFIG_VERSION
+#define AOCMD_CONFIG_VERSION  1 // command "version"
+#endif
+#ifndef AOCMD_CONFIG_BOARD
+#define AOCMD_CONFIG_BOARD    1 // command "board" (also the breadcrumbs for 'board crashlog')
+#endif
+#ifndef AOCMD_CONFIG_FILE
+#define AOCMD_CONFIG_FILE     1 // command "file" (also the file system and boot.cmd)
+#endif
+#ifndef AOCMD_CONFIG_OSP
+#define AOCMD_CONFIG_OSP      1 // command "osp"
+#endif
+#ifndef AOCMD_CONFIG_SAID
+#define AOCMD_CONFIG_SAID     1 // command "said"
+#endif
+
+
+// When 0, the "osp" sub commands 'info' and 'aoresult' are compiled out, 
+// as well as the descriptions of the telegrams.
+#ifndef AOCMD_CONFIG_OSP_INFO
+#define AOCMD_CONFIG_OSP_INFO 1
+#endif
+
+
+// When 0, the long help texts of all commands are compiled out ('help <cmd>' 
+// has no details, the short help in 'help' remains).
+#ifndef AOCMD_CONFIG_LONGHELP
+#define AOCMD_CONFIG_LONGHELP 1
+#endif
+// Passes the long help text `longhelp` to registration, or an empty string when AOCMD_CONFIG_LONGHELP is 0
+// (the unused text is then dropped by the compiler).
+#if AOCMD_CONFIG_LONGHELP
+#define AOCMD_LONGHELP(longhelp) (longhelp)
+#else
+#define AOCMD_LONGHELP(longhelp) ""
+#endif
+
+
+#endif
@@ -25,9 +25,13 @@
 
 #include <Arduino.h>        // Serial.print
 #include <aocmd_cint.h>     // aocmd_cint_register, aocmd_cint_isprefix, ...
+#include <aocmd_config.h>   // AOCMD_CONFIG_ECHO
 #include <aocmd_echo.h>     // own
 
 
+#if AOCMD_CONFIG_ECHO
+
+
 //---------------------------------------------------------------------------
 // This is a friend module of aocmd_cint. 
 // It needs access to these private parts
@@ -41,8 +45,8 @@ extern bool aocmd_cint_echo; // Command interpreter should echo incoming chars (
 
 // Helper to print the echo status.
 static void aocmd_echo_print() { 
-  Serial.print(F("echo: echoing ")); 
-  Serial.println(aocmd_cint_echo?F("enabled"):F("disabled")); 
+  aocmd_cint_out->print(F("echo: echoing ")); 
+  aocmd_cint_out->println(aocmd_cint_echo?F("enabled"):F("disabled")); 
 }
 
 
@@ -54,12 +58,12 @@ static void aocmd_echo_main(int argc, char * argv[]) {
   }
   if( argc==3 && aocmd_cint_isprefix(PSTR("faults"),argv[1]) && aocmd_cint_isprefix(PSTR("step"),argv[2]) ) {
     aocmd_cint_steperrorcount();
-    if( argv[0][0]!='@') Serial.println(F("echo: faults: stepped")); 
+    if( argv[0][0]!='@') aocmd_cint_out->println(F("echo: faults: stepped")); 
     return;
   }
   if( argc==2 && aocmd_cint_isprefix(PSTR("faults"),argv[1]) ) {
     int n= aocmd_cint_geterrorcount();
-    if( argv[0][0]!='@') { Serial.print(F("echo: faults: ")); Serial.println(n); }
+    if( argv[0][0]!='@') { aocmd_cint_out->print(F("echo: faults: ")); aocmd_cint_out->println(n); }
     return;
   }
   if( argc==2 && aocmd_cint_isprefix(PSTR("enabled"),argv[1]) ) {
@@ -74,8 +78,8 @@ static void aocmd_echo_main(int argc, char * argv[]) {
   }
   if( argc==3 && aocmd_cint_isprefix(PSTR("wait"),argv[1]) ) {
     int ms;
-    if( ! aocmd_cint_parse_dec(argv[2],&ms) ) { Serial.printf("ERROR: wait time\n"); return; }
-    if( argv[0][0]!='@') { Serial.print(F("echo: wait: ")); Serial.println(ms); }
+    if( ! aocmd_cint_parse_dec(argv[2],&ms) ) { aocmd_cint_printf("ERROR: wait time\n"); return; }
+    if( argv[0][0]!='@') { aocmd_cint_out->print(F("echo: wait: ")); aocmd_cint_out->println(ms); }
     delay(ms);
     return;
   }
@@ -85,9 +89,9 @@ static void aocmd_echo_main(int argc, char * argv[]) {
   //char * s0=argv[start-1]+strlen(argv[start-1])+1;
   //char * s1=argv[argc-1];
   //for( char * p=s0; p<s1; p++ ) if( *p=='\0' ) *p=' ';
-  //Serial.println(s0); 
-  for( int i=start; i<argc; i++) { if(i>start) Serial.print(' '); Serial.print(argv[i]);  }
-  Serial.println();
+  //aocmd_cint_out->println(s0); 
+  for( int i=start; i<argc; i++) { if(i>start) aocmd_cint_out->print(' '); aocmd_cint_out->print(argv[i]);  }
+  aocmd_cint_out->println();
 }
 
 
@@ -123,6 +127,8 @@ static const char aocmd_echo_longhelp[] PROGMEM =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_echo_register() {
-  return aocmd_cint_register(aocmd_echo_main, PSTR("echo"), PSTR("echo a message (or en/disables echoing)"), aocmd_echo_longhelp);
+  return aocmd_cint_register(aocmd_echo_main, PSTR("echo"), PSTR("echo a message (or en/disables echoing)"), AOCMD_LONGHELP(aocmd_echo_longhelp));
 }
 
+
+#endif // AOCMD_CONFIG_ECHO
@@ -1,4 +1,4 @@
-// aocmd_file.cpp - command handler for the "file" command, also implements a one-file file system.
+// aocmd_file.cpp - command handler for the "file" command, also implements a small file system.
 /*****************************************************************************
  * Copyright 2024,2025 by ams OSRAM AG                                       *
  * All rights are reserved.                                                  *
@@ -22,68 +22,465 @@
 
 #include <Arduino.h>        // Serial.print
 #include <esp32-hal-cpu.h>  // esp_reset_reason(), ESP_RST_POWERON
-#include <EEPROM.h>         // BEGIN()
+#include <EEPROM.h>         // EEPROM (only to migrate the old boot.cmd)
+#include <Preferences.h>    // Preferences (NVS) holds the files
 #include <aoresult.h>       // AORESULT_ASSERT
 #include <aocmd_cint.h>     // aocmd_cint_register, aocmd_cint_isprefix, ...
 #include <aocmd_file.h>     // own
 
 
-// === aocmd_file_bootcmd.h ================================================
+#if AOCMD_CONFIG_FILE
+
+
+// === aocmd_file_store.h ==================================================
+
+
+// Files are stored in NVS (namespace AOCMD_FILE_NVS_NS). NVS itself is log structured: 
+// writes are appended to flash pages, and pages are erased round robin, so wear is spread.
+// On top of that, a file has two slots (a and b), each a header plus up to AOCMD_FILE_MAXCHUNKS 
+// chunks. The header caches the CRC32 of the content and has a generation counter; the valid 
+// slot with the newest generation is the file. A write goes to the other slot, and only then 
+// its header is written (NVS writes one key atomically), so a power loss during a write leaves 
+// the previous content. For boot.cmd the previous slot is kept as fallback (used when the
+// newest slot fails its CRC32), for other files it is removed after the write (saves NVS space).
+// An append writes one new chunk and the (small) header, not the whole file. A write with
+// unchanged content (same size and CRC32) writes nothing. A directory key lists the file names.
+//   key <name>~s   header of slot s (s=a or b, aocmd_file_hdr_t)
+//   key <name>~si  chunk i of slot s (i=0..AOCMD_FILE_MAXCHUNKS-1)
+//   key ~dir       names of all files, each 0-terminated
+//   key ~bootbin   boot.cmd precompiled (see aocmd_file_binhdr_t)
+#define AOCMD_FILE_NVS_NS         "aocmdfs"
+#define AOCMD_FILE_NVS_DIRKEY     "~dir"
+#define AOCMD_FILE_NVS_BOOTBINKEY "~bootbin"
+#define AOCMD_FILE_MAXCHUNKS      8      // an append when all chunks are used, rewrites file as one chunk
+#define AOCMD_FILE_KEYSIZE        (AOCMD_FILE_NAMELEN+4) // <name>~si plus terminating 0 (NVS max key length is 15)
+
+
+// File header (one per slot)
+typedef struct aocmd_file_hdr_s {
+  uint16_t size;     // total size of all chunks
+  uint8_t  chunks;   // number of chunks in use
+  uint8_t  rsv;      // reserved (0)
+  uint32_t crc;      // CRC32 of all chunks
+  uint32_t gen;      // generation, incremented on every write or append
+} aocmd_file_hdr_t;
+
+
+// Returns true iff name is a legal file name (1..AOCMD_FILE_NAMELEN chars from [A-Za-z0-9._-]).
+static bool aocmd_file_name_isok(const char * name);
+// Loads the directory from NVS (called at init).
+static void aocmd_file_dir_load();
+// Returns index of name in directory, or -1.
+static int  aocmd_file_dir_find(const char * name);
+
+
+// === aocmd_file_store.cpp ================================================
+
+
+// The directory (cached in RAM)
+static char aocmd_file_dir[AOCMD_FILE_MAXFILES][AOCMD_FILE_NAMELEN+1];
+static int  aocmd_file_dir_num;
+
+
+/*!
+    @brief  Computes the CRC32 (IEEE 802.3, as used by zip) over `size` bytes of `data`.
+    @param  crc
+            The CRC32 of the preceding data, 0 to start.
+    @param  data
+            The bytes to add.
+    @param  size
+            The number of bytes.
+    @return The CRC32 of the preceding data followed by `data`.
+*/
+uint32_t aocmd_file_crc32(uint32_t crc, const void * data, int size) {
+  const uint8_t * p= (const uint8_t *)data;
+  crc= ~crc;
+  while( size-- > 0 ) {
+    crc ^= *p++;
+    for( int bit=0; bit<8; bit++ ) crc= (crc>>1) ^ (0xEDB88320 & -(crc&1));
+  }
+  return ~crc;
+}
+
+
+// Returns true iff name is a legal file name (1..AOCMD_FILE_NAMELEN chars from [A-Za-z0-9._-]).
+static bool aocmd_file_name_isok(const char * name) {
+  int len= strlen(name);
+  if( len<1 || len>AOCMD_FILE_NAMELEN ) return false;
+  for( int i=0; i<len; i++ ) {
+    char ch= name[i];
+    if( !isalnum(ch) && ch!='.' && ch!='_' && ch!='-' ) return false;
+  }
+  return true;
+}
+
+
+// Composes the NVS key of chunk ix of slot of file name (ix<0 for the header key)
+static void aocmd_file_key(char * key, const char * name, int slot, int ix) {
+  if( ix<0 ) snprintf(key, AOCMD_FILE_KEYSIZE, "%s~%c", name, 'a'+slot);
+  else snprintf(key, AOCMD_FILE_KEYSIZE, "%s~%c%d", name, 'a'+slot, ix);
+}
+
+
+// Loads the headers of both slots of name into hdr[]; returns the slot with the newest generation, or -1 if there is none.
+static int aocmd_file_slot_newest(Preferences * prefs, const char * name, aocmd_file_hdr_t hdr[2]) {
+  bool valid[2];
+  for( int slot=0; slot<2; slot++ ) {
+    char key[AOCMD_FILE_KEYSIZE];
+    aocmd_file_key(key,name,slot,-1);
+    valid[slot]= prefs->isKey(key) && prefs->getBytes(key, &hdr[slot], sizeof hdr[slot])==sizeof hdr[slot];
+  }
+  if( valid[0] && valid[1] ) return (int32_t)(hdr[1].gen-hdr[0].gen)>0 ? 1 : 0; // wrap-around safe
+  if( valid[0] ) return 0;
+  if( valid[1] ) return 1;
+  return -1;
+}
+
+
+// Removes header and chunks of slot of name (prefs open for writing).
+static void aocmd_file_slot_remove(Preferences * prefs, const char * name, int slot) {
+  char key[AOCMD_FILE_KEYSIZE];
+  aocmd_file_key(key,name,slot,-1);
+  if( prefs->isKey(key) ) prefs->remove(key); // first header: slot is invalid before chunks disappear
+  for( int ix=0; ix<AOCMD_FILE_MAXCHUNKS; ix++ ) {
+    aocmd_file_key(key,name,slot,ix);
+    if( prefs->isKey(key) ) prefs->remove(key);
+  }
+}
+
+
+// Reads the content of slot of name (header hdr) into buf; returns size, or -2 if corrupt (CRC32) or too big.
+static int aocmd_file_slot_read(Preferences * prefs, const char * name, int slot, const aocmd_file_hdr_t * hdr, char * buf, int bufsize) {
+  if( hdr->size+1>bufsize ) return -2;
+  int size= 0;
+  for( int ix=0; ix<hdr->chunks; ix++ ) {
+    char key[AOCMD_FILE_KEYSIZE];
+    aocmd_file_key(key,name,slot,ix);
+    int len= prefs->getBytesLength(key);
+    if( size+len>hdr->size ) return -2;
+    size+= prefs->getBytes(key, buf+size, len);
+  }
+  if( size!=hdr->size || aocmd_file_crc32(0,buf,size)!=hdr->crc ) return -2;
+  return size;
+}
+
+
+// Loads the directory from NVS (called at init).
+static void aocmd_file_dir_load() {
+  char buf[AOCMD_FILE_MAXFILES*(AOCMD_FILE_NAMELEN+1)];
+  Preferences prefs;
+  aocmd_file_dir_num= 0;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,true) ) return;
+  int size= prefs.getBytes(AOCMD_FILE_NVS_DIRKEY, buf, sizeof buf);
+  prefs.end();
+  for( int pos=0; pos<size && aocmd_file_dir_num<AOCMD_FILE_MAXFILES; pos+=strlen(buf+pos)+1 ) {
+    strncpy(aocmd_file_dir[aocmd_file_dir_num], buf+pos, AOCMD_FILE_NAMELEN);
+    aocmd_file_dir[aocmd_file_dir_num][AOCMD_FILE_NAMELEN]= 0;
+    aocmd_file_dir_num++;
+  }
+}
+
+
+// Saves the directory to NVS (with prefs already open for writing).
+static bool aocmd_file_dir_save(Preferences * prefs) {
+  char buf[AOCMD_FILE_MAXFILES*(AOCMD_FILE_NAMELEN+1)];
+  int size= 0;
+  for( int ix=0; ix<aocmd_file_dir_num; ix++ ) {
+    strcpy(buf+size, aocmd_file_dir[ix]);
+    size+= strlen(aocmd_file_dir[ix])+1;
+  }
+  if( size==0 ) { prefs->remove(AOCMD_FILE_NVS_DIRKEY); return true; }
+  return prefs->putBytes(AOCMD_FILE_NVS_DIRKEY, buf, size)==(size_t)size;
+}
+
+
+// Returns index of name in directory, or -1.
+static int aocmd_file_dir_find(const char * name) {
+  for( int ix=0; ix<aocmd_file_dir_num; ix++ ) if( strcmp(aocmd_file_dir[ix],name)==0 ) return ix;
+  return -1;
+}
+
+
+/*!
+    @brief  Returns the name of the file at position `ix` in the directory.
+    @param  ix
+            Index, 0 upwards.
+    @return The file name, or 0 when `ix` is past the last file.
+*/
+const char * aocmd_file_dir_get(int ix) {
+  if( ix<0 || ix>=aocmd_file_dir_num ) return 0;
+  return aocmd_file_dir[ix];
+}
+
+
+/*!
+    @brief  Gets size, CRC32 and number of chunks of file `name`.
+    @param  name
+            The file name.
+    @param  size, crc, chunks
+            Receive the file properties (each may be 0).
+    @return true iff the file exists.
+*/
+bool aocmd_file_stat(const char * name, int * size, uint32_t * crc, int * chunks) {
+  if( aocmd_file_dir_find(name)<0 ) return false;
+  aocmd_file_hdr_t hdr[2];
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,true) ) return false;
+  int slot= aocmd_file_slot_newest(&prefs, name, hdr);
+  prefs.end();
+  if( slot<0 ) return false;
+  if( size ) *size= hdr[slot].size;
+  if( crc ) *crc= hdr[slot].crc;
+  if( chunks ) *chunks= hdr[slot].chunks;
+  return true;
+}
+
+
+/*!
+    @brief  Reads file `name` into `buf`.
+    @param  name
+            The file name.
+    @param  buf
+            Receives the content; a terminating 0 is appended.
+    @param  bufsize
+            Size of `buf`; must be at least file size plus one.
+    @return The file size, -1 if the file does not exist, -2 if it is corrupt (CRC32) or too big.
+    @note   When the newest slot is corrupt, the previous slot (if kept) is returned.
+*/
+int aocmd_file_read(const char * name, char * buf, int bufsize) {
+  if( aocmd_file_dir_find(name)<0 ) return -1;
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,true) ) return -1;
+  aocmd_file_hdr_t hdr[2];
+  int slot= aocmd_file_slot_newest(&prefs, name, hdr);
+  int size= -1;
+  if( slot>=0 ) {
+    size= aocmd_file_slot_read(&prefs, name, slot, &hdr[slot], buf, bufsize);
+    char key[AOCMD_FILE_KEYSIZE];
+    aocmd_file_key(key,name,1-slot,-1);
+    if( size==-2 && prefs.isKey(key) ) size= aocmd_file_slot_read(&prefs, name, 1-slot, &hdr[1-slot], buf, bufsize);
+  }
+  prefs.end();
+  if( size>=0 ) buf[size]= 0;
+  return size;
+}
+
+
+// Writes `size` bytes of `data` as chunk `ix` of `slot` of `name` and then the slot header (prefs open for writing).
+static int aocmd_file_putchunk(Preferences * prefs, const char * name, int slot, int ix, const char * data, int size, aocmd_file_hdr_t * hdr) {
+  char key[AOCMD_FILE_KEYSIZE];
+  aocmd_file_key(key,name,slot,ix);
+  if( size>0 && prefs->putBytes(key, data, size)!=(size_t)size ) return -1;
+  aocmd_file_key(key,name,slot,-1);
+  if( prefs->putBytes(key, hdr, sizeof *hdr)!=sizeof *hdr ) return -1; // commit
+  if( aocmd_file_dir_find(name)<0 ) {
+    strcpy(aocmd_file_dir[aocmd_file_dir_num++], name);
+    if( !aocmd_file_dir_save(prefs) ) return -1;
+  }
+  return hdr->size;
+}
+
+
+/*!
+    @brief  Creates or overwrites file `name` with `size` bytes from `data`.
+    @param  name
+            The file name (see aocmd_file_name_isok).
+    @param  data
+            The content.
+    @param  size
+            The number of bytes (max AOCMD_FILE_MAXSIZE).
+    @return The file size, or -1 on failure (illegal name, too big, directory full, NVS failure).
+    @note   When the file already has exactly this content, nothing is written (saves flash wear).
+    @note   The content is written to the slot not in use, and committed by writing its header;
+            a power loss before that leaves the previous content.
+*/
+int aocmd_file_write(const char * name, const char * data, int size) {
+  if( !aocmd_file_name_isok(name) || size<0 || size>AOCMD_FILE_MAXSIZE ) return -1;
+  bool exists= aocmd_file_dir_find(name)>=0;
+  if( !exists && aocmd_file_dir_num==AOCMD_FILE_MAXFILES ) return -1;
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,false) ) return -1;
+  aocmd_file_hdr_t old[2];
+  int slot= aocmd_file_slot_newest(&prefs, name, old);
+  aocmd_file_hdr_t hdr= { (uint16_t)size, (uint8_t)(size>0?1:0), 0, aocmd_file_crc32(0,data,size), slot<0 ? 1 : old[slot].gen+1 };
+  if( slot>=0 && old[slot].size==size && old[slot].crc==hdr.crc ) { prefs.end(); return size; } // unchanged
+  int target= slot<0 ? 0 : 1-slot;
+  aocmd_file_slot_remove(&prefs, name, target); // oldest version
+  int result= aocmd_file_putchunk(&prefs, name, target, 0, data, size, &hdr);
+  if( result>=0 && slot>=0 && strcmp(name,AOCMD_FILE_BOOTCMD)!=0 ) aocmd_file_slot_remove(&prefs, name, slot);
+  prefs.end();
+  return result;
+}
+
 
+/*!
+    @brief  Appends `size` bytes from `data` to file `name` (creates it when it does not exist).
+    @param  name
+            The file name (see aocmd_file_name_isok).
+    @param  data
+            The content to append.
+    @param  size
+            The number of bytes (file may not exceed AOCMD_FILE_MAXSIZE).
+    @return The new file size, or -1 on failure.
+    @note   Only the appended bytes are written (as a new chunk), unless all 
+            AOCMD_FILE_MAXCHUNKS chunks are in use; then the file is rewritten as one chunk.
+*/
+int aocmd_file_append(const char * name, const char * data, int size) {
+  if( aocmd_file_dir_find(name)<0 ) return aocmd_file_write(name, data, size);
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,false) ) return -1;
+  aocmd_file_hdr_t old[2];
+  int slot= aocmd_file_slot_newest(&prefs, name, old);
+  if( slot<0 ) { prefs.end(); return aocmd_file_write(name, data, size); }
+  int oldsize= old[slot].size;
+  if( size<0 || oldsize+size>AOCMD_FILE_MAXSIZE ) { prefs.end(); return -1; }
+  if( size==0 ) { prefs.end(); return oldsize; }
+  if( old[slot].chunks==AOCMD_FILE_MAXCHUNKS ) {
+    // Compact: read all, rewrite as one chunk (temporary buffer)
+    prefs.end();
+    char * buf= (char *)malloc(AOCMD_FILE_MAXSIZE+1);
+    if( buf==0 ) return -1;
+    int result= -1;
+    if( aocmd_file_read(name, buf, AOCMD_FILE_MAXSIZE+1)==oldsize ) {
+      memcpy(buf+oldsize, data, size);
+      result= aocmd_file_write(name, buf, oldsize+size);
+    }
+    free(buf);
+    return result;
+  }
+  // The new chunk is not part of the file until the header is written
+  aocmd_file_hdr_t hdr= { (uint16_t)(oldsize+size), (uint8_t)(old[slot].chunks+1), 0, aocmd_file_crc32(old[slot].crc,data,size), old[slot].gen+1 };
+  int result= aocmd_file_putchunk(&prefs, name, slot, old[slot].chunks, data, size, &hdr);
+  prefs.end();
+  return result;
+}
 
-// The boot.cmd file contains a string; it is stored in EEPROM, with terminating 0. 
-// This is the amount of EEPROM space reserved for it. One byte is appended, a check sum.
-#define AOCMD_FILE_BOOTCMD_MAXSIZE  2047         
 
+/*!
+    @brief  Deletes file `name`.
+    @param  name
+            The file name.
+    @return true iff the file existed and is deleted.
+*/
+bool aocmd_file_delete(const char * name) {
+  int ix= aocmd_file_dir_find(name);
+  if( ix<0 ) return false;
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,false) ) return false;
+  aocmd_file_slot_remove(&prefs, name, 0);
+  aocmd_file_slot_remove(&prefs, name, 1);
+  if( strcmp(name,AOCMD_FILE_BOOTCMD)==0 ) prefs.remove(AOCMD_FILE_NVS_BOOTBINKEY);
+  for( ; ix<aocmd_file_dir_num-1; ix++ ) strcpy(aocmd_file_dir[ix], aocmd_file_dir[ix+1]);
+  aocmd_file_dir_num--;
+  bool ok= aocmd_file_dir_save(&prefs);
+  prefs.end();
+  return ok;
+}
 
-// Executes commands in boot.cmd on POR (encapsulates next three).
+
+// === aocmd_file_bootcmd.h ================================================
+
+
+// Executes commands in boot.cmd on POR (encapsulates next two).
 void aocmd_file_bootcmd_exec_on_por();
 // Returns true iff the ESP was booted from Power On Reset.
 static bool aocmd_file_bootcmd_reset_is_por();             
-// Returns true iff boot.cmd is not empty and not corrupt (checksum).
-static bool aocmd_file_bootcmd_available();             
-// Executes commands in boot.cmd.
-static void aocmd_file_bootcmd_exec();
-
-// Computes checksum of boot.cmd.
-static uint8_t aocmd_file_bootcmd_checksum();
-                                                 
-// Opens boot.cmd for reading; sets pointer at start.                                                 
-static void aocmd_file_bootcmd_readopen();              
-// Returns byte at pointer, or -1 for eof. Steps pointer.
-static int  aocmd_file_bootcmd_readbyte();              
-// Closes boot.cmd for reading.
-static void aocmd_file_bootcmd_readclose();             
-
-// Opens boot.cmd for writing; clears it; sets pointer at start.
-static void aocmd_file_bootcmd_writeopen();             
-// Writes byte to pointer. Steps pointer. Returns true iff success, false on file too long.
-static bool aocmd_file_bootcmd_writebyte(uint8_t byte); 
-// Returns -1 if commit fails, otherwise returns number of bytes written.
-static int  aocmd_file_bootcmd_writeclose();            
+// Executes commands in file name; returns false if file is missing or corrupt.
+static bool aocmd_file_exec(const char * name);
+// Copies an old style boot.cmd (EEPROM, up to version 0.6) to the file store.
+static void aocmd_file_bootcmd_migrate();
+// Returns the precompiled boot.cmd (compiles it when needed) in a buffer the caller must free(); returns 0 if not possible.
+static char * aocmd_file_bootbin_get();
+// Executes the precompiled boot.cmd in `bin`.
+static void aocmd_file_bootbin_exec(const char * bin);
+// Precompiles boot.cmd when `name` (just written) is boot.cmd.
+static void aocmd_file_bootbin_update(const char * name);
 
 
 // === aocmd_file_bootcmd.cpp ===============================================
 
 
-#define AOCMD_FILE_BOOTCMD_STARTADDR_DATA     0
-#define AOCMD_FILE_BOOTCMD_STARTADDR_CSUM     AOCMD_FILE_BOOTCMD_MAXSIZE 
-#define AOCMD_FILE_BOOTCMD_EEPROMSIZE         (AOCMD_FILE_BOOTCMD_MAXSIZE+1) // checksum is one byte
+// The old style boot.cmd: 2047 bytes with terminating 0 in EEPROM, followed by a checksum byte.
+#define AOCMD_FILE_BOOTCMD_EEPROM_MAXSIZE     2047
+#define AOCMD_FILE_BOOTCMD_EEPROMSIZE         (AOCMD_FILE_BOOTCMD_EEPROM_MAXSIZE+1) // checksum is one byte
+
+
+// Buffers for file content are allocated (AOCMD_FILE_MAXSIZE+1 bytes) while in use, not kept in RAM.
+#define AOCMD_FILE_BUFSIZE        (AOCMD_FILE_MAXSIZE+1)
+
+
+// Set while a file is being executed.
+static bool aocmd_file_execbusy;
+
 
+// The command descriptors of the command interpreter (friend module)
+typedef struct aocmd_cint_desc_s { 
+  aocmd_cint_func_t   main; 
+  const char * name; 
+  const char * shorthelp; 
+  const char * longhelp; 
+} aocmd_cint_desc_t;
+extern int aocmd_cint_descs_count;
+extern aocmd_cint_desc_t aocmd_cint_descs[AOCMD_CINT_REGISTRATION_SLOTS];
+extern aocmd_cint_desc_t * aocmd_cint_find(char * name );
+extern void aocmd_cint_run(aocmd_cint_desc_t * d, int argc, char * argv[]);
+extern bool aocmd_cint_echo;
+
+
+// boot.cmd is also stored precompiled (key AOCMD_FILE_NVS_BOOTBINKEY): comments are 
+// stripped, lines are split in arguments, and commands are resolved to descriptor index. 
+// Executing it skips the character-by-character command interpreter. The precompiled 
+// form is only used when it matches the CRC32 of boot.cmd and the command table signature;
+// otherwise it is recompiled (or, if that fails, boot.cmd is interpreted as text).
+//   header (aocmd_file_binhdr_t)
+//   per line: [ix][argc][arg0 0 arg1 0 ...], ix is AOCMD_FILE_BIN_NOCMD when not resolved
+#define AOCMD_FILE_BIN_NOCMD      0xFF
+
+
+// Precompiled boot.cmd header
+typedef struct aocmd_file_binhdr_s {
+  uint32_t srccrc;   // CRC32 of boot.cmd it was compiled from
+  uint32_t sig;      // signature (CRC32) of the registered command names
+  uint16_t lines;    // number of lines
+  uint16_t rsv;      // reserved (0)
+} aocmd_file_binhdr_t;
 
-// The pointer into boot.cmd file.
-static int  aocmd_file_bootcmd_ptr;
 
 
 /*!
-    @brief  Initializes the persistent ESP file system (EEPROM based).
-    @note   Prints to Serial upon failure.
+    @brief  Initializes the persistent ESP file system (NVS based).
+    @note   Prints to the output sink upon failure.
+    @note   An old style boot.cmd (EEPROM) is moved to the file store.
 */
 void aocmd_file_init() {
-  AORESULT_ASSERT( EEPROM.length()==0 ); // Not yet inited
-  bool ok = EEPROM.begin(AOCMD_FILE_BOOTCMD_EEPROMSIZE);
-  AORESULT_ASSERT( EEPROM.length()==AOCMD_FILE_BOOTCMD_EEPROMSIZE ); // inited
-  if( !ok) Serial.printf("file: init FAILED\n");
+  Preferences prefs;
+  bool ok = prefs.begin(AOCMD_FILE_NVS_NS,false); // creates namespace if needed
+  prefs.end();
+  if( !ok) aocmd_cint_printf("file: init FAILED\n");
+  aocmd_file_dir_load();
+  aocmd_file_bootcmd_migrate();
+}
+
+
+// Copies an old style boot.cmd (EEPROM, up to version 0.6) to the file store.
+static void aocmd_file_bootcmd_migrate() {
+  if( aocmd_file_dir_find(AOCMD_FILE_BOOTCMD)>=0 ) return;
+  if( !EEPROM.begin(AOCMD_FILE_BOOTCMD_EEPROMSIZE) ) return;
+  uint8_t csum=0xA5; // same "random" start value as old checksum
+  int size=0;
+  while( size<AOCMD_FILE_BOOTCMD_EEPROM_MAXSIZE && EEPROM.read(size)!=0 ) csum+= EEPROM.read(size++);
+  char * buf= 0;
+  if( size>0 && size<AOCMD_FILE_BOOTCMD_EEPROM_MAXSIZE && csum==EEPROM.read(AOCMD_FILE_BOOTCMD_EEPROM_MAXSIZE) && (buf=(char *)malloc(size))!=0 ) {
+    for( int i=0; i<size; i++ ) buf[i]= EEPROM.read(i);
+    if( aocmd_file_write(AOCMD_FILE_BOOTCMD, buf, size)==size ) {
+      // Clear the EEPROM copy, otherwise a deleted boot.cmd would be migrated again on next init
+      EEPROM.write(0, 0);
+      EEPROM.commit();
+      aocmd_cint_printf("file: moved 'boot.cmd' to file store\n");
+    }
+    free(buf);
+  }
+  EEPROM.end();
 }
 
 
@@ -94,24 +491,24 @@ void aocmd_file_init() {
             are initialized (there might be commands that use those libraries),
             in particular make sure Serial and aocmd are initialized.
     @note   "boot.cmd" is stored in the persistent ESP filesystem.
-    @note   If there is no "boot.cmd" this message is printed to Serial.
-    @note   If the ESP resarted, but not from POR, this message is printed to Serial.
-    @note   If "boot.cmd" is executed, this message is printed to Serial.
+    @note   If there is no "boot.cmd" this message is printed to the output sink.
+    @note   If the ESP resarted, but not from POR, this message is printed to the output sink.
+    @note   If "boot.cmd" is executed, this message is printed to the output sink.
 */
 void aocmd_file_bootcmd_exec_on_por() {
-  AORESULT_ASSERT( EEPROM.length()==AOCMD_FILE_BOOTCMD_EEPROMSIZE ); // inited
-  if( !aocmd_file_bootcmd_available() ) {
-    Serial.printf("No 'boot.cmd' file available to execute\n");
+  int size;
+  if( !aocmd_file_stat(AOCMD_FILE_BOOTCMD, &size, 0, 0) || size==0 ) {
+    aocmd_cint_printf("No 'boot.cmd' file available to execute\n");
     return;
   }
   
   if( ! aocmd_file_bootcmd_reset_is_por() ) {
-    Serial.printf("Only power-on-reset runs 'boot.cmd'\n");
+    aocmd_cint_printf("Only power-on-reset runs 'boot.cmd'\n");
     return;
   }
 
-  Serial.printf("Running 'boot.cmd'\n");
-  aocmd_file_bootcmd_exec();
+  aocmd_cint_printf("Running 'boot.cmd'\n");
+  aocmd_file_exec(AOCMD_FILE_BOOTCMD);
 }
 
 
@@ -121,91 +518,168 @@ static bool aocmd_file_bootcmd_reset_is_por() {
 }
 
 
-// Returns true iff boot.cmd is not empty and not corrupt (checksum).
-static bool aocmd_file_bootcmd_available() {
-  bool empty = EEPROM.read(AOCMD_FILE_BOOTCMD_STARTADDR_DATA)==0; // terminating 0 as first byte
-  bool csumok = aocmd_file_bootcmd_checksum() == EEPROM.read(AOCMD_FILE_BOOTCMD_STARTADDR_CSUM);
-  return !empty && csumok;
-}
-
-
-// Executes commands in boot.cmd.
-static void aocmd_file_bootcmd_exec() {
-  if( !aocmd_file_bootcmd_available() ) { Serial.printf("file: 'boot.cmd' empty\n"); return; }
-  aocmd_file_bootcmd_readopen();
+// Executes commands in file name; returns false if file is missing or corrupt.
+static bool aocmd_file_exec(const char * name) {
+  if( aocmd_file_execbusy ) { aocmd_cint_printf("ERROR: 'file exec' can not be nested\n"); return false; }
+  char * bin= strcmp(name,AOCMD_FILE_BOOTCMD)==0 ? aocmd_file_bootbin_get() : 0;
+  if( bin!=0 ) {
+    aocmd_file_execbusy= true;
+    aocmd_file_bootbin_exec(bin);
+    aocmd_file_execbusy= false;
+    free(bin);
+    return true;
+  }
+  char * buf= (char *)malloc(AOCMD_FILE_BUFSIZE);
+  if( buf==0 ) { aocmd_cint_printf("ERROR: out of memory\n"); return false; }
+  int size= aocmd_file_read(name, buf, AOCMD_FILE_BUFSIZE);
+  if( size<=0 ) {
+    if( size==-1 ) aocmd_cint_printf("file: '%s' does not exist\n", name);
+    if( size==-2 ) aocmd_cint_printf("ERROR: '%s' is corrupt\n", name);
+    if( size==0 ) aocmd_cint_printf("file: '%s' empty\n", name);
+    free(buf);
+    return false;
+  }
+  aocmd_file_execbusy= true;
   aocmd_cint_prompt(); // Print a prompt for the first line of the script
-  int ch; while( (ch=aocmd_file_bootcmd_readbyte()) >= 0 ) aocmd_cint_add(ch);
+  for( int i=0; i<size; i++ ) aocmd_cint_add(buf[i]);
   if( aocmd_cint_pendingschars()>0 ) aocmd_cint_add('\n');
-  Serial.printf("\n\n"); // white line after final >>
-  aocmd_file_bootcmd_readclose();
-}
-
-
-// Computes checksum of boot.cmd.
-static uint8_t aocmd_file_bootcmd_checksum() {
-  uint8_t csum=0xA5; // some "random" value which is not all 0s or all 1s.
-  for( int ptr=0; ptr<AOCMD_FILE_BOOTCMD_MAXSIZE; ptr++ ) {
-    uint8_t byte = EEPROM.read(AOCMD_FILE_BOOTCMD_STARTADDR_DATA+ptr);
-    if( byte==0 ) break; // found terminating 0
-    csum += byte;
-  }
-  return csum;
-}
-
-
-// Opens boot.cmd for reading; sets pointer at start.                                                 
-static void aocmd_file_bootcmd_readopen() {
-  aocmd_file_bootcmd_ptr = 0;
+  aocmd_cint_printf("\n\n"); // white line after final >>
+  aocmd_file_execbusy= false;
+  free(buf);
+  return true;
 }
 
 
-// Returns byte at pointer, or -1 for eof. Steps pointer.
-static int aocmd_file_bootcmd_readbyte() {
-  if( aocmd_file_bootcmd_ptr==AOCMD_FILE_BOOTCMD_MAXSIZE ) return -1;
-  uint8_t byte = EEPROM.read(AOCMD_FILE_BOOTCMD_STARTADDR_DATA+aocmd_file_bootcmd_ptr);
-  if( byte==0 ) return -1;
-  aocmd_file_bootcmd_ptr++;
-  return byte;
+// Returns the signature of the command table (a precompiled boot.cmd refers to descriptor indices).
+static uint32_t aocmd_file_bootbin_sig() {
+  uint32_t crc= 0;
+  for( int ix=0; ix<aocmd_cint_descs_count; ix++ ) crc= aocmd_file_crc32(crc, aocmd_cint_descs[ix].name, strlen(aocmd_cint_descs[ix].name)+1);
+  return crc;
 }
 
 
-// Closes boot.cmd for reading.
-static void aocmd_file_bootcmd_readclose() {
-  // skip
+// Compiles `size` chars of `src` (destroyed) into `bin` (AOCMD_FILE_BUFSIZE bytes); returns the compiled size, or -1 when it can not be compiled.
+// A line is handled exactly like aocmd_cint_add()/aocmd_cint_exec() would do; lines they would truncate or edit (backspace), or with several commands, are not compiled.
+static int aocmd_file_bootbin_compile(char * bin, char * src, int size, uint32_t srccrc) {
+  aocmd_file_binhdr_t hdr= { srccrc, aocmd_file_bootbin_sig(), 0, 0 };
+  int binsize= sizeof hdr;
+  int pos= 0;
+  while( pos<size ) {
+    // Isolate a line (every CR and every LF terminates a line, also a final unterminated line)
+    char * line= src+pos;
+    int len= 0;
+    while( pos+len<size && line[len]!='\n' && line[len]!='\r' ) len++;
+    pos+= len+1;
+    if( len>=AOCMD_CINT_BUFSIZE-1 || memchr(line,'\b',len)!=0 ) return -1;
+    line[len]= '\0';
+    char * cmt= strstr(line,"//");
+    if( cmt!=0 ) *cmt= '\0';
+    // Split in arguments
+    char * argv[AOCMD_CINT_MAXARGS];
+    int argc= 0;
+    for( char * tok= strtok(line," \t"); tok!=0; tok= strtok(0," \t") ) {
+      if( argc==AOCMD_CINT_MAXARGS ) return -1;
+      if( strcmp(tok,AOCMD_CINT_SEP)==0 || strcmp(tok,AOCMD_CINT_SEPAND)==0 ) return -1; // several commands on a line: run as text
+      argv[argc++]= tok;
+    }
+    // Resolve the command
+    uint8_t ix= AOCMD_FILE_BIN_NOCMD;
+    if( argc>0 ) {
+      aocmd_cint_desc_t * d= aocmd_cint_find( argv[0][0]=='@' ? argv[0]+1 : argv[0] );
+      if( d!=0 ) ix= d-aocmd_cint_descs;
+    }
+    // Emit the line
+    if( binsize+2>AOCMD_FILE_BUFSIZE ) return -1;
+    bin[binsize++]= ix;
+    bin[binsize++]= argc;
+    for( int i=0; i<argc; i++ ) {
+      int arglen= strlen(argv[i])+1;
+      if( binsize+arglen>AOCMD_FILE_BUFSIZE ) return -1;
+      memcpy(bin+binsize, argv[i], arglen);
+      binsize+= arglen;
+    }
+    hdr.lines++;
+  }
+  memcpy(bin, &hdr, sizeof hdr);
+  return binsize;
 }
 
 
-// Opens boot.cmd for writing; clears it; sets pointer at start.
-static void aocmd_file_bootcmd_writeopen() {
-  // While writing, aocmd_file_bootcmd_ptr always points to first free position.
-  aocmd_file_bootcmd_ptr = 0;
+// Returns the precompiled boot.cmd (compiles it when needed) in a buffer the caller must free(); returns 0 if not possible.
+static char * aocmd_file_bootbin_get() {
+  int srcsize;
+  uint32_t srccrc;
+  if( !aocmd_file_stat(AOCMD_FILE_BOOTCMD, &srcsize, &srccrc, 0) || srcsize==0 ) return 0;
+  char * bin= (char *)malloc(AOCMD_FILE_BUFSIZE);
+  if( bin==0 ) return 0;
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_FILE_NVS_NS,false) ) { free(bin); return 0; }
+  aocmd_file_binhdr_t hdr;
+  int binsize= prefs.getBytes(AOCMD_FILE_NVS_BOOTBINKEY, bin, AOCMD_FILE_BUFSIZE);
+  memcpy(&hdr, bin, sizeof hdr);
+  if( binsize<(int)sizeof hdr || hdr.srccrc!=srccrc || hdr.sig!=aocmd_file_bootbin_sig() ) {
+    // Missing or stale: (re)compile (source in a second temporary buffer)
+    char * src= (char *)malloc(AOCMD_FILE_BUFSIZE);
+    int size= src==0 ? -1 : aocmd_file_read(AOCMD_FILE_BOOTCMD, src, AOCMD_FILE_BUFSIZE);
+    binsize= size<0 ? -1 : aocmd_file_bootbin_compile(bin, src, size, srccrc);
+    free(src);
+    if( binsize<0 || prefs.putBytes(AOCMD_FILE_NVS_BOOTBINKEY, bin, binsize)!=(size_t)binsize ) {
+      prefs.remove(AOCMD_FILE_NVS_BOOTBINKEY);
+      binsize= -1;
+    }
+  }
+  prefs.end();
+  if( binsize<0 ) { free(bin); return 0; }
+  return bin;
 }
 
 
-// Writes byte to pointer. Steps pointer. Returns true iff success, false on file too long.
-static bool aocmd_file_bootcmd_writebyte(uint8_t byte) {
-  if( aocmd_file_bootcmd_ptr==AOCMD_FILE_BOOTCMD_MAXSIZE-1 ) return false;
-  // While writing, aocmd_file_bootcmd_ptr always points to first free position.
-  EEPROM.write(AOCMD_FILE_BOOTCMD_STARTADDR_DATA+aocmd_file_bootcmd_ptr++, byte); 
-  return true;
+// Executes the precompiled boot.cmd in `bin`.
+static void aocmd_file_bootbin_exec(const char * bin) {
+  aocmd_file_binhdr_t hdr;
+  memcpy(&hdr, bin, sizeof hdr);
+  char * p= (char *)bin + sizeof hdr;
+  aocmd_cint_prompt(); // Print a prompt for the first line of the script
+  for( int line=0; line<hdr.lines; line++ ) {
+    uint8_t ix= *p++;
+    int argc= (uint8_t)*p++;
+    char * argv[AOCMD_CINT_MAXARGS];
+    for( int i=0; i<argc; i++ ) { argv[i]= p; p+= strlen(p)+1; }
+    if( aocmd_cint_echo ) {
+      for( int i=0; i<argc; i++ ) aocmd_cint_printf(i==0?"%s":" %s",argv[i]);
+      aocmd_cint_out->println();
+    }
+    // Same dispatch as aocmd_cint_exec()
+    aocmd_cint_func_t streamfunc= aocmd_cint_get_streamfunc();
+    if( streamfunc ) {
+      streamfunc(argc, argv);
+    } else if( argc==0 ) {
+      // Empty line
+    } else if( ix==AOCMD_FILE_BIN_NOCMD ) {
+      aocmd_cint_printf("ERROR: command '%s' not found (try help)\n", argv[0][0]=='@' ? argv[0]+1 : argv[0]);
+    } else {
+      aocmd_cint_run(&aocmd_cint_descs[ix], argc, argv);
+    }
+    aocmd_cint_prompt();
+  }
+  aocmd_cint_printf("\n\n"); // white line after final >>
 }
 
 
-// Returns -1 if commit fails, otherwise returns number of bytes written.
-static int aocmd_file_bootcmd_writeclose() {
-  // While writing, aocmd_file_bootcmd_ptr always points to first free position.
-  EEPROM.write(AOCMD_FILE_BOOTCMD_STARTADDR_DATA+aocmd_file_bootcmd_ptr, 0);
-  uint8_t csum = aocmd_file_bootcmd_checksum();
-  //Serial.printf("csum=0x%02x\n",csum);
-  EEPROM.write(AOCMD_FILE_BOOTCMD_STARTADDR_CSUM,csum);
-  if( !EEPROM.commit() ) return -1;
-  return aocmd_file_bootcmd_ptr;
+// Precompiles boot.cmd when `name` (just written) is boot.cmd (not when written from a running script, that is compiled when next executed)
+static void aocmd_file_bootbin_update(const char * name) {
+  if( strcmp(name,AOCMD_FILE_BOOTCMD)==0 && !aocmd_file_execbusy ) free(aocmd_file_bootbin_get());
 }
 
 
 // === The actual "file" command ============================================
 
 
+// file write streaming mode: the content being recorded (allocated while recording)
+static char * aocmd_file_write_buf;
+static int  aocmd_file_write_size;
+static char aocmd_file_write_name[AOCMD_FILE_NAMELEN+1];
+static bool aocmd_file_write_append;
 // file write streaming mode: line number
 static int aocmd_file_write_linenum;
 
@@ -219,67 +693,207 @@ static void aocmd_file_write_setprompt() {
 }
 
 
+// file write streaming mode: appends byte to recording, returns false if file too long
+static bool aocmd_file_write_byte(char ch) {
+  if( aocmd_file_write_size==AOCMD_FILE_MAXSIZE ) return false;
+  aocmd_file_write_buf[aocmd_file_write_size++]= ch;
+  return true;
+}
+
+
 // file write streaming mode: handler
 static void aocmd_file_write_streamfunc( int argc, char * argv[] ) {
   if( argc==0 ) {
     // Input is a white line: save file and terminate streamin mode
-    int size = aocmd_file_bootcmd_writeclose();
-    if( size>=0 ) Serial.printf("file: %d bytes written\n",size); else Serial.printf("ERROR: save failed\n");
+    int size;
+    if( aocmd_file_write_append ) size= aocmd_file_append(aocmd_file_write_name, aocmd_file_write_buf, aocmd_file_write_size);
+    else size= aocmd_file_write(aocmd_file_write_name, aocmd_file_write_buf, aocmd_file_write_size);
+    if( size>=0 ) aocmd_cint_printf("file: %d bytes written\n",aocmd_file_write_size); else aocmd_cint_printf("ERROR: save failed\n");
     aocmd_cint_set_streamfunc(0);
+    free(aocmd_file_write_buf);
+    aocmd_file_write_buf= 0;
+    if( size>0 ) aocmd_file_bootbin_update(aocmd_file_write_name);
     return;
   }
   // Real line, append to file
+  int oldsize= aocmd_file_write_size;
   bool ok = true;
   for( int i=0; i<argc; i++ ) {
-    if( i>0 ) ok &= aocmd_file_bootcmd_writebyte(' '); // space _between_ args
+    if( i>0 ) ok &= aocmd_file_write_byte(' '); // space _between_ args
     char * s=argv[i];
-    while( *s!=0 ) ok &= aocmd_file_bootcmd_writebyte(*s++);
+    while( *s!=0 ) ok &= aocmd_file_write_byte(*s++);
   }
-  ok &= aocmd_file_bootcmd_writebyte('\n'); // terminate line
-  if( !ok ) { Serial.printf("ERROR: file too long\n"); return; }
+  ok &= aocmd_file_write_byte('\n'); // terminate line
+  if( !ok ) { aocmd_file_write_size= oldsize; aocmd_cint_printf("ERROR: file too long\n"); return; }
   aocmd_file_write_setprompt();
 }
 
 
+// Parse 'file (record|append) [<name>]'
+static void aocmd_file_record( int argc, char * argv[], bool append ) {
+  const char * name= argc==3 ? argv[2] : AOCMD_FILE_BOOTCMD;
+  if( !aocmd_file_name_isok(name) ) { aocmd_cint_printf("ERROR: illegal file name '%s'\n",name); return; }
+  if( aocmd_file_dir_find(name)<0 && aocmd_file_dir_num==AOCMD_FILE_MAXFILES ) { aocmd_cint_printf("ERROR: too many files (max %d)\n",AOCMD_FILE_MAXFILES); return; }
+  aocmd_file_write_buf= (char *)malloc(AOCMD_FILE_MAXSIZE);
+  if( aocmd_file_write_buf==0 ) { aocmd_cint_printf("ERROR: out of memory\n"); return; }
+  strcpy(aocmd_file_write_name,name);
+  aocmd_file_write_append= append;
+  aocmd_file_write_size= 0;
+  aocmd_file_write_linenum=0;
+  aocmd_file_write_setprompt();
+  aocmd_cint_set_streamfunc(aocmd_file_write_streamfunc);
+}
+
+
+// file upload: the host may send at most AOCMD_FILE_UPLOAD_WINDOW blocks ahead; every consumed block is granted again.
+// The window must fit in the UART receive buffer (256 bytes by default).
+#define AOCMD_FILE_UPLOAD_BLOCK      128
+#define AOCMD_FILE_UPLOAD_WINDOW     2
+#define AOCMD_FILE_UPLOAD_TIMEOUT_MS 2000
+
+
+// file upload: receives `size` bytes in `buf`, checks `crc` and writes file `name`.
+static void aocmd_file_upload_recv( char * buf, const char * name, int size, uint32_t crc, bool quiet ) {
+  // Receive (raw bytes, not via the command interpreter)
+  uint32_t t0= micros();
+  int received= 0;
+  int granted= size<AOCMD_FILE_UPLOAD_WINDOW*AOCMD_FILE_UPLOAD_BLOCK ? size : AOCMD_FILE_UPLOAD_WINDOW*AOCMD_FILE_UPLOAD_BLOCK;
+  Serial.printf("upload: credit %d\n",granted); // flow control goes to the sender, so always to Serial (not the output sink)
+  uint32_t tlast= millis();
+  bool skiplf= aocmd_cint_eol()=='\r'; // the command line ended on CR; a host using CR LF sends the LF before the data
+  while( received<size ) {
+    int ch= Serial.read();
+    if( ch==-1 ) {
+      if( millis()-tlast>AOCMD_FILE_UPLOAD_TIMEOUT_MS ) { aocmd_cint_printf("ERROR: upload timeout (%d of %d bytes received)\n",received,size); return; }
+      yield();
+      continue;
+    }
+    tlast= millis();
+    if( skiplf ) { skiplf= false; if( ch=='\n' ) continue; }
+    buf[received++]= ch;
+    if( received%AOCMD_FILE_UPLOAD_BLOCK==0 && granted<size ) {
+      int credit= size-granted<AOCMD_FILE_UPLOAD_BLOCK ? size-granted : AOCMD_FILE_UPLOAD_BLOCK;
+      granted+= credit;
+      Serial.printf("upload: credit %d\n",credit);
+    }
+  }
+  uint32_t t1= micros();
+  // Verify and commit
+  uint32_t actual= aocmd_file_crc32(0,buf,size);
+  if( actual!=crc ) { aocmd_cint_printf("ERROR: upload has crc %08lX, expected %08lX (file not written)\n",(unsigned long)actual,(unsigned long)crc); return; }
+  if( aocmd_file_write(name,buf,size)!=size ) { aocmd_cint_printf("ERROR: save failed\n"); return; }
+  if( size>0 ) aocmd_file_bootbin_update(name);
+  unsigned long rate= t1-t0==0 ? 0 : (unsigned long)((uint64_t)size*1000000/(t1-t0));
+  if( !quiet ) aocmd_cint_printf("file: upload '%s' %d bytes (%lu bytes/s)\n", name, size, rate); // parsed by python/libosplink
+}
+
+
+// Parse 'file upload <name> <size> <crc>'
+static void aocmd_file_upload( int argc, char * argv[] ) {
+  if( argc!=5 ) { aocmd_cint_printf("ERROR: 'upload' expects <name> <size> <crc>\n"); return; }
+  const char * name= argv[2];
+  if( !aocmd_file_name_isok(name) ) { aocmd_cint_printf("ERROR: illegal file name '%s'\n",name); return; }
+  if( aocmd_file_dir_find(name)<0 && aocmd_file_dir_num==AOCMD_FILE_MAXFILES ) { aocmd_cint_printf("ERROR: too many files (max %d)\n",AOCMD_FILE_MAXFILES); return; }
+  int size;
+  if( !aocmd_cint_parse_dec(argv[3],&size) || size<0 || size>AOCMD_FILE_MAXSIZE ) { aocmd_cint_printf("ERROR: 'upload' expects <size> 0..%d, not '%s'\n",AOCMD_FILE_MAXSIZE,argv[3]); return; }
+  char * end;
+  uint32_t crc= strtoul(argv[4],&end,16);
+  if( *argv[4]==0 || *end!=0 || strlen(argv[4])>8 ) { aocmd_cint_printf("ERROR: 'upload' expects <crc> (hex), not '%s'\n",argv[4]); return; }
+  char * buf= (char *)malloc(size>0 ? size : 1);
+  if( buf==0 ) { aocmd_cint_printf("ERROR: out of memory\n"); return; }
+  aocmd_file_upload_recv(buf, name, size, crc, argv[0][0]=='@');
+  free(buf);
+}
+
+
+// Shows the content of file `name`
+static void aocmd_file_show(const char * name) {
+  char * buf= (char *)malloc(AOCMD_FILE_BUFSIZE);
+  if( buf==0 ) { aocmd_cint_printf("ERROR: out of memory\n"); return; }
+  int size= aocmd_file_read(name, buf, AOCMD_FILE_BUFSIZE);
+  aocmd_cint_printf("file: '%s' ", name);
+  if( size==-1 ) aocmd_cint_printf("does not exist\n");
+  else if( size==-2 ) aocmd_cint_printf("corrupt\n");
+  else if( size==0 ) aocmd_cint_printf("empty\n");
+  else {
+    aocmd_cint_printf("content:\n");
+    for( int i=0; i<size; i++ ) aocmd_cint_printf("%c",buf[i]);
+  }
+  free(buf);
+}
+
+
+// Shows all files
+static void aocmd_file_list() {
+  int total= 0;
+  for( int ix=0; ix<aocmd_file_dir_num; ix++ ) {
+    int size=0, chunks=0;
+    uint32_t crc=0;
+    aocmd_file_stat(aocmd_file_dir[ix], &size, &crc, &chunks);
+    aocmd_cint_printf("%-*s %5d bytes  crc %08lX  %d chunks\n", AOCMD_FILE_NAMELEN, aocmd_file_dir[ix], size, (unsigned long)crc, chunks);
+    total+= size;
+  }
+  aocmd_cint_printf("total %d files, %d bytes\n", aocmd_file_dir_num, total);
+}
+
+
 // The handler for the "file" command
 static void aocmd_file_main( int argc, char * argv[] ) {
-  AORESULT_ASSERT( EEPROM.length()==AOCMD_FILE_BOOTCMD_EEPROMSIZE ); // inited
-  if( argc==1 ) {
-    Serial.printf("ERROR: 'file' needs argument\n"); return;
-  } else if( argc>2 ) {
-    Serial.printf("ERROR: 'file' has too many args\n"); return;
-  } else if( argc>1 && aocmd_cint_isprefix("show",argv[1])) {
-    Serial.printf("file: 'boot.cmd' ");
-    if( !aocmd_file_bootcmd_available() ) { Serial.printf("empty\n"); return; }
-    Serial.printf("content:\n");
-    aocmd_file_bootcmd_readopen();
-    int ch; while( (ch=aocmd_file_bootcmd_readbyte()) >= 0 ) Serial.printf("%c",ch);
-    aocmd_file_bootcmd_readclose();
-  } else if( argc>1 && aocmd_cint_isprefix("exec",argv[1])) {
-    aocmd_file_bootcmd_exec();
-  } else if( argc>1 && aocmd_cint_isprefix("record",argv[1])) {
-    aocmd_file_bootcmd_writeopen();
-    aocmd_file_write_linenum=0;
-    aocmd_file_write_setprompt();
-    aocmd_cint_set_streamfunc(aocmd_file_write_streamfunc);
+  if( argc==1 || aocmd_cint_isprefix("list",argv[1]) ) {
+    if( argc>2 ) { aocmd_cint_printf("ERROR: 'list' has too many args\n"); return; }
+    aocmd_file_list();
+    return;
+  }
+  const char * name= argc==3 ? argv[2] : AOCMD_FILE_BOOTCMD;
+  if( argc>=2 && aocmd_cint_isprefix("upload",argv[1]) ) {
+    aocmd_file_upload(argc,argv);
+    return;
+  }
+  if( argc>3 ) {
+    aocmd_cint_printf("ERROR: 'file' has too many args\n"); return;
+  }
+  if( aocmd_cint_isprefix("show",argv[1])) {
+    aocmd_file_show(name);
+  } else if( aocmd_cint_isprefix("exec",argv[1])) {
+    aocmd_file_exec(name);
+  } else if( aocmd_cint_isprefix("record",argv[1])) {
+    aocmd_file_record(argc,argv,false);
+  } else if( aocmd_cint_isprefix("append",argv[1])) {
+    aocmd_file_record(argc,argv,true);
+  } else if( aocmd_cint_isprefix("delete",argv[1])) {
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'delete' expects <name>\n"); return; }
+    if( !aocmd_file_delete(name) ) { aocmd_cint_printf("ERROR: '%s' not deleted\n", name); return; }
+    if( argv[0][0]!='@' ) aocmd_cint_printf("file: '%s' deleted\n", name);
   } else {
-    Serial.printf("ERROR: 'file' expects 'show', 'exec', or 'record', not '%s'\n",argv[1]); return;
+    aocmd_cint_printf("ERROR: 'file' expects 'list', 'show', 'exec', 'record', 'append', 'upload', ");
+    aocmd_cint_printf("or 'delete', not '%s'\n",argv[1]); return;
   }
 }
 
 
 // The long help text for the "file" command.
 static const char aocmd_file_longhelp[] = 
-  "SYNTAX: file show\n"
+  "SYNTAX: file [list]\n"
+  "- lists all files with size, CRC32 and number of chunks\n"
+  "SYNTAX: file show [<name>]\n"
   "- shows the content of the file (prints to console)\n"
-  "SYNTAX: file exec\n"
+  "SYNTAX: file exec [<name>]\n"
   "- feed the content of file to the command interpreter (executes it)\n"
-  "SYNTAX: file record\n"
+  "SYNTAX: file (record|append) [<name>]\n"
   "- prompt changes and <line>s are entered (each terminated by CR)\n"
-  "- every <line> is written to the file\n"
+  "- every <line> is written to the file ('append' adds to existing content)\n"
   "- an empty <line> stops recording and commits content to file\n"
+  "SYNTAX: file upload <name> <size> <crc>\n"
+  "- receives <size> raw bytes (decimal) for file <name>, checks their CRC32 <crc> (hex)\n"
+  "- flow control: the host sends no more bytes than granted by 'upload: credit <n>'\n"
+  "- the file is only written when all bytes are received and the CRC32 matches\n"
+  "SYNTAX: file delete <name>\n"
+  "- deletes the file\n"
   "NOTES:\n"
-  "- there is only one file (boot.cmd); it is run on cold startup\n"
+  "- <name> is 1 to 12 chars from A-Z a-z 0-9 . _ - (default boot.cmd)\n"
+  "- max 16 files of max 4095 bytes; stored in NVS (flash) with CRC32\n"
+  "- boot.cmd is run on cold startup\n"
+  "- boot.cmd is also stored precompiled (tokenized, commands resolved)\n"
   "- can make it empty with 'file record', then empty line\n"
 ;
 
@@ -292,6 +906,8 @@ static const char aocmd_file_longhelp[] =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_file_register() {
-  return aocmd_cint_register(aocmd_file_main, "file", "manages the file 'boot.cmd' with commands run at startup", aocmd_file_longhelp);
+  return aocmd_cint_register(aocmd_file_main, "file", "manages files (e.g. 'boot.cmd' with commands run at startup)", AOCMD_LONGHELP(aocmd_file_longhelp));
 }
 
+
+#endif // AOCMD_CONFIG_FILE
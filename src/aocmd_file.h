@@ -1,4 +1,4 @@
-// aocmd_file.h - command handler for the "file" command, also implements a one-file file system.
+// aocmd_file.h - command handler for the "file" command, also implements a small file system.
 /*****************************************************************************
  * Copyright 2024 by ams OSRAM AG                                            *
  * All rights are reserved.                                                  *
@@ -22,14 +22,45 @@
 #define _AOCMD_FILE_H_
 
 
+#include <aocmd_config.h> // AOCMD_CONFIG_FILE
+
+
 // Registers the built-in "file" command with the command interpreter.
 int aocmd_file_register();
 
 
+#if AOCMD_CONFIG_FILE
 // Initialize the file system.
 void aocmd_file_init();
 // Executes the file "boot.cmd" on power on reset, by feeding its content to the command interpreter.
 void aocmd_file_bootcmd_exec_on_por();
+#else
+// The "file" command is compiled out (see aocmd_config.h); these stubs keep the callers unchanged.
+static inline void aocmd_file_init() {}
+static inline void aocmd_file_bootcmd_exec_on_por() {}
+#endif
+
+
+#define AOCMD_FILE_BOOTCMD     "boot.cmd" // name of the file run on power on reset
+#define AOCMD_FILE_NAMELEN     12         // max length of a file name
+#define AOCMD_FILE_MAXFILES    16         // max number of files
+#define AOCMD_FILE_MAXSIZE     4095       // max size of a file
+
+
+// Computes CRC32 of data (pass crc of preceding data, or 0 to start).
+uint32_t aocmd_file_crc32(uint32_t crc, const void * data, int size);
+// Returns name of file ix in the directory (0 for past last).
+const char * aocmd_file_dir_get(int ix);
+// Gets size, CRC32, and chunk count of a file; returns false if it does not exist.
+bool aocmd_file_stat(const char * name, int * size, uint32_t * crc, int * chunks);
+// Reads file into buf (0-terminated); returns size, -1 for not existing, -2 for corrupt or too big.
+int  aocmd_file_read(const char * name, char * buf, int bufsize);
+// Creates or overwrites file; returns size or -1.
+int  aocmd_file_write(const char * name, const char * data, int size);
+// Appends to file (creates it if needed); returns new size or -1.
+int  aocmd_file_append(const char * name, const char * data, int size);
+// Deletes file; returns false if it did not exist or failed.
+bool aocmd_file_delete(const char * name);
 
 
 #endif
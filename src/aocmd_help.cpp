@@ -25,9 +25,13 @@
 
 #include <Arduino.h>        // Serial.print
 #include <aocmd_cint.h>     // aocmd_cint_register, aocmd_cint_isprefix, ...
+#include <aocmd_config.h>   // AOCMD_CONFIG_HELP
 #include <aocmd_help.h>     // own
 
 
+#if AOCMD_CONFIG_HELP
+
+
 //---------------------------------------------------------------------------
 // This is a friend module of aocmd_cint. 
 // It needs access to these private parts
@@ -55,39 +59,69 @@ extern aocmd_cint_desc_t * aocmd_cint_find(char * name );
 //---------------------------------------------------------------------------
 
 
+// Index of the sections of the long help texts: offsets of the section header lines 
+// (lines starting with an uppercase letter: SYNTAX, NOTES). The index of a command is built 
+// when it registers; entry `slot` (same index as aocmd_cint_descs) refers to a range of the pool.
+// Note that on ESP32, PROGMEM is memory mapped, so the text is read in place.
+#ifndef AOCMD_HELP_POOLSIZE
+#define AOCMD_HELP_POOLSIZE 128 // total sections of all commands; further sections of a command are merged into its last
+#endif
+typedef struct aocmd_help_index_s {
+  uint16_t first; // first entry in aocmd_help_pool[]
+  uint16_t num;   // number of sections; entry first+num is end of text (0 when the pool was full)
+} aocmd_help_index_t;
+static aocmd_help_index_t aocmd_help_index[AOCMD_CINT_REGISTRATION_SLOTS];
+static uint16_t aocmd_help_pool[AOCMD_HELP_POOLSIZE];
+static int      aocmd_help_pool_num;
+
+
+/*!
+    @brief  Indexes the sections of `longhelp` of the command registered in `slot`.
+    @param  slot
+            The slot (index in the descriptor table) the command is registered in; 
+            the commands in this and higher slots have moved up one slot.
+    @param  longhelp
+            The long help text of the command.
+    @note   Called by aocmd_cint_register(), not intended for client code.
+*/
+void aocmd_help_index_insert(int slot, const char * longhelp) {
+  for( int ix=aocmd_cint_descs_count-1; ix>slot; ix-- ) aocmd_help_index[ix]= aocmd_help_index[ix-1];
+  aocmd_help_index_t * index= &aocmd_help_index[slot];
+  index->num= 0;
+  if( aocmd_help_pool_num+2>AOCMD_HELP_POOLSIZE ) return; // pool full: not indexed, shown as a whole
+  index->first= aocmd_help_pool_num;
+  int len= strlen_P(longhelp);
+  for( int pos=0; pos<len; ) {
+    if( pos==0 || (isupper(longhelp[pos]) && aocmd_help_pool_num<AOCMD_HELP_POOLSIZE-1) ) { aocmd_help_pool[aocmd_help_pool_num++]= pos; index->num++; }
+    const char * nl= strchr(longhelp+pos,'\n');
+    pos= nl==0 ? len : nl-longhelp+1;
+  }
+  aocmd_help_pool[aocmd_help_pool_num++]= len;
+}
+
+
 // if verbose==0 only show section headers
 // if topic==0 show all (SYNTAX) sections, otherwise show sections whose header contains `topic`
-static void aocmd_help_showlonghelp(const char * longhelp, int verbose, const char * topic) {
-  // longhelp is in PROGMEM so we need to get the chars one by one...
-  //for(unsigned i=0; i<strlen_P(d->longhelp); i++) 
-  //  Serial.print((char)pgm_read_byte_near(d->longhelp+i));
-
-  const char * str= longhelp; // cursor
-  int len= strlen_P(longhelp); // number of chars still to print
-  int syntax= 0; // 1 when printing a line starting with "SYNTAX"
-  int target= 1; // 1 when we had a "SYNTAX" line that matched topic
-  while( len>0 ) {
-    // Take next chunk of longhelp (into ram)
-    #define SIZE 80 // long enough for one line
-    char ram[SIZE+1]; // +1 for \0
-    int size= len<SIZE ? len : SIZE;
-    memcpy_P(ram, str, size);
-    ram[size]='\0';
-    // Break into lines
-    char *nl = strchr(ram,'\n'); // 0 when there is no newline in ram
-    if( nl!=0 ) { size= 1+nl-ram; ram[size]='\0'; } // clip after newline char
-    // Check if chunk starts with SY (SYNTAX) - if line is longer than SIZE, don't reset `syntax`
-    if( !syntax ) {
-      // Is this a section?
-      syntax= isupper(ram[0]); // SYNTAX, NOTES
-      // Is this the target section
-      if( syntax && topic ) target= strstr(ram,topic)!=0; 
+static void aocmd_help_showlonghelp(const aocmd_cint_desc_t * d, int verbose, const char * topic) {
+  const char * longhelp= d->longhelp;
+  const uint16_t * index= aocmd_help_pool + aocmd_help_index[d-aocmd_cint_descs].first;
+  int num= aocmd_help_index[d-aocmd_cint_descs].num;
+  if( num==0 ) { aocmd_cint_out->print(longhelp); return; } // not indexed (pool full)
+  for( int sx=0; sx<num; sx++ ) {
+    const char * sec= longhelp+index[sx];
+    int seclen= index[sx+1]-index[sx];
+    const char * nl= (const char *)memchr(sec,'\n',seclen);
+    int hdrlen= nl==0 ? seclen : nl-sec+1;
+    if( topic ) {
+      // Is this the target section (topic in header line)?
+      #define SIZE 80 // long enough for one line
+      char ram[SIZE+1]; // +1 for \0
+      int size= hdrlen<SIZE ? hdrlen : SIZE;
+      memcpy(ram, sec, size);
+      ram[size]='\0';
+      if( strstr(ram,topic)==0 ) continue;
     }
-    if( syntax || verbose ) if( topic==0 || target ) Serial.print(ram);
-    // If there was a newline, clear `syntax`
-    if( nl!=0 ) syntax=0;
-    str+= size;
-    len-= size;
+    aocmd_cint_out->write((const uint8_t *)sec, verbose ? seclen : hdrlen);
   }
 }
 
@@ -95,26 +129,28 @@ static void aocmd_help_showlonghelp(const char * longhelp, int verbose, const ch
 // The handler for the "help" command
 static void aocmd_help_main(int argc, char * argv[]) {
   if( argc==1 ) {
-    if( argv[0][0]!='@' ) Serial.println(F("Available commands"));
+    if( argv[0][0]!='@' ) aocmd_cint_out->println(F("Available commands"));
     for( int i=0; i<aocmd_cint_descs_count; i++ ) {
-      Serial.print(f(aocmd_cint_descs[i].name));
-      Serial.print(' ');
+      aocmd_cint_out->print(f(aocmd_cint_descs[i].name));
+      aocmd_cint_out->print(' ');
       if( argv[0][0]!='@' ) {
-        Serial.print('-');
-        Serial.print(' ');
-        Serial.println(f(aocmd_cint_descs[i].shorthelp));
+        aocmd_cint_out->print('-');
+        aocmd_cint_out->print(' ');
+        aocmd_cint_out->println(f(aocmd_cint_descs[i].shorthelp));
       }
     }
-    if( argv[0][0]=='@' ) Serial.println();
+    if( argv[0][0]=='@' ) aocmd_cint_out->println();
   } else if( argc==2 || argc==3 ) {
     aocmd_cint_desc_t * d= aocmd_cint_find(argv[1]);
     if( d==0 ) {
-      Serial.println(F("ERROR: command not found (try 'help')"));    
+      aocmd_cint_out->println(F("ERROR: command not found (try 'help')"));
+    } else if( pgm_read_byte(d->longhelp)=='\0' ) {
+      if( argv[0][0]!='@' ) aocmd_cint_out->println(F("help: no details (long help not compiled in, see AOCMD_CONFIG_LONGHELP)"));
     } else {
-      aocmd_help_showlonghelp( d->longhelp, argv[0][0]!='@', argc==3?argv[2]:0 );
+      aocmd_help_showlonghelp( d, argv[0][0]!='@', argc==3?argv[2]:0 );
     }
   } else {
-    Serial.println(F("ERROR: 'help' has too many args"));
+    aocmd_cint_out->println(F("ERROR: 'help' has too many args"));
   }
 }
 
@@ -133,6 +169,8 @@ static const char aocmd_help_longhelp[] PROGMEM =
   "- all sub commands may be shortened, for example 'help help' to 'help h'\n"
   "- normal prompt is >>, other prompt indicates streaming mode\n"
   "- commands may be suffixed with a comment starting with //\n"
+  "- a line may have several commands separated by ' ; ' (always runs next)\n"
+  "  or ' && ' (runs next only if no ERROR was printed)\n"
   "- some commands support a @ as prefix; it suppresses output of that command\n"
 ;
 
@@ -145,5 +183,8 @@ static const char aocmd_help_longhelp[] PROGMEM =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_help_register() {
-  return aocmd_cint_register(aocmd_help_main, PSTR("help"), PSTR("gives help (try 'help help')"), aocmd_help_longhelp);
+  return aocmd_cint_register(aocmd_help_main, PSTR("help"), PSTR("gives help (try 'help help')"), AOCMD_LONGHELP(aocmd_help_longhelp));
 }
+
+
+#endif // AOCMD_CONFIG_HELP
@@ -23,9 +23,21 @@
 #define _AOCMD_HELP_H_
 
 
+#include <aocmd_config.h> // AOCMD_CONFIG_HELP
+
+
 // Registers the built-in "help" command with the command interpreter.
 // The "help" command is closely integrated with the command handler (a friend module). 
 int aocmd_help_register();
 
 
+#if AOCMD_CONFIG_HELP
+// Indexes the sections of `longhelp` for the command registered in `slot` (called by aocmd_cint_register).
+void aocmd_help_index_insert(int slot, const char * longhelp);
+#else
+// The "help" command is compiled out (see aocmd_config.h); this stub keeps the caller unchanged.
+static inline void aocmd_help_index_insert(int slot, const char * longhelp) { (void)slot; (void)longhelp; }
+#endif
+
+
 #endif
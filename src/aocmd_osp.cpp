@@ -24,10 +24,16 @@
 #include <string.h>         // strchrnul
 #include <aospi.h>          // aospi_dirmux_set_bidir, aospi_tx, ...
 #include <aoosp.h>          // aoosp_crc()
+#include <Preferences.h>    // Preferences (for persisting recorded telegrams)
 #include <aocmd_cint.h>     // aocmd_cint_register, aocmd_cint_isprefix, ...
+#include <aocmd_said.h>     // aocmd_said_otp_cache_invalidate
+#include <aocmd_board.h>    // aocmd_board_crumb_tele
 #include <aocmd_osp.h>      // own
 
 
+#if AOCMD_CONFIG_OSP
+
+
 #define BITS_MASK(n)         ((1<<(n))-1)                            // series of n bits: BITS_MASK(3)=0b111 (max n=31)
 #define BITS_SLICE(v,lo,hi)  ( ((v)>>(lo)) & BITS_MASK((hi)-(lo)) )  // takes bits [lo..hi) from v: BITS_SLICE(0b11101011,2,6)=0b1010
 #define PSI(payloadsize)     ( (payloadsize)<8 ? (payloadsize) : 7 ) // convert "human" payload size, to "telegram" payload size
@@ -63,8 +69,13 @@ typedef struct aocmd_osp_variant {
 
 // Array with info on all telegram variants
 static const aocmd_osp_variant_t aocmd_osp_variant[] = {
+  #if AOCMD_CONFIG_OSP_INFO
   #define ITEM(tid,swname,serial,sizemask,respsize,teleargs,respargs,description) \
     { tid, swname, serial, sizemask, respsize, teleargs, respargs, description },
+  #else // The args and description texts are only used by 'osp info'; drop them
+  #define ITEM(tid,swname,serial,sizemask,respsize,teleargs,respargs,description) \
+    { tid, swname, serial, sizemask, respsize, 0, respargs, 0 },
+  #endif
   #include <aocmd_osp.i>
 };
 #define AOCMD_OSP_VARIANT_COUNT                    ( sizeof(aocmd_osp_variant)/sizeof(aocmd_osp_variant_t) )
@@ -93,6 +104,136 @@ typedef struct aocmd_osp_tidmap {
 static aocmd_osp_tidmap_t aocmd_osp_tidmap[0x80];
 
 
+// Flags in aocmd_osp_tidcheck_t
+#define AOCMD_OSP_TIDCHECK_INFO      0x01 // there is info on (the variants of) the tid
+#define AOCMD_OSP_TIDCHECK_BMCAST    0x02 // tid supports broadcast and multicast
+#define AOCMD_OSP_TIDCHECK_RESP      0x04 // tid has a response
+#define AOCMD_OSP_TIDCHECK_NEEDBIDIR 0x08 // tid requires dirmux in bidir
+#define AOCMD_OSP_TIDCHECK_NEEDLOOP  0x10 // tid requires dirmux in loop
+
+
+// Struct with the validation info for one tid (aggregated over its variants)
+typedef struct aocmd_osp_tidcheck {
+  uint16_t     sizemask;    // union of the sizemasks of all variants of the tid
+  uint8_t      flags;       // AOCMD_OSP_TIDCHECK_XXX
+} aocmd_osp_tidcheck_t;
+
+
+// Lookup table from tid's to validation info (computed in aocmd_osp_init() from aocmd_osp_variant[])
+static aocmd_osp_tidcheck_t aocmd_osp_tidcheck[0x80];
+
+
+// The `respargs` of a variant describe the fields in the response payload, e.g. "temp stat".
+// These are compiled (by aocmd_osp_init) into field descriptors, using these rules:
+//  - every word is a byte, e.g. "temp stat" has fields temp (byte 0) and stat (byte 1)
+//  - a word with dashes splits the byte, e.g. "flag-cred" has two nibble fields
+//  - consecutive words with the same name and a digit suffix are merged (first is msb),
+//    e.g. "red1 red0" is the 16 bit field red, and "id0 id1 id2 id3" the 32 bit field id
+//  - a word ending in "..." takes all remaining bytes, e.g. "byte..."
+
+
+// Struct describing one field in a response payload
+typedef struct aocmd_osp_field {
+  uint8_t      bitpos;      // position of the msb of the field, counted from the msb of the first payload byte
+  uint8_t      bitlen;      // length of the field in bits (0 means: all remaining bytes)
+  uint8_t      nameix;      // the name of the field is at index `nameix` in `respargs`
+  uint8_t      namelen;     // the name of the field has `namelen` chars (digit suffix or ... excluded)
+} aocmd_osp_field_t;
+
+
+// Struct mapping one vix to num fields
+typedef struct aocmd_osp_fieldmap {
+  uint8_t      num;         // Number of fields in the response payload
+  uint8_t      fix;         // First field for the vix (entry into aocmd_osp_field[])
+} aocmd_osp_fieldmap_t;
+
+
+// All field descriptors (all variants) and lookup table from vix to fields.
+#define AOCMD_OSP_FIELD_MAXCOUNT 160
+static int                  aocmd_osp_field_count;
+static aocmd_osp_field_t    aocmd_osp_field[AOCMD_OSP_FIELD_MAXCOUNT];
+static aocmd_osp_fieldmap_t aocmd_osp_fieldmap[AOCMD_OSP_VARIANT_COUNT];
+
+
+// Compiles the `respargs` of variant `vix` into field descriptors (appended to aocmd_osp_field[]).
+static void aocmd_osp_field_compile( int vix ) {
+  const aocmd_osp_variant_t * var = & aocmd_osp_variant[vix];
+  aocmd_osp_fieldmap[vix].num= 0;
+  aocmd_osp_fieldmap[vix].fix= aocmd_osp_field_count;
+  if( var->respargs==0 ) return;
+
+  const char * args = var->respargs;
+  int bitpos = 0;
+  int prvdigit = 0; // previous field name had a digit suffix
+  int ix = 0;
+  while( args[ix]!='\0' ) {
+    // Find word (skip leading spaces)
+    while( args[ix]==' ' ) ix++;
+    if( args[ix]=='\0' ) break;
+    int wordix = ix;
+    int parts = 1;
+    while( args[ix]!=' ' && args[ix]!='\0' ) { if( args[ix]=='-' ) parts++; ix++; }
+    AORESULT_ASSERT( parts==1 || parts==2 || parts==4 || parts==8 );
+    // Split word into parts (separated by dashes), each part is a field of 8/parts bits
+    int partix = wordix;
+    for( int p=0; p<parts; p++ ) {
+      int len = 0;
+      while( partix+len<ix && args[partix+len]!='-' ) len++;
+      int rawlen = len;
+      int bitlen = 8/parts;
+      int isdigit_ = 0;
+      if( len>3 && strncmp(&args[partix+len-3],"...",3)==0 ) { len-=3; bitlen=0; }
+      else if( len>1 && isdigit(args[partix+len-1]) ) { len-=1; isdigit_=1; }
+      aocmd_osp_field_t * prv = aocmd_osp_fieldmap[vix].num>0 ? &aocmd_osp_field[aocmd_osp_field_count-1] : 0;
+      if( isdigit_ && prvdigit && prv->namelen==len && strncmp(&args[prv->nameix],&args[partix],len)==0 ) {
+        // Same name with digit suffix: merge into previous field
+        prv->bitlen += bitlen;
+      } else {
+        AORESULT_ASSERT( aocmd_osp_field_count<AOCMD_OSP_FIELD_MAXCOUNT );
+        aocmd_osp_field_t * fld = &aocmd_osp_field[aocmd_osp_field_count++];
+        fld->bitpos= bitpos;
+        fld->bitlen= bitlen;
+        fld->nameix= partix;
+        fld->namelen= len;
+        aocmd_osp_fieldmap[vix].num++;
+      }
+      bitpos+= bitlen;
+      prvdigit= isdigit_;
+      partix+= rawlen+1; // skip part and dash
+    }
+  }
+  // Fixed size fields must cover the response exactly
+  const aocmd_osp_field_t * last = &aocmd_osp_field[aocmd_osp_field_count-1];
+  AORESULT_ASSERT( last->bitlen==0 || bitpos==var->respsize*8 );
+}
+
+
+// Returns the value of field `fld` from response `payload` (fields with bitlen 0 or >32 are not supported).
+static uint32_t aocmd_osp_field_get( const aocmd_osp_field_t * fld, const uint8_t * payload ) {
+  int byte0 = fld->bitpos/8;
+  int byte1 = (fld->bitpos+fld->bitlen-1)/8;
+  uint64_t val = 0;
+  for( int i=byte0; i<=byte1; i++ ) val = (val<<8) | payload[i];
+  val >>= 7 - (fld->bitpos+fld->bitlen-1)%8;
+  return (uint32_t)( val & ((1ULL<<fld->bitlen)-1) );
+}
+
+
+// Prints (to the output sink) the fields of a response payload of `size` bytes for variant `vix` as " name=value".
+static void aocmd_osp_field_print( int vix, const uint8_t * payload, int size ) {
+  const char * args = aocmd_osp_variant[vix].respargs;
+  for( int i=0; i<aocmd_osp_fieldmap[vix].num; i++ ) {
+    const aocmd_osp_field_t * fld = &aocmd_osp_field[aocmd_osp_fieldmap[vix].fix+i];
+    aocmd_cint_printf(" %.*s=", fld->namelen, &args[fld->nameix] );
+    if( fld->bitlen==0 ) {
+      for( int b=fld->bitpos/8; b<size; b++ ) aocmd_cint_printf("%02X", payload[b] );
+    } else {
+      aocmd_cint_printf("%0*lX", (fld->bitlen+3)/4, (unsigned long)aocmd_osp_field_get(fld,payload) );
+    }
+  }
+}
+
+
 /*!
     @brief  Initializes the telegram parser.
     @note   Also performs sanity check on telegram variant info,
@@ -112,7 +253,7 @@ void aocmd_osp_init() {
       AORESULT_ASSERT( 0<=var->respsize && var->respsize<=8 );
       AORESULT_ASSERT( var->sizemask!=1 || var->teleargs==0 ); // sizemask==1 means no args
       AORESULT_ASSERT( var->respsize>0 || var->respargs==0 );
-      AORESULT_ASSERT( var->description!=0 );
+      AORESULT_ASSERT( !AOCMD_CONFIG_OSP_INFO || var->description!=0 );
     } else {
       AORESULT_ASSERT( var->swname==0 );
       AORESULT_ASSERT( var->serial==0 );
@@ -144,7 +285,30 @@ void aocmd_osp_init() {
     }
   }
   AORESULT_ASSERT( vix==AOCMD_OSP_VARIANT_COUNT );
-  AORESULT_ASSERT( aocmd_osp_tidmap[0x7F].vix!=0 ); // init has run 
+  AORESULT_ASSERT( aocmd_osp_tidmap[0x7F].vix!=0 ); // init has run
+
+  // Populate the tidcheck table (variants of one tid share casting and response, only sizes differ)
+  for( int tid=0; tid<0x80; tid++ ) {
+    aocmd_osp_tidcheck[tid].sizemask= 0;
+    aocmd_osp_tidcheck[tid].flags= 0;
+    if( aocmd_osp_tidmap[tid].num==0 ) continue;
+    const aocmd_osp_variant_t * var = & aocmd_osp_variant[aocmd_osp_tidmap[tid].vix];
+    if( !AOCMD_OSP_VARIANT_HAS_INFO(var) ) continue;
+    for( int i=0; i<aocmd_osp_tidmap[tid].num; i++ ) {
+      AORESULT_ASSERT( AOCMD_OSP_VARIANT_HAS_RESPONSE(var+i) == AOCMD_OSP_VARIANT_HAS_RESPONSE(var) );
+      AORESULT_ASSERT( AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var+i) == AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var) );
+      aocmd_osp_tidcheck[tid].sizemask |= var[i].sizemask;
+    }
+    aocmd_osp_tidcheck[tid].flags |= AOCMD_OSP_TIDCHECK_INFO;
+    if( AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var) ) aocmd_osp_tidcheck[tid].flags |= AOCMD_OSP_TIDCHECK_BMCAST;
+    if( AOCMD_OSP_VARIANT_HAS_RESPONSE(var) ) aocmd_osp_tidcheck[tid].flags |= AOCMD_OSP_TIDCHECK_RESP;
+    if( tid==0x02 ) aocmd_osp_tidcheck[tid].flags |= AOCMD_OSP_TIDCHECK_NEEDBIDIR; // initbidir
+    if( tid==0x03 ) aocmd_osp_tidcheck[tid].flags |= AOCMD_OSP_TIDCHECK_NEEDLOOP; // initloop
+  }
+
+  // Compile the response descriptions into field descriptors
+  aocmd_osp_field_count= 0;
+  for( int vix=0; vix<AOCMD_OSP_VARIANT_COUNT; vix++ ) aocmd_osp_field_compile(vix);
 }
 
 
@@ -172,13 +336,14 @@ static const char * aocmd_osp_sizemask_str(int sizemask) {
   return aocmd_osp_sizemask_buf;
 }
 
-// Prints `variant` in human friendly format to Serial
+#if AOCMD_CONFIG_OSP_INFO
+// Prints `variant` in human friendly format to the output sink
 static void aocmd_osp_variant_print( const aocmd_osp_variant_t * variant ) {
-  Serial.printf("TELEGRAM %02X: ", variant->tid );
+  aocmd_cint_printf("TELEGRAM %02X: ", variant->tid );
   if( ! AOCMD_OSP_VARIANT_HAS_INFO(variant) ) {
-    Serial.printf("no info on telegram\n\n"); return;
+    aocmd_cint_printf("no info on telegram\n\n"); return;
   }
-  Serial.printf("%s\n", AOCMD_OSP_SWNAME(variant->swname) );
+  aocmd_cint_printf("%s\n", AOCMD_OSP_SWNAME(variant->swname) );
 
   #define LEN 65
   #define INDENT1 "DESCRIPTION:"
@@ -188,7 +353,7 @@ static void aocmd_osp_variant_print( const aocmd_osp_variant_t * variant ) {
   int len = strlen(str);
   while( len>0 ) {
     if( len<=LEN ) {
-      Serial.printf("%s %s\n",indent,str);
+      aocmd_cint_printf("%s %s\n",indent,str);
       str+=len; len-=len;
     } else {
       const char * spc1 = str;
@@ -198,50 +363,68 @@ static void aocmd_osp_variant_print( const aocmd_osp_variant_t * variant ) {
       }
       int num= spc1-str;
       if( num==0 ) num= LEN; // cut anyhow if no space found
-      Serial.printf("%s %.*s\n",indent,num,str);
+      aocmd_cint_printf("%s %.*s\n",indent,num,str);
       str+=num; len-=num;
     }
     indent = INDENT2;
   }
 
-  Serial.printf("CASTING    : ");
-  if( AOCMD_OSP_VARIANT_HAS_UNICAST(variant)        ) Serial.printf("uni ");
-  if( AOCMD_OSP_VARIANT_HAS_SERIALCAST(variant)     ) Serial.printf("serial ");
-  if( AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(variant) ) Serial.printf("multi ");
-  if( AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(variant) ) Serial.printf("broad ");
-  Serial.printf("\n");
-
-  Serial.printf("PAYLOAD    : %s", aocmd_osp_sizemask_str(variant->sizemask) );
-  if( variant->sizemask!=1 ) Serial.printf(" (%s)", variant->teleargs);
-  if( AOCMD_OSP_VARIANT_HAS_RESPONSE(variant) ) Serial.printf("; response %d (%s)",variant->respsize,variant->respargs ); else Serial.printf("; no response");
-  Serial.printf("\n");
-  Serial.printf("STATUS REQ : ");
+  aocmd_cint_printf("CASTING    : ");
+  if( AOCMD_OSP_VARIANT_HAS_UNICAST(variant)        ) aocmd_cint_printf("uni ");
+  if( AOCMD_OSP_VARIANT_HAS_SERIALCAST(variant)     ) aocmd_cint_printf("serial ");
+  if( AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(variant) ) aocmd_cint_printf("multi ");
+  if( AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(variant) ) aocmd_cint_printf("broad ");
+  aocmd_cint_printf("\n");
+
+  aocmd_cint_printf("PAYLOAD    : %s", aocmd_osp_sizemask_str(variant->sizemask) );
+  if( variant->sizemask!=1 ) aocmd_cint_printf(" (%s)", variant->teleargs);
+  if( AOCMD_OSP_VARIANT_HAS_RESPONSE(variant) ) aocmd_cint_printf("; response %d (%s)",variant->respsize,variant->respargs ); else aocmd_cint_printf("; no response");
+  aocmd_cint_printf("\n");
+  if( AOCMD_OSP_VARIANT_HAS_RESPONSE(variant) ) {
+    int vix = variant - aocmd_osp_variant;
+    aocmd_cint_printf("FIELDS     :");
+    for( int i=0; i<aocmd_osp_fieldmap[vix].num; i++ ) {
+      const aocmd_osp_field_t * fld = &aocmd_osp_field[aocmd_osp_fieldmap[vix].fix+i];
+      aocmd_cint_printf(" %.*s", fld->namelen, &variant->respargs[fld->nameix] );
+      if( fld->bitlen==0 ) aocmd_cint_printf("(...)"); else aocmd_cint_printf("(%d)", fld->bitlen);
+    }
+    aocmd_cint_printf(" (bits)\n");
+  }
+  aocmd_cint_printf("STATUS REQ : ");
   const aocmd_osp_variant_t * altvar = & aocmd_osp_variant[aocmd_osp_tidmap[ variant->tid ^ (1<<5) ].vix];
   if( AOCMD_OSP_VARIANT_IS_SR_VARIANT(variant) ) {
-    Serial.printf("yes");
-    Serial.printf(" (tele %02X/%s has none)", altvar->tid, AOCMD_OSP_SWNAME(altvar->swname) );
+    aocmd_cint_printf("yes");
+    aocmd_cint_printf(" (tele %02X/%s has none)", altvar->tid, AOCMD_OSP_SWNAME(altvar->swname) );
   } else {
-    Serial.printf("no");
+    aocmd_cint_printf("no");
     if( AOCMD_OSP_VARIANT_HAS_SR_VARIANT(variant) && AOCMD_OSP_VARIANT_HAS_INFO(altvar) ) {
-      Serial.printf(" (tele %02X/%s has sr)", altvar->tid, AOCMD_OSP_SWNAME(altvar->swname) );
+      aocmd_cint_printf(" (tele %02X/%s has sr)", altvar->tid, AOCMD_OSP_SWNAME(altvar->swname) );
     } else {
-      Serial.printf(" (no sr possible)" );
+      aocmd_cint_printf(" (no sr possible)" );
     }
   }
-  Serial.printf("\n");
+  aocmd_cint_printf("\n");
 
   int duplicate_found = 0;
   int tid = variant->tid;
   for( int i=0; i<AOCMD_OSP_VARIANT_COUNT; i++ ) {
     if( aocmd_osp_variant[i].tid==tid && &aocmd_osp_variant[i]!=variant ) {
-      if( ! duplicate_found ) Serial.printf("DUPLICATE  : ");
-      Serial.printf("%02X/%s ", aocmd_osp_variant[i].tid, AOCMD_OSP_SWNAME(aocmd_osp_variant[i].swname) );
+      if( ! duplicate_found ) aocmd_cint_printf("DUPLICATE  : ");
+      aocmd_cint_printf("%02X/%s ", aocmd_osp_variant[i].tid, AOCMD_OSP_SWNAME(aocmd_osp_variant[i].swname) );
       duplicate_found= 1;
     }
   }
-  if( duplicate_found ) Serial.printf("\n");
+  if( duplicate_found ) aocmd_cint_printf("\n");
+
+  aocmd_cint_printf("\n"); // final white line
+}
+#endif
+
 
-  Serial.printf("\n"); // final white line
+// Returns true if human entered `key` (from Serial) is a hex tid (e.g. "4F") and not a telegram name.
+static bool aocmd_osp_variant_ishex( const char * key ) {
+  uint16_t tid;
+  return strlen(key)==2 && isdigit(key[0]) && aocmd_cint_parse_hex(key,&tid);
 }
 
 
@@ -253,9 +436,9 @@ static int aocmd_osp_variant_find( const char * key, int * variants, int size) {
   int found = 0;
 
   // Is `key` a hex number for a tid?
-  uint16_t tid;
-  bool ok= aocmd_cint_parse_hex(key,&tid) ;
-  if( strlen(key)==2 && isdigit(key[0]) && ok ) {
+  if( aocmd_osp_variant_ishex(key) ) {
+    uint16_t tid;
+    aocmd_cint_parse_hex(key,&tid);
     for( int i=0; i<aocmd_osp_tidmap[tid].num; i++ ) {
       if( found<size ) variants[found++]= aocmd_osp_tidmap[tid].vix+i;
     }
@@ -281,6 +464,445 @@ static int aocmd_osp_variant_find( const char * key, int * variants, int size) {
 }
 
 
+// === telegram helpers ====================================================
+
+
+// Completes telegram `tx`, whose payload of `payloadsize` bytes is already in tx[3..]. 
+// Fills in preamble, `addr`, psi, `tid` and crc. Returns the telegram size.
+static int aocmd_osp_tele_frame( uint8_t * tx, uint16_t addr, int tid, int payloadsize ) {
+  tx[0] = 0xA0 | BITS_SLICE(addr,6,10);
+  tx[1] = BITS_SLICE(addr,0,6)<<2 | BITS_SLICE(PSI(payloadsize),1,3);
+  tx[2] = BITS_SLICE(PSI(payloadsize),0,1)<<7 | tid;
+  tx[3+payloadsize] = aoosp_crc(tx,3+payloadsize);
+  return 4+payloadsize;
+}
+
+
+// Returns the address field of telegram `tele` (e.g. the node that responded).
+static uint16_t aocmd_osp_tele_addr( const uint8_t * tele ) {
+  return (BITS_SLICE(tele[0],0,4)<<6) | BITS_SLICE(tele[1],2,8);
+}
+
+
+// The STAT byte (e.g. from readstat, p4err) has a different layout for the node types (see readstat in aocmd_osp.i)
+//   SAID: STATE(2) | TSTOTP | OV  | CE | LOS | OT | UV
+//   RGBI: STATE(2) | OTP    | COM | CE | LOS | OT | UV
+// TSTOTP is a mode (test password set), but OTP is an error (OTP CRC) of the RGBI.
+#define AOCMD_OSP_STAT_ERRMASK_SAID   0x1F  // OV, CE, LOS, OT, UV
+#define AOCMD_OSP_STAT_ERRMASK_RGBI   0x3F  // OTP, COM, CE, LOS, OT, UV
+#define AOCMD_OSP_STAT_ERRMASK_COMMON 0x1F  // error flags for both node types
+
+
+// Node type of one node, cached by aocmd_osp_stat_errors() (p4err is typically answered by the same node each time).
+static uint16_t aocmd_osp_stat_idaddr; // address of the cached node (0 if none)
+static uint32_t aocmd_osp_stat_id;     // identify of the cached node
+
+
+// Returns the error flags in `stat`, as reported by node `addr`, decoded for the node type of `addr`.
+// Sends an identify telegram only when the flags differ per node type, and the type of `addr` is not cached.
+// When identify fails, the node is assumed to be an RGBI (so all flags count). 
+// If `count` is not 0, it is stepped for the identify telegram.
+static uint8_t aocmd_osp_stat_errors( uint16_t addr, uint8_t stat, int * count ) {
+  if( (stat & AOCMD_OSP_STAT_ERRMASK_SAID)==(stat & AOCMD_OSP_STAT_ERRMASK_RGBI) ) return stat & AOCMD_OSP_STAT_ERRMASK_COMMON;
+  if( addr!=aocmd_osp_stat_idaddr ) {
+    uint32_t id;
+    if( count ) (*count)++;
+    if( aoosp_send_identify(addr,&id)!=aoresult_ok ) return stat & AOCMD_OSP_STAT_ERRMASK_RGBI;
+    aocmd_osp_stat_idaddr= addr;
+    aocmd_osp_stat_id= id;
+  }
+  return stat & ( AOOSP_IDENTIFY_IS_SAID(aocmd_osp_stat_id) ? AOCMD_OSP_STAT_ERRMASK_SAID : AOCMD_OSP_STAT_ERRMASK_RGBI );
+}
+
+
+// Records telegram `tele` (which was just sent) for the crash log and 
+// invalidates caches that it makes stale: reset and setotp change OTP (mirror), reset changes addresses.
+static void aocmd_osp_tele_sent( const uint8_t * tele, int telesize ) {
+  aocmd_board_crumb_tele(tele, telesize);
+  if( telesize<3 ) return;
+  int tid = tele[2] & 0x7F;
+  if( tid==0x00 || tid==0x59 || tid==0x79 ) aocmd_said_otp_cache_invalidate( tid==0x00 ? 0 : aocmd_osp_tele_addr(tele) );
+  if( tid==0x00 ) aocmd_osp_stat_idaddr= 0;
+}
+
+
+// === validation ==========================================================
+
+
+// Issues found by aocmd_osp_validate_tele() (bit mask)
+#define AOCMD_OSP_ISSUE_SHORT      0x0001 // telegram shorter than 4 bytes (other checks skipped)
+#define AOCMD_OSP_ISSUE_PREAMBLE   0x0002 // first nibble is not 0xA
+#define AOCMD_OSP_ISSUE_ADDR       0x0004 // address not in legal range
+#define AOCMD_OSP_ISSUE_BROADCAST  0x0008 // broadcast address, but tid does not support that
+#define AOCMD_OSP_ISSUE_MULTICAST  0x0010 // multicast address, but tid does not support that
+#define AOCMD_OSP_ISSUE_SIZE       0x0020 // named variant (for raw tid: no variant) does not have this payload size
+#define AOCMD_OSP_ISSUE_ILLSIZE    0x0040 // payload size can not be encoded in psi (5, 7, >8)
+#define AOCMD_OSP_ISSUE_PSI        0x0080 // psi does not match payload size
+#define AOCMD_OSP_ISSUE_NOINFO     0x0100 // no info on tid (size, casting and response not checked)
+#define AOCMD_OSP_ISSUE_CRC        0x0200 // crc incorrect
+#define AOCMD_OSP_ISSUE_DIRMUX     0x0400 // initbidir/initloop not aligned with dirmux
+#define AOCMD_OSP_ISSUE_NORESP     0x0800 // a receive command is given, but tid has no response
+#define AOCMD_OSP_ISSUE_RESP       0x1000 // tid has a response, but a tx only command is given
+
+
+// Modes for aocmd_osp_validate_tele()
+#define AOCMD_OSP_VALIDATE_SEND    0      // 'osp send' (tx or trx is derived from tid)
+#define AOCMD_OSP_VALIDATE_TX      1      // 'osp tx'
+#define AOCMD_OSP_VALIDATE_TRX     2      // 'osp trx'
+
+
+// Payload sizes that can be encoded in psi
+#define AOCMD_OSP_SIZEMASK_LEGAL   0x15F
+
+
+// Validates the `telesize` bytes in `tele`. Does not print, returns a mask of AOCMD_OSP_ISSUE_XXX.
+// The `mode` is one of AOCMD_OSP_VALIDATE_XXX, `loop` is the dirmux state.
+// When the user named a variant, `var` points to it, and the payload size is checked against 
+// that variant only; when `var` is 0 (raw tid) it is checked against all variants of the tid.
+// This function only uses the precomputed aocmd_osp_tidcheck[] (and `var`), it does not scan the variants.
+static uint16_t aocmd_osp_validate_tele( const uint8_t * tele, int telesize, int mode, int loop, const aocmd_osp_variant_t * var ) {
+  int payloadsize = telesize-4;
+  if( payloadsize<0 ) return AOCMD_OSP_ISSUE_SHORT;
+
+  uint16_t issues = 0;
+  int addr= (BITS_SLICE(tele[0],0,4)<<6) | BITS_SLICE(tele[1],2,8);
+  int psi= (BITS_SLICE(tele[1],0,2)<<1) | BITS_SLICE(tele[2],7,8);
+  int tid= BITS_SLICE(tele[2],0,7);
+  const aocmd_osp_tidcheck_t * chk = &aocmd_osp_tidcheck[tid];
+
+  // Checks not needing info
+  if( BITS_SLICE(tele[0],4,8)!=0xA ) issues|= AOCMD_OSP_ISSUE_PREAMBLE;
+  if( !AOOSP_ADDR_ISOK(addr) ) issues|= AOCMD_OSP_ISSUE_ADDR;
+  if( payloadsize>8 || !(AOCMD_OSP_SIZEMASK_LEGAL & (1<<payloadsize)) ) issues|= AOCMD_OSP_ISSUE_ILLSIZE;
+  else if( PSI(payloadsize)!=psi ) issues|= AOCMD_OSP_ISSUE_PSI;
+  if( aoosp_crc(tele,telesize-1)!=tele[telesize-1] ) issues|= AOCMD_OSP_ISSUE_CRC;
+  if( (chk->flags & AOCMD_OSP_TIDCHECK_NEEDBIDIR) && loop ) issues|= AOCMD_OSP_ISSUE_DIRMUX;
+  if( (chk->flags & AOCMD_OSP_TIDCHECK_NEEDLOOP) && !loop ) issues|= AOCMD_OSP_ISSUE_DIRMUX;
+
+  // Checks against the tid info
+  if( !(chk->flags & AOCMD_OSP_TIDCHECK_INFO) ) return issues | AOCMD_OSP_ISSUE_NOINFO;
+  uint16_t sizemask = var!=0 ? var->sizemask : chk->sizemask;
+  if( payloadsize>8 || !(sizemask & (1<<payloadsize)) ) issues|= AOCMD_OSP_ISSUE_SIZE;
+  if( !(chk->flags & AOCMD_OSP_TIDCHECK_BMCAST) ) {
+    if( AOOSP_ADDR_ISBROADCAST(addr) ) issues|= AOCMD_OSP_ISSUE_BROADCAST;
+    if( OAOSP_ADDR_ISMULTICAST(addr) ) issues|= AOCMD_OSP_ISSUE_MULTICAST;
+  }
+  if( mode==AOCMD_OSP_VALIDATE_TRX && !(chk->flags & AOCMD_OSP_TIDCHECK_RESP) ) issues|= AOCMD_OSP_ISSUE_NORESP;
+  if( mode==AOCMD_OSP_VALIDATE_TX  &&  (chk->flags & AOCMD_OSP_TIDCHECK_RESP) ) issues|= AOCMD_OSP_ISSUE_RESP;
+
+  return issues;
+}
+
+
+// Prints (to the output sink) a message for each issue in `issues` (as returned by aocmd_osp_validate_tele() for `tele` and `var`).
+// Only called when there are issues, so speed is not relevant here.
+static void aocmd_osp_validate_print( uint16_t issues, const uint8_t * tele, int telesize, const aocmd_osp_variant_t * var ) {
+  if( issues & AOCMD_OSP_ISSUE_SHORT ) { aocmd_cint_printf("validate: minimal telegram length is 4 bytes (other validation skipped)\n"); return; }
+
+  // dissect bytes
+  int payloadsize = telesize-4;
+  int addr= (BITS_SLICE(tele[0],0,4)<<6) | BITS_SLICE(tele[1],2,8);
+  int psi= (BITS_SLICE(tele[1],0,2)<<1) | BITS_SLICE(tele[2],7,8);
+  int tid= BITS_SLICE(tele[2],0,7);
+  // the variants to report on: the one named by the user, or all of the tid
+  int vix1 = var!=0 ? var-aocmd_osp_variant : aocmd_osp_tidmap[tid].vix;
+  int vix2 = var!=0 ? vix1+1 : aocmd_osp_tidmap[tid].vix+aocmd_osp_tidmap[tid].num;
+  // find variant (matching payload size), for its name
+  if( var==0 ) {
+    var = &aocmd_osp_variant[vix1];
+    for( int vix=vix1; vix<vix2; vix++ ) {
+      if( aocmd_osp_variant[vix].sizemask & (1<<payloadsize) ) var= &aocmd_osp_variant[vix];
+    }
+  }
+  const char * name = AOCMD_OSP_SWNAME(var->swname);
+
+  if( issues & AOCMD_OSP_ISSUE_NORESP ) aocmd_cint_printf("validate: a receive command is given, but %02X/%s has no response\n",tid,name);
+  if( issues & AOCMD_OSP_ISSUE_RESP ) aocmd_cint_printf("validate: %02X/%s triggers response, but a tx only command is given\n",tid,name);
+  if( issues & AOCMD_OSP_ISSUE_PREAMBLE ) aocmd_cint_printf("validate: first nibble should be preamble (0xA)\n");
+  if( issues & AOCMD_OSP_ISSUE_ADDR ) aocmd_cint_printf("validate: illegal addr %03X\n",addr);
+  if( issues & AOCMD_OSP_ISSUE_BROADCAST ) aocmd_cint_printf("validate: %02X/%s does not support broadcast\n",tid,name);
+  if( issues & AOCMD_OSP_ISSUE_MULTICAST ) aocmd_cint_printf("validate: %02X/%s does not support multicast\n",tid,name);
+  if( issues & AOCMD_OSP_ISSUE_SIZE ) {
+    aocmd_cint_printf("validate: %02X/%s does not have %d bytes as payload, but",tid,name,payloadsize );
+    const char * sep=" ";
+    for( int vix=vix1; vix<vix2; vix++ ) {
+      aocmd_cint_printf("%s%s", sep, aocmd_osp_sizemask_str(aocmd_osp_variant[vix].sizemask) );
+      sep=" or ";
+    }
+    aocmd_cint_printf(".\n");
+  }
+  if( issues & AOCMD_OSP_ISSUE_ILLSIZE ) aocmd_cint_printf("validate: illegal payload size %d (allowed is 0,1,2,3,4,6,8)\n", payloadsize);
+  if( issues & AOCMD_OSP_ISSUE_PSI ) aocmd_cint_printf("validate: payload is %d bytes so psi should be %d but is %d \n", payloadsize,PSI(payloadsize),psi);
+  if( issues & AOCMD_OSP_ISSUE_NOINFO ) aocmd_cint_printf("validate: no info on %02X/%s to validate against\n",tid,name);
+  if( issues & AOCMD_OSP_ISSUE_CRC ) aocmd_cint_printf("validate: crc %02X is incorrect (should be %02X)\n",tele[telesize-1],aoosp_crc(tele,telesize-1));
+  if( (issues & AOCMD_OSP_ISSUE_DIRMUX) && tid==0x02 ) aocmd_cint_printf("validate: 02/initbidir with dirmux in loop\n");
+  if( (issues & AOCMD_OSP_ISSUE_DIRMUX) && tid==0x03 ) aocmd_cint_printf("validate: 03/initloop with dirmux in bidir\n");
+}
+
+
+// === record and replay ==================================================
+
+
+// While recording, every telegram sent by 'osp send', 'osp tx' or 'osp trx' is appended to a buffer.
+// Each entry in the buffer is
+//   byte 0    : size of the transmitted telegram, bit 7 set when a response was received
+//   byte 1    : size of the received telegram (0 when none)
+//   byte 2    : aoresult_t of the transfer
+//   byte 3... : time (us) since start of previous telegram, as varint (7 bits per byte, lsb first)
+//   then      : the transmitted bytes, followed by the received bytes
+// When recording stops, the buffer is persisted (NVS via Preferences), so it survives a reset.
+#define AOCMD_OSP_REC_SIZE      2048
+#define AOCMD_OSP_REC_RXFLAG    0x80
+#define AOCMD_OSP_REC_NVS_NS    "aocmd"
+#define AOCMD_OSP_REC_NVS_KEY   "osprec"
+#define AOCMD_OSP_REC_MAXGAPMS  1000     // default for the longest wait between two replayed telegrams
+#define AOCMD_OSP_REC_MAXMAXGAP 60000    // largest <maxgap> accepted by 'osp replay' (keeps waits far below 2^31 us)
+static uint8_t  aocmd_osp_rec_buf[AOCMD_OSP_REC_SIZE];
+static int      aocmd_osp_rec_len;       // number of bytes used in aocmd_osp_rec_buf[]
+static int      aocmd_osp_rec_count;     // number of telegrams in aocmd_osp_rec_buf[]
+static int      aocmd_osp_rec_active;    // recording is on
+static int      aocmd_osp_rec_overflow;  // recording stopped because buffer was full
+static uint32_t aocmd_osp_rec_prevus;    // start time of previous recorded telegram
+
+
+// Appends a telegram that started at `us` to the recording buffer (if recording is active).
+static void aocmd_osp_rec_add( uint32_t us, const uint8_t * tx, int txsize, int hasrx, const uint8_t * rx, int rxsize, aoresult_t result ) {
+  if( !aocmd_osp_rec_active ) return;
+  uint32_t dt = aocmd_osp_rec_count==0 ? 0 : us - aocmd_osp_rec_prevus;
+  // Worst case entry size: 3 header bytes, 5 varint bytes, tx and rx
+  if( aocmd_osp_rec_len + 3 + 5 + txsize + rxsize > AOCMD_OSP_REC_SIZE ) { aocmd_osp_rec_active=0; aocmd_osp_rec_overflow=1; return; }
+  uint8_t * p = &aocmd_osp_rec_buf[aocmd_osp_rec_len];
+  *p++ = txsize | (hasrx ? AOCMD_OSP_REC_RXFLAG : 0);
+  *p++ = rxsize;
+  *p++ = (uint8_t)result;
+  do { *p++ = (dt & 0x7F) | (dt>0x7F ? 0x80 : 0); dt >>= 7; } while( dt>0 );
+  memcpy(p, tx, txsize); p+= txsize;
+  memcpy(p, rx, rxsize); p+= rxsize;
+  aocmd_osp_rec_len = p - aocmd_osp_rec_buf;
+  aocmd_osp_rec_count++;
+  aocmd_osp_rec_prevus = us;
+}
+
+
+// Struct with one decoded entry from the recording buffer
+typedef struct aocmd_osp_rec_entry {
+  int             txsize;
+  int             hasrx;
+  int             rxsize;
+  aoresult_t      result;
+  uint32_t        dt;
+  const uint8_t * tx;
+  const uint8_t * rx;
+} aocmd_osp_rec_entry_t;
+
+
+// Decodes the entry at offset `*pos` in the recording buffer into `entry`, and steps `*pos`.
+// Returns false when there are no more entries, or when the entry is malformed 
+// (e.g. a corrupt or truncated blob from NVS); then `*pos` is set to -1.
+static bool aocmd_osp_rec_next( int * pos, aocmd_osp_rec_entry_t * entry ) {
+  if( *pos<0 || *pos>=aocmd_osp_rec_len ) return false;
+  const uint8_t * p = &aocmd_osp_rec_buf[*pos];
+  const uint8_t * end = &aocmd_osp_rec_buf[aocmd_osp_rec_len];
+  if( end-p < 3 ) { *pos= -1; return false; }
+  entry->txsize = p[0] & ~AOCMD_OSP_REC_RXFLAG;
+  entry->hasrx = (p[0] & AOCMD_OSP_REC_RXFLAG)!=0;
+  entry->rxsize = p[1];
+  entry->result = (aoresult_t)p[2];
+  p+= 3;
+  if( entry->txsize>AOSPI_TELE_MAXSIZE || entry->rxsize>AOSPI_TELE_MAXSIZE ) { *pos= -1; return false; }
+  if( (!entry->hasrx && entry->rxsize>0) || entry->result>=aoresult_numresultcodes ) { *pos= -1; return false; }
+  entry->dt = 0;
+  for( int shift=0; ; shift+=7 ) { 
+    if( p==end || shift>28 ) { *pos= -1; return false; } // truncated, or more than 5 bytes (32 bits)
+    entry->dt |= (uint32_t)(*p & 0x7F) << shift; 
+    if( !(*p++ & 0x80) ) break; 
+  }
+  if( end-p < entry->txsize+entry->rxsize ) { *pos= -1; return false; }
+  entry->tx = p; p+= entry->txsize;
+  entry->rx = p; p+= entry->rxsize;
+  *pos = p - aocmd_osp_rec_buf;
+  return true;
+}
+
+
+// Persists the recording buffer. Returns false on failure.
+static bool aocmd_osp_rec_save() {
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_OSP_REC_NVS_NS,false) ) return false;
+  // An empty recording can not be put (putBytes rejects 0 bytes); remove the key, or load would bring back the old one
+  if( aocmd_osp_rec_len==0 ) { prefs.remove(AOCMD_OSP_REC_NVS_KEY); prefs.end(); return true; }
+  size_t size = prefs.putBytes(AOCMD_OSP_REC_NVS_KEY, aocmd_osp_rec_buf, aocmd_osp_rec_len);
+  prefs.end();
+  return size==(size_t)aocmd_osp_rec_len;
+}
+
+
+// Loads the recording buffer from persistent storage (when it is empty).
+static void aocmd_osp_rec_load() {
+  if( aocmd_osp_rec_len>0 || aocmd_osp_rec_active ) return;
+  Preferences prefs;
+  if( !prefs.begin(AOCMD_OSP_REC_NVS_NS,true) ) return;
+  size_t size = prefs.getBytesLength(AOCMD_OSP_REC_NVS_KEY);
+  if( size>0 && size<=AOCMD_OSP_REC_SIZE ) aocmd_osp_rec_len = prefs.getBytes(AOCMD_OSP_REC_NVS_KEY, aocmd_osp_rec_buf, size);
+  prefs.end();
+  // Recount, and drop everything from the first malformed entry
+  aocmd_osp_rec_count = 0;
+  int pos = 0, valid = 0;
+  aocmd_osp_rec_entry_t entry;
+  while( aocmd_osp_rec_next(&pos,&entry) ) { aocmd_osp_rec_count++; valid= pos; }
+  if( pos<0 ) { aocmd_osp_rec_len= valid; aocmd_osp_rec_overflow= 0; aocmd_cint_printf("WARNING: recording truncated after %d telegrams (malformed entry)\n", aocmd_osp_rec_count); }
+}
+
+
+// === chain health monitor ================================================
+
+
+// The monitor periodically sends one telegram, round robin p4errbidir/p4errloop (matching dirmux), 
+// asktinfo, and askvinfo. These are serial cast (to 001), so one telegram covers the whole chain.
+// When the chain is healthy the interval between telegrams doubles (up to max), 
+// on an anomaly it drops back to min. While telegrams keep failing (e.g. chain unpowered) the interval 
+// also doubles, so the console is not flooded. The monitor yields to foreground traffic: 
+// if other telegrams were sent since its previous one, or a command is being typed, it skips its slot.
+// The application must call aocmd_osp_monitor_poll() from loop().
+#define AOCMD_OSP_MON_MAXYIELD      10    // after this many skipped slots in a row, the monitor sends anyhow
+
+
+// Monitor configuration and state
+static int      aocmd_osp_mon_enabled;
+static uint32_t aocmd_osp_mon_minms = 100;    // interval when there are anomalies
+static uint32_t aocmd_osp_mon_maxms = 5000;   // interval when chain is healthy for a long time
+static uint8_t  aocmd_osp_mon_tlimit = 0xBA;  // raw temperature (asktinfo max) that counts as anomaly
+static uint32_t aocmd_osp_mon_intervalms;     // current interval
+static uint32_t aocmd_osp_mon_lastms;         // time of previous slot
+static int      aocmd_osp_mon_txcount;        // aospi_txcount_get() after previous slot
+static int      aocmd_osp_mon_yields;         // number of skipped slots in a row
+static int      aocmd_osp_mon_step;           // 0=p4err, 1=asktinfo, 2=askvinfo
+static int      aocmd_osp_mon_inerror;        // p4err reported an error (for event on change)
+static int      aocmd_osp_mon_inhot;          // asktinfo reported hot (for event on change)
+static int      aocmd_osp_mon_infail;         // last monitor telegram failed (for event on change)
+
+
+// Monitor results
+static struct {
+  int        polls;       // telegrams sent by monitor
+  int        yields;      // slots skipped because of foreground activity
+  int        fails;       // telegrams that failed (aoresult not ok)
+  int        errors;      // p4err responses with error flags
+  int        hots;        // asktinfo responses above tlimit
+  uint16_t   erraddr;     // node that responded to last p4err
+  uint8_t    errtemp;     // its temperature
+  uint8_t    errstat;     // its status
+  uint8_t    tmax, tmin;  // last asktinfo response
+  uint8_t    vmax, vmin;  // last askvinfo response
+} aocmd_osp_mon;
+
+
+/*!
+    @brief  The chain health monitor upcalls this function when the chain health changes.
+    @param  event
+            One of AOCMD_OSP_MONITOR_EVENT_XXX.
+    @param  addr
+            The node that reported (for ERROR), otherwise 0.
+    @param  val1, val2
+            ERROR: temp and stat of the node, HOT/COOLED: max and min temperature,
+            FAIL: the aoresult_t (val2 unused), RECOVERED: unused.
+    @note   The implementation in this library prints a line to the output sink. It is weakly 
+            linked, so a client could itself implement aocmd_osp_monitor_event().
+*/
+void __attribute__((weak)) aocmd_osp_monitor_event(int event, uint16_t addr, uint8_t val1, uint8_t val2) {
+  switch( event ) {
+    case AOCMD_OSP_MONITOR_EVENT_ERROR       : aocmd_cint_printf("\nmonitor: error at %03X (temp %02X stat %02X)\n", addr, val1, val2); break;
+    case AOCMD_OSP_MONITOR_EVENT_ERRORCLEARED: aocmd_cint_printf("\nmonitor: error cleared\n"); break;
+    case AOCMD_OSP_MONITOR_EVENT_HOT         : aocmd_cint_printf("\nmonitor: hot (max %02X min %02X)\n", val1, val2); break;
+    case AOCMD_OSP_MONITOR_EVENT_COOLED      : aocmd_cint_printf("\nmonitor: cooled (max %02X min %02X)\n", val1, val2); break;
+    case AOCMD_OSP_MONITOR_EVENT_FAIL        : aocmd_cint_printf("\nmonitor: telegram failed (%s)\n", aoresult_to_str((aoresult_t)val1)); break;
+    case AOCMD_OSP_MONITOR_EVENT_RECOVERED   : aocmd_cint_printf("\nmonitor: telegrams recovered\n"); break;
+  }
+}
+
+
+// Sends the next monitor telegram, processes the response. Returns 1 if there is an anomaly, 2 if the telegram failed.
+static int aocmd_osp_monitor_step() {
+  uint8_t tx[AOSPI_TELE_MAXSIZE];
+  uint8_t rx[AOSPI_TELE_MAXSIZE];
+  int step = aocmd_osp_mon_step;
+  aocmd_osp_mon_step = (aocmd_osp_mon_step+1) % 3;
+  int tid = step==0 ? (aospi_dirmux_is_loop() ? 0x09 : 0x08) : (step==1 ? 0x0A : 0x0B);
+  int txsize = aocmd_osp_tele_frame(tx, AOOSP_ADDR_UNICASTMIN, tid, 0); // serial cast starts at 001
+  aoresult_t result = aospi_txrx(tx, txsize, rx, 4+2);
+  aocmd_osp_mon.polls++;
+  if( result!=aoresult_ok ) {
+    aocmd_osp_mon.fails++;
+    if( !aocmd_osp_mon_infail ) aocmd_osp_monitor_event(AOCMD_OSP_MONITOR_EVENT_FAIL, 0, result, 0);
+    aocmd_osp_mon_infail = 1;
+    return 2;
+  }
+  if( aocmd_osp_mon_infail ) aocmd_osp_monitor_event(AOCMD_OSP_MONITOR_EVENT_RECOVERED, 0, 0, 0);
+  aocmd_osp_mon_infail = 0;
+
+  if( step==0 ) {
+    aocmd_osp_mon.erraddr = aocmd_osp_tele_addr(rx);
+    aocmd_osp_mon.errtemp = rx[3];
+    aocmd_osp_mon.errstat = rx[4];
+    int inerror = aocmd_osp_stat_errors(aocmd_osp_mon.erraddr, rx[4], 0)!=0;
+    if( inerror ) aocmd_osp_mon.errors++;
+    if( inerror && !aocmd_osp_mon_inerror ) aocmd_osp_monitor_event(AOCMD_OSP_MONITOR_EVENT_ERROR, aocmd_osp_mon.erraddr, rx[3], rx[4]);
+    if( !inerror && aocmd_osp_mon_inerror ) aocmd_osp_monitor_event(AOCMD_OSP_MONITOR_EVENT_ERRORCLEARED, 0, 0, 0);
+    aocmd_osp_mon_inerror = inerror;
+    return inerror;
+  } else if( step==1 ) {
+    aocmd_osp_mon.tmax = rx[3];
+    aocmd_osp_mon.tmin = rx[4];
+    int inhot = rx[3]>=aocmd_osp_mon_tlimit;
+    if( inhot ) aocmd_osp_mon.hots++;
+    if( inhot && !aocmd_osp_mon_inhot ) aocmd_osp_monitor_event(AOCMD_OSP_MONITOR_EVENT_HOT, 0, rx[3], rx[4]);
+    if( !inhot && aocmd_osp_mon_inhot ) aocmd_osp_monitor_event(AOCMD_OSP_MONITOR_EVENT_COOLED, 0, rx[3], rx[4]);
+    aocmd_osp_mon_inhot = inhot;
+    return inhot;
+  } else {
+    aocmd_osp_mon.vmax = rx[3];
+    aocmd_osp_mon.vmin = rx[4];
+    return 0;
+  }
+}
+
+
+/*!
+    @brief  Runs the chain health monitor (when enabled with 'osp monitor on').
+    @note   Call this from loop(), e.g. next to aocmd_cint_pollserial().
+            It returns immediately when the monitor is disabled or it is not yet 
+            time for the next monitor telegram; otherwise it sends one telegram.
+    @note   Nothing is sent when the chain is not initialized (e.g. 'osp resetinit').
+*/
+void aocmd_osp_monitor_poll() {
+  if( !aocmd_osp_mon_enabled ) return;
+  uint32_t now = millis();
+  if( now - aocmd_osp_mon_lastms < aocmd_osp_mon_intervalms ) return;
+  aocmd_osp_mon_lastms = now;
+  if( aoosp_exec_resetinit_last()==0 ) return;
+
+  // Yield to foreground telegrams and commands
+  bool busy = aospi_txcount_get()!=aocmd_osp_mon_txcount || aocmd_cint_pendingschars()>0;
+  if( busy && aocmd_osp_mon_yields<AOCMD_OSP_MON_MAXYIELD ) {
+    aocmd_osp_mon_yields++;
+    aocmd_osp_mon.yields++;
+    aocmd_osp_mon_txcount = aospi_txcount_get();
+    return;
+  }
+  aocmd_osp_mon_yields = 0;
+
+  // Send and adapt interval
+  int anomaly = aocmd_osp_monitor_step();
+  aocmd_osp_mon_txcount = aospi_txcount_get();
+  if( anomaly==1 ) {
+    aocmd_osp_mon_intervalms = aocmd_osp_mon_minms;
+  } else if( anomaly==2 || aocmd_osp_mon_step==0 ) { // back off while failing, or after a full healthy round
+    aocmd_osp_mon_intervalms *= 2;
+    if( aocmd_osp_mon_intervalms>aocmd_osp_mon_maxms ) aocmd_osp_mon_intervalms = aocmd_osp_mon_maxms;
+  }
+}
+
+
 // === handler for "osp" ===================================================
 
 
@@ -288,71 +910,89 @@ static int aocmd_osp_variant_find( const char * key, int * variants, int size) {
 static int oacmd_osp_validate = 1;
 
 
+// Formats for printing the response of 'osp send'
+#define AOCMD_OSP_FORMAT_RAW     0 // all response bytes in hex: "rx A0 04 42 3C 28 B5"
+#define AOCMD_OSP_FORMAT_FIELDS  1 // payload decoded in fields: "rx temp=3C stat=28"
+#define AOCMD_OSP_FORMAT_COMPACT 2 // payload only, hex without spaces: "rx 3C28"
+static int aocmd_osp_format = AOCMD_OSP_FORMAT_RAW;
+
+
 // Shows status
 static void aocmd_osp_dirmux_show() {
-  Serial.printf("dirmux: %s\n", aospi_dirmux_is_loop() ? "loop" : "bidir" );
+  aocmd_cint_printf("dirmux: %s\n", aospi_dirmux_is_loop() ? "loop" : "bidir" );
 }
 
 
 // Show validation status
 static void aocmd_osp_validate_show() {
-  Serial.printf("validate: %s\n", oacmd_osp_validate ? "enabled" : "disabled" );
+  aocmd_cint_printf("validate: %s\n", oacmd_osp_validate ? "enabled" : "disabled" );
+}
+
+
+// Show response format
+static void aocmd_osp_format_show() {
+  const char * name = "raw";
+  if( aocmd_osp_format==AOCMD_OSP_FORMAT_FIELDS ) name= "fields";
+  if( aocmd_osp_format==AOCMD_OSP_FORMAT_COMPACT ) name= "compact";
+  aocmd_cint_printf("format: %s\n", name );
 }
 
 
 // Show tx/rx counter status
 static void aocmd_osp_count_show() {
-  Serial.printf("count: tx %d rx %d\n", aospi_txcount_get(), aospi_rxcount_get() );
+  aocmd_cint_printf("count: tx %d rx %d\n", aospi_txcount_get(), aospi_rxcount_get() );
 }
 
 
 // shows log status
 static void aocmd_osp_log_show() {
-  Serial.printf("log: " );
-  if( aoosp_loglevel_get()==aoosp_loglevel_none ) Serial.printf("none");
-  if( aoosp_loglevel_get()==aoosp_loglevel_args ) Serial.printf("args");
-  if( aoosp_loglevel_get()==aoosp_loglevel_tele ) Serial.printf("tele");
-  Serial.printf("\n");
+  aocmd_cint_printf("log: " );
+  if( aoosp_loglevel_get()==aoosp_loglevel_none ) aocmd_cint_printf("none");
+  if( aoosp_loglevel_get()==aoosp_loglevel_args ) aocmd_cint_printf("args");
+  if( aoosp_loglevel_get()==aoosp_loglevel_tele ) aocmd_cint_printf("tele");
+  aocmd_cint_printf("\n");
 }
 
 
 // Show status of the output enable of the outgoing level shifter
 static void aocmd_osp_hwtestout_show() {
-  Serial.printf("test out: %s\n", aospi_outoena_get() ? "enabled" : "disabled" );
+  aocmd_cint_printf("test out: %s\n", aospi_outoena_get() ? "enabled" : "disabled" );
 }
 
 
 // Show status of the output enable of the incoming level shifter
 static void aocmd_osp_hwtestin_show() {
-  Serial.printf("test in : %s\n", aospi_inoena_get() ? "enabled" : "disabled" );
+  aocmd_cint_printf("test in : %s\n", aospi_inoena_get() ? "enabled" : "disabled" );
 }
 
 
+#if AOCMD_CONFIG_OSP_INFO
 // Shows list of telegrams with info 
 static void aocmd_osp_info_show() {
   int printed=0;
   for( int vix=0; vix<AOCMD_OSP_VARIANT_COUNT; vix++ ) {
     const aocmd_osp_variant_t * var = & aocmd_osp_variant[vix];
     if( AOCMD_OSP_VARIANT_HAS_INFO(var) ) {
-      Serial.printf("%02X/%-16s", var->tid, AOCMD_OSP_SWNAME(var->swname) );
+      aocmd_cint_printf("%02X/%-16s", var->tid, AOCMD_OSP_SWNAME(var->swname) );
       printed++;
-      if( printed%4==0 ) Serial.printf("\n"); else  Serial.printf(" ");
+      if( printed%4==0 ) aocmd_cint_printf("\n"); else  aocmd_cint_printf(" ");
     }
   }
-  if( printed%4!=0 ) Serial.printf("\n");
+  if( printed%4!=0 ) aocmd_cint_printf("\n");
 }
+#endif
 
 
 // Parse 'osp send <addr> <tele> <data>...', validate, send, optionally receive
 static void aocmd_osp_send( int argc, char * argv[] ) {
-  if( argc<4   ) { Serial.printf("ERROR: 'send' expects <addr> <tele> <args>...\n"); return; }
-  if( argc>4+8 ) { Serial.printf("ERROR: 'send' has too many args\n"); return; }
+  if( argc<4   ) { aocmd_cint_printf("ERROR: 'send' expects <addr> <tele> <args>...\n"); return; }
+  if( argc>4+8 ) { aocmd_cint_printf("ERROR: 'send' has too many args\n"); return; }
   int payloadsize = argc-4;
 
   // get <addr>
   uint16_t addr;
   if( !aocmd_cint_parse_hex(argv[2],&addr) || !AOOSP_ADDR_ISOK(addr) ) {
-    Serial.printf("ERROR: 'send' expects <addr> %03X..%03X, not '%s'\n",AOOSP_ADDR_GLOBALMIN,AOOSP_ADDR_GLOBALMAX,argv[2]);
+    aocmd_cint_printf("ERROR: 'send' expects <addr> %03X..%03X, not '%s'\n",AOOSP_ADDR_GLOBALMIN,AOOSP_ADDR_GLOBALMAX,argv[2]);
     return;
   }
 
@@ -362,7 +1002,7 @@ static void aocmd_osp_send( int argc, char * argv[] ) {
   int found = aocmd_osp_variant_find( argv[3], variants, SEND_FINDMAX);
   const aocmd_osp_variant_t * var= 0;
   if( found==0 ) {
-    Serial.printf("ERROR: 'send' has no <tele> matching '%s'\n", argv[3]);
+    aocmd_cint_printf("ERROR: 'send' has no <tele> matching '%s'\n", argv[3]);
     return;
   } else if( found==1 ) {
     var = &aocmd_osp_variant[variants[0]];
@@ -389,67 +1029,62 @@ static void aocmd_osp_send( int argc, char * argv[] ) {
   for( int tix=3, aix=4; aix<argc; aix++, tix++ ) { // tix index in tx[], aix index in argv[]
     uint16_t data;
     bool ok= aocmd_cint_parse_hex(argv[aix],&data) ;
-    if( !ok || data>0xFF ) { Serial.printf("ERROR: 'send' expects <data> 00..FF, not '%s'\n",argv[aix]); return; }
+    if( !ok || data>0xFF ) { aocmd_cint_printf("ERROR: 'send' expects <data> 00..FF, not '%s'\n",argv[aix]); return; }
     tx[tix] = data;
   }
 
   // Constructing rest of telegram
-  tx[0] = 0xA0 | BITS_SLICE(addr,6,10);
-  tx[1] = BITS_SLICE(addr,0,6)<<2 | BITS_SLICE(PSI(payloadsize),1,3);
-  tx[2] = BITS_SLICE(PSI(payloadsize),0,1)<<7 | var->tid;
-  tx[3+payloadsize] = aoosp_crc(tx,3+payloadsize);
+  aocmd_osp_tele_frame(tx, addr, var->tid, payloadsize);
 
-  // Validation
+  // Validation (payload size against the named variant, or against all variants for a hex <tele>)
   if( oacmd_osp_validate ) {
-    if( AOCMD_OSP_VARIANT_HAS_INFO(var) ) {
-      // Validate payload size
-      if( !( var->sizemask & (1<<payloadsize) ) ) {
-        Serial.printf("validate: %02X/%s does not have %d bytes as payload, but",var->tid,AOCMD_OSP_SWNAME(var->swname),payloadsize );
-        const char * sep=" ";
-        for( int i=0; i<found; i++ ) { Serial.printf("%s%s", sep, aocmd_osp_sizemask_str(aocmd_osp_variant[variants[i]].sizemask) ); sep=" or "; }
-        Serial.printf(".\n");
-      }
-      if( payloadsize<0 || payloadsize>8 || payloadsize==5 || payloadsize==7 ) Serial.printf("validate: illegal payload size %d (allowed is 0,1,2,3,4,6,8)\n", payloadsize);
-      // Validate addressing
-      if( AOOSP_ADDR_ISBROADCAST(addr) && !AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var) ) Serial.printf("validate: %02X/%s does not support broadcast\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-      if( OAOSP_ADDR_ISMULTICAST(addr) && !AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var) ) Serial.printf("validate: %02X/%s does not support multicast\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-      // Extra check for init (to be aligned with dirmux)
-      if( var->tid==2 && aospi_dirmux_is_loop()  ) Serial.printf("validate: 02/initbidir with dirmux in loop\n");
-      if( var->tid==3 && aospi_dirmux_is_bidir() ) Serial.printf("validate: 03/initloop with dirmux in bidir\n");
-    } else {
-      // Validate: no info available
-      Serial.printf("validate: no info on %02X/%s to validate against\n",var->tid, AOCMD_OSP_SWNAME(var->swname));
-    }
+    const aocmd_osp_variant_t * valvar = aocmd_osp_variant_ishex(argv[3]) ? 0 : var;
+    uint16_t issues = aocmd_osp_validate_tele(tx, 4+payloadsize, AOCMD_OSP_VALIDATE_SEND, aospi_dirmux_is_loop(), valvar );
+    if( issues ) aocmd_osp_validate_print(issues, tx, 4+payloadsize, valvar);
   }
-  if( argv[0][0]!='@' ) Serial.printf("tx %s\n", aoosp_prt_bytes(tx,4+payloadsize) );
+  if( argv[0][0]!='@' ) aocmd_cint_printf("tx %s\n", aoosp_prt_bytes(tx,4+payloadsize) );
 
   // Execute
   uint8_t rx[AOSPI_TELE_MAXSIZE];
   memset(rx,0xA5,AOSPI_TELE_MAXSIZE);
   aoresult_t result;
+  uint32_t us = micros();
   if( AOCMD_OSP_VARIANT_HAS_INFO(var) ) {
     if( AOCMD_OSP_VARIANT_HAS_RESPONSE(var) ) {
       result = aospi_txrx(tx, payloadsize+4, rx, var->respsize+4);
-      Serial.printf("rx %s",aoosp_prt_bytes(rx,var->respsize+4));
-      if( argv[0][0]!='@' ) Serial.printf(" (%ld us)", aospi_txrx_us() );
+      aocmd_osp_rec_add(us, tx, payloadsize+4, 1, rx, var->respsize+4, result);
+      if( result!=aoresult_ok || aocmd_osp_format==AOCMD_OSP_FORMAT_RAW ) {
+        aocmd_cint_printf("rx %s",aoosp_prt_bytes(rx,var->respsize+4));
+      } else if( aocmd_osp_format==AOCMD_OSP_FORMAT_FIELDS ) {
+        aocmd_cint_printf("rx");
+        aocmd_osp_field_print(var-aocmd_osp_variant, rx+3, var->respsize);
+      } else {
+        aocmd_cint_printf("rx ");
+        for( int i=0; i<var->respsize; i++ ) aocmd_cint_printf("%02X",rx[3+i]);
+      }
+      if( argv[0][0]!='@' ) aocmd_cint_printf(" (%lu us)", (unsigned long)aospi_txrx_us() );
     } else {
       result = aospi_tx(tx, payloadsize+4);
-      Serial.printf("rx none");
+      aocmd_osp_rec_add(us, tx, payloadsize+4, 0, rx, 0, result);
+      aocmd_cint_printf("rx none");
     }
   } else {
     int actsize;
     result = aospi_txrx(tx, payloadsize+4, rx, AOSPI_TELE_MAXSIZE, &actsize );
-    Serial.printf("rx %s", aoosp_prt_bytes(rx,actsize));
-    if( argv[0][0]!='@' ) Serial.printf(" (%ld us)", aospi_txrx_us() );
+    aocmd_osp_rec_add(us, tx, payloadsize+4, 1, rx, actsize, result);
+    aocmd_cint_printf("rx %s", aoosp_prt_bytes(rx,actsize));
+    if( argv[0][0]!='@' ) aocmd_cint_printf(" (%lu us)", (unsigned long)aospi_txrx_us() );
   }
-  Serial.printf(" %s\n",aoresult_to_str(result));
+  aocmd_osp_tele_sent(tx, payloadsize+4);
+  aocmd_cint_printf(" %s\n",aoresult_to_str(result)); // python/libosplink parses "rx none <result>"
 }
 
 
+#if AOCMD_CONFIG_OSP_INFO
 // Returns true iff `cur` is in a new section when compared to `prv`
 // by looking at the prefix.
 static int aocmd_osp_aoresult_newsection(const char * prv, const char * cur) {
-  char * s=strchr(cur,'_');
+  const char * s=strchr(cur,'_');
   if( s==NULL ) return 0; // cur has no prefix so part of "gen", which is in the first section
   if( strncmp(prv,cur,s-cur)==0 ) return 0; // cur has same prefix as prv
   return 1;
@@ -464,10 +1099,10 @@ static void aocmd_osp_aoresult_list(const char * filter, int verbose ) {
     aoresult_t result = (aoresult_t)i;
     const char * cur = aoresult_to_str(result);
     if( strstr(cur,filter) ) {
-      if( *filter=='\0' && aocmd_osp_aoresult_newsection(prv,cur) ) Serial.printf("\n"); 
-      Serial.printf("%3d %-16s", result, aoresult_to_str(result) );
-      if( verbose ) Serial.printf("%s", aoresult_to_str(result,1) );
-      Serial.printf("\n" );
+      if( *filter=='\0' && aocmd_osp_aoresult_newsection(prv,cur) ) aocmd_cint_printf("\n"); 
+      aocmd_cint_printf("%3d %-16s", result, aoresult_to_str(result) );
+      if( verbose ) aocmd_cint_printf("%s", aoresult_to_str(result,1) );
+      aocmd_cint_printf("\n" );
       prv= cur;
     }
   }
@@ -484,7 +1119,7 @@ static void aocmd_osp_aoresult( int argc, char * argv[] ) {
     bool ok= aocmd_cint_parse_dec(argv[2],&val) ;
     if( ok ) { 
       // <filter> is number, is it in aoresult range?
-      if( val<0 || val >=aoresult_numresultcodes ) { Serial.printf("ERROR: <result> out of range (0..%d)\n",aoresult_numresultcodes-1); return; }
+      if( val<0 || val >=aoresult_numresultcodes ) { aocmd_cint_printf("ERROR: <result> out of range (0..%d)\n",aoresult_numresultcodes-1); return; }
       // filter out the selected error
       filter= aoresult_to_str( (aoresult_t)val );
     } else {
@@ -493,9 +1128,10 @@ static void aocmd_osp_aoresult( int argc, char * argv[] ) {
     }
     aocmd_osp_aoresult_list( filter, argv[0][0]!='@' );
   } else {
-    Serial.printf("ERROR: 'aoresult' has too many args\n");
+    aocmd_cint_printf("ERROR: 'aoresult' has too many args\n");
   }
 }
+#endif
 
 
 // Parse 'osp fields <data>...'
@@ -504,52 +1140,52 @@ static void aocmd_osp_fields( int argc, char * argv[] ) {
 
   // get sizes
   int telesize = argc-2;
-  if( telesize> AOSPI_TELE_MAXSIZE ) { Serial.printf("ERROR: too many <data> (max %d)\n",AOSPI_TELE_MAXSIZE); return; }
+  if( telesize> AOSPI_TELE_MAXSIZE ) { aocmd_cint_printf("ERROR: too many <data> (max %d)\n",AOSPI_TELE_MAXSIZE); return; }
 
   int payloadsize = telesize-4;
-  if( payloadsize<0 ) { Serial.printf("ERROR: too few <data> (min 4)\n"); return; }
+  if( payloadsize<0 ) { aocmd_cint_printf("ERROR: too few <data> (min 4)\n"); return; }
   
   // Parse bytes
   for( int tix=0, aix=2; aix<argc; aix++, tix++ ) { // tix index in data[], aix index in argv[]
     uint16_t val;
     bool ok= aocmd_cint_parse_hex(argv[aix],&val) ;
-    if( !ok || val>0xFF ) { Serial.printf("ERROR: '%s' expects <data> 00..FF, not '%s'\n",argv[1], argv[aix]); return; }
+    if( !ok || val>0xFF ) { aocmd_cint_printf("ERROR: '%s' expects <data> 00..FF, not '%s'\n",argv[1], argv[aix]); return; }
     data[tix] = val;
   }
 
   // Print input bytes
   if( argv[0][0]!='@' ) {
-    for( int i=0; i<telesize; i++ ) Serial.printf("+---------------");
-    Serial.printf("+\n");
+    for( int i=0; i<telesize; i++ ) aocmd_cint_printf("+---------------");
+    aocmd_cint_printf("+\n");
     
-    for( int i=0; i<telesize; i++ ) Serial.printf("|      %02X       ",data[i]);
-    Serial.printf("|\n");
+    for( int i=0; i<telesize; i++ ) aocmd_cint_printf("|      %02X       ",data[i]);
+    aocmd_cint_printf("|\n");
     
     for( int i=0; i<telesize; i++ ) {
       char sep='|';
-      for( int b=1<<7; b!=0; b>>=1,sep=' ' ) Serial.printf("%c%d", sep, (data[i]&b)!=0 );
+      for( int b=1<<7; b!=0; b>>=1,sep=' ' ) aocmd_cint_printf("%c%d", sep, (data[i]&b)!=0 );
     }
-    Serial.printf("|\n");
+    aocmd_cint_printf("|\n");
     
-    Serial.printf("+-------+-------+-----------+---+-+-------------");
+    aocmd_cint_printf("+-------+-------+-----------+---+-+-------------");
   } else {
-    Serial.printf("+-------+-------------------+-----+-------------");
+    aocmd_cint_printf("+-------+-------------------+-----+-------------");
   }
   
   // Print field names
-  for( int i=0; i<payloadsize; i++ ) Serial.printf("+---------------");
-  Serial.printf("+---------------");
-  Serial.printf("+\n");
+  for( int i=0; i<payloadsize; i++ ) aocmd_cint_printf("+---------------");
+  aocmd_cint_printf("+---------------");
+  aocmd_cint_printf("+\n");
   
-  Serial.printf("|preambl|      address      | psi |   command   ");
-  for( int i=0; i<payloadsize; i++ ) Serial.printf("|    payload    ");
-  Serial.printf("|      crc      ");
-  Serial.printf("|\n");
+  aocmd_cint_printf("|preambl|      address      | psi |   command   ");
+  for( int i=0; i<payloadsize; i++ ) aocmd_cint_printf("|    payload    ");
+  aocmd_cint_printf("|      crc      ");
+  aocmd_cint_printf("|\n");
   
-  Serial.printf("+-------+-------------------+-----+-------------");
-  for( int i=0; i<payloadsize; i++ ) Serial.printf("+---------------");
-  Serial.printf("+---------------");
-  Serial.printf("+\n");
+  aocmd_cint_printf("+-------+-------------------+-----+-------------");
+  for( int i=0; i<payloadsize; i++ ) aocmd_cint_printf("+---------------");
+  aocmd_cint_printf("+---------------");
+  aocmd_cint_printf("+\n");
 
   // Print field hex
   int preamble = BITS_SLICE(data[0],4,8);
@@ -559,14 +1195,14 @@ static void aocmd_osp_fields( int argc, char * argv[] ) {
   int crc= data[telesize-1];
   int crc2=aoosp_crc(data,telesize-1); 
 
-  Serial.printf("|  0x%1X  ",preamble);
-  Serial.printf("|       0x%03X       ",address);
-  Serial.printf("| 0x%1X ",psi);
-  Serial.printf("|    0x%02X     ",tid);
-  for( int i=0; i<payloadsize; i++ ) Serial.printf("|     0x%02X      ",data[3+i]);
-  if( crc==crc2) Serial.printf("|   0x%02X (ok)   ",crc);
-  else Serial.printf("|0x%02X (ERR) 0x%02X",crc,crc2);
-  Serial.printf("|\n");
+  aocmd_cint_printf("|  0x%1X  ",preamble);
+  aocmd_cint_printf("|       0x%03X       ",address);
+  aocmd_cint_printf("| 0x%1X ",psi);
+  aocmd_cint_printf("|    0x%02X     ",tid);
+  for( int i=0; i<payloadsize; i++ ) aocmd_cint_printf("|     0x%02X      ",data[3+i]);
+  if( crc==crc2) aocmd_cint_printf("|   0x%02X (ok)   ",crc);
+  else aocmd_cint_printf("|0x%02X (ERR) 0x%02X",crc,crc2);
+  aocmd_cint_printf("|\n");
   
   // Print field meaning
   #define BUFSIZE 13
@@ -582,32 +1218,32 @@ static void aocmd_osp_fields( int argc, char * argv[] ) {
   }
   int command_len = strlen(command_buf);
   
-  Serial.printf("|   -   ");
-  if( AOOSP_ADDR_ISBROADCAST(address) ) Serial.printf("|     broadcast     "); 
-  else if( AOOSP_ADDR_ISUNICAST(address) && address<10  ) Serial.printf("|    unicast(%1d)     ",address); 
-  else if( AOOSP_ADDR_ISUNICAST(address) && address<100 ) Serial.printf("|    unicast(%2d)    ",address); 
-  else if( AOOSP_ADDR_ISUNICAST(address) && address<1000) Serial.printf("|    unicast(%3d)   ",address); 
-  else if( AOOSP_ADDR_ISUNICAST(address)                ) Serial.printf("|    unicast(%4d)   ",address); 
-  else if( AOOSP_ADDR_ISUNICAST(address) && address  ) Serial.printf("|   unicast(%4d)   ",address); 
-  else if( OAOSP_ADDR_ISMULTICAST(address) ) Serial.printf("|   groupcast(%1X)    ",address-AOOSP_ADDR_GROUP0); 
-  else Serial.printf("|       error       "); 
-  if( psi<5  ) Serial.printf("|  %d  ",psi);
-  else if( psi==5 ) Serial.printf("| rsv ");
-  else if( psi==6 ) Serial.printf("|  6  ");
-  else if( psi==7 ) Serial.printf("|  8  ");
-  else Serial.printf("| err ");
-  Serial.printf("|%*s%s%*s",(13-command_len)/2,"",command_buf,(12-command_len)/2,"");
-  if( aocmd_osp_tidmap[tid].num<2 ) Serial.printf(" "); else Serial.printf("%d",aocmd_osp_tidmap[tid].num);
-  for( int i=0; i<payloadsize; i++ ) Serial.printf("|      %3d      ",data[3+i]);
-  if( crc==crc2 ) Serial.printf("|    %3d (ok)   ",crc);
-  else Serial.printf("| %3d (ERR)  %3d",crc,crc2);
-  Serial.printf("|\n");
+  aocmd_cint_printf("|   -   ");
+  if( AOOSP_ADDR_ISBROADCAST(address) ) aocmd_cint_printf("|     broadcast     "); 
+  else if( AOOSP_ADDR_ISUNICAST(address) && address<10  ) aocmd_cint_printf("|    unicast(%1d)     ",address); 
+  else if( AOOSP_ADDR_ISUNICAST(address) && address<100 ) aocmd_cint_printf("|    unicast(%2d)    ",address); 
+  else if( AOOSP_ADDR_ISUNICAST(address) && address<1000) aocmd_cint_printf("|    unicast(%3d)   ",address); 
+  else if( AOOSP_ADDR_ISUNICAST(address)                ) aocmd_cint_printf("|    unicast(%4d)   ",address); 
+  else if( AOOSP_ADDR_ISUNICAST(address) && address  ) aocmd_cint_printf("|   unicast(%4d)   ",address); 
+  else if( OAOSP_ADDR_ISMULTICAST(address) ) aocmd_cint_printf("|   groupcast(%1X)    ",address-AOOSP_ADDR_GROUP0); 
+  else aocmd_cint_printf("|       error       "); 
+  if( psi<5  ) aocmd_cint_printf("|  %d  ",psi);
+  else if( psi==5 ) aocmd_cint_printf("| rsv ");
+  else if( psi==6 ) aocmd_cint_printf("|  6  ");
+  else if( psi==7 ) aocmd_cint_printf("|  8  ");
+  else aocmd_cint_printf("| err ");
+  aocmd_cint_printf("|%*s%s%*s",(13-command_len)/2,"",command_buf,(12-command_len)/2,"");
+  if( aocmd_osp_tidmap[tid].num<2 ) aocmd_cint_printf(" "); else aocmd_cint_printf("%d",aocmd_osp_tidmap[tid].num);
+  for( int i=0; i<payloadsize; i++ ) aocmd_cint_printf("|      %3d      ",data[3+i]);
+  if( crc==crc2 ) aocmd_cint_printf("|    %3d (ok)   ",crc);
+  else aocmd_cint_printf("| %3d (ERR)  %3d",crc,crc2);
+  aocmd_cint_printf("|\n");
   
   // Terminate table
-  Serial.printf("+-------+-------------------+-----+-------------");
-  for( int i=0; i<payloadsize; i++ ) Serial.printf("+---------------");
-  Serial.printf("+---------------");
-  Serial.printf("+\n");
+  aocmd_cint_printf("+-------+-------------------+-----+-------------");
+  for( int i=0; i<payloadsize; i++ ) aocmd_cint_printf("+---------------");
+  aocmd_cint_printf("+---------------");
+  aocmd_cint_printf("+\n");
 }
 
 
@@ -615,7 +1251,7 @@ static void aocmd_osp_fields( int argc, char * argv[] ) {
 static void aocmd_osp_trx( int argc, char * argv[] ) {
   uint8_t tx[AOSPI_TELE_MAXSIZE];
 
-  if( argc-2> AOSPI_TELE_MAXSIZE ) { Serial.printf("ERROR: too many <data> (max %d)\n",AOSPI_TELE_MAXSIZE); return; }
+  if( argc-2> AOSPI_TELE_MAXSIZE ) { aocmd_cint_printf("ERROR: too many <data> (max %d)\n",AOSPI_TELE_MAXSIZE); return; }
   
   for( int tix=0, aix=2; aix<argc; aix++, tix++ ) { // tix index in tx[], aix index in argv[]
     if( aix==argc-1 && aocmd_cint_isprefix("crc",argv[aix]) ) {
@@ -623,103 +1259,279 @@ static void aocmd_osp_trx( int argc, char * argv[] ) {
     } else {
       uint16_t data;
       bool ok= aocmd_cint_parse_hex(argv[aix],&data) ;
-      if( !ok || data>0xFF ) { Serial.printf("ERROR: '%s' expects <data> 00..FF, not '%s'\n",argv[1], argv[aix]); return; }
+      if( !ok || data>0xFF ) { aocmd_cint_printf("ERROR: '%s' expects <data> 00..FF, not '%s'\n",argv[1], argv[aix]); return; }
       tx[tix] = data;
     }
   }
   int telesize = argc-2;
-  int payloadsize = telesize-4;
 
   // Validation
   if( oacmd_osp_validate ) {
-    if( payloadsize<0 ) {
-      Serial.printf("validate: minimal telegram length is 4 bytes (other validation skipped)\n");
-    } else {
-      // dissect bytes
-      int preamble = BITS_SLICE(tx[0],4,8);
-      int addr= (BITS_SLICE(tx[0],0,4)<<6) + BITS_SLICE(tx[1],2,8);
-      int psi= (BITS_SLICE(tx[1],0,2)<<1) + BITS_SLICE(tx[2],7,8);
-      int tid= BITS_SLICE(tx[2],0,7);
-      // try to get info (find variant)
-      const aocmd_osp_variant_t * var = 0;
-      for( int vix=aocmd_osp_tidmap[tid].vix; vix<aocmd_osp_tidmap[tid].vix+aocmd_osp_tidmap[tid].num; vix++ ) {
-        if( aocmd_osp_variant[vix].sizemask & (1<<payloadsize) )
-          var= &aocmd_osp_variant[vix];
-      }
-      if( var==0 ) var= &aocmd_osp_variant[aocmd_osp_tidmap[tid].vix]; // None fits; just pick first
-      // correct subcommand
-      if( AOCMD_OSP_VARIANT_HAS_INFO(var) ) {
-        if( argv[1][1]=='r' ) { // command "osp trx" (tx and rx)
-          if( ! AOCMD_OSP_VARIANT_HAS_RESPONSE(var) ) Serial.printf("validate: a receive command is given, but %02X/%s has no response\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-        } else { // command "osp tx" (tx only)
-          if( AOCMD_OSP_VARIANT_HAS_RESPONSE(var) ) Serial.printf("validate: %02X/%s triggers response, but a tx only command is given\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-        }
-      }
-      // preamble
-      if( preamble!=0xA ) Serial.printf("validate: first nibble should be preamble (0xA)\n");
-      // addr
-      if( ! AOOSP_ADDR_ISOK(addr) ) Serial.printf("validate: illegal addr %03X\n",addr);
-      if( AOCMD_OSP_VARIANT_HAS_INFO(var) && AOOSP_ADDR_ISBROADCAST(addr) && !AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var) ) Serial.printf("validate: %02X/%s does not support broadcast\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-      if( AOCMD_OSP_VARIANT_HAS_INFO(var) && OAOSP_ADDR_ISMULTICAST(addr) && !AOCMD_OSP_VARIANT_HAS_BROADMULTICAST(var) ) Serial.printf("validate: %02X/%s does not support multicast\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-      // psi (payloadsize)
-      if( AOCMD_OSP_VARIANT_HAS_INFO(var) && !( var->sizemask & (1<<payloadsize) ) ) {
-        Serial.printf("validate: %02X/%s does not have %d bytes as payload, but",var->tid,AOCMD_OSP_SWNAME(var->swname),payloadsize );
-        const char * sep=" ";
-        for( int vix=aocmd_osp_tidmap[tid].vix; vix<aocmd_osp_tidmap[tid].vix+aocmd_osp_tidmap[tid].num; vix++ ) {
-          Serial.printf("%s%s", sep, aocmd_osp_sizemask_str(aocmd_osp_variant[vix].sizemask) );
-          sep=" or ";
-        }
-        Serial.printf(".\n");
-      }
-      if( payloadsize<0 || payloadsize>8 || payloadsize==5 || payloadsize==7 ) Serial.printf("validate: illegal payload size %d (allowed is 0,1,2,3,4,6,8)\n", payloadsize);
-      else if( PSI(payloadsize)!=psi  ) Serial.printf("validate: payload is %d bytes so psi should be %d but is %d \n", payloadsize,PSI(payloadsize),psi);
-      // tid
-      if( ! AOCMD_OSP_VARIANT_HAS_INFO(var) ) Serial.printf("validate: no info on %02X/%s to validate against\n",var->tid,AOCMD_OSP_SWNAME(var->swname));
-      // crc
-      if( aoosp_crc(tx,telesize-1)!=tx[telesize-1] ) Serial.printf("validate: crc %02X is incorrect (should be %02X)\n",tx[telesize-1],aoosp_crc(tx,telesize-1));
-      // Extra check for init (to be aligned with dirmux)
-      if( tx[2]==2 && aospi_dirmux_is_loop()  ) Serial.printf("validate: 02/initbidir with dirmux in loop\n");
-      if( tx[2]==3 && aospi_dirmux_is_bidir() ) Serial.printf("validate: 03/initloop with dirmux in bidir\n");
-    }
+    int mode = argv[1][1]=='r' ? AOCMD_OSP_VALIDATE_TRX : AOCMD_OSP_VALIDATE_TX;
+    uint16_t issues = aocmd_osp_validate_tele(tx, telesize, mode, aospi_dirmux_is_loop(), 0 );
+    if( issues ) aocmd_osp_validate_print(issues, tx, telesize, 0);
   }
 
-  if( argv[0][0]!='@' ) Serial.printf("tx %s\n", aoosp_prt_bytes(tx,telesize) );
+  if( argv[0][0]!='@' ) aocmd_cint_printf("tx %s\n", aoosp_prt_bytes(tx,telesize) );
 
   // Execute
   uint8_t rx[AOSPI_TELE_MAXSIZE];
   memset(rx,0xA5,AOSPI_TELE_MAXSIZE);
   aoresult_t result;
+  uint32_t us = micros();
   if( argv[1][1]=='r' ) { // command "osp trx"
     int actsize;
     result = aospi_txrx(tx, telesize, rx, AOSPI_TELE_MAXSIZE, &actsize);
-    Serial.printf("rx %s",aoosp_prt_bytes(rx,actsize));
-    if( argv[0][0]!='@' ) Serial.printf(" (%ld us)", aospi_txrx_us() );
+    aocmd_osp_rec_add(us, tx, telesize, 1, rx, actsize, result);
+    aocmd_cint_printf("rx %s",aoosp_prt_bytes(rx,actsize));
+    if( argv[0][0]!='@' ) aocmd_cint_printf(" (%lu us)", (unsigned long)aospi_txrx_us() );
   } else { // command "osp tx"
     result = aospi_tx(tx, telesize);
-    Serial.printf("rx none");
+    aocmd_osp_rec_add(us, tx, telesize, 0, rx, 0, result);
+    aocmd_cint_printf("rx none");
+  }
+  aocmd_osp_tele_sent(tx, telesize);
+  aocmd_cint_printf(" %s\n",aoresult_to_str(result));
+}
+
+
+// Show recording status
+static void aocmd_osp_record_show() {
+  aocmd_cint_printf("record: %s, %d telegrams, %d/%d bytes%s\n", aocmd_osp_rec_active ? "on" : "off", 
+    aocmd_osp_rec_count, aocmd_osp_rec_len, AOCMD_OSP_REC_SIZE, aocmd_osp_rec_overflow ? " (full)" : "" );
+}
+
+
+// Parse 'osp record [ start | stop | list ]'
+static void aocmd_osp_record( int argc, char * argv[] ) {
+  if( argc==2 ) { aocmd_osp_rec_load(); aocmd_osp_record_show(); return; }
+  if( argc!=3 ) { aocmd_cint_printf("ERROR: 'record' has too many args\n"); return; }
+  if( aocmd_cint_isprefix("start",argv[2]) ) {
+    aocmd_osp_rec_len= 0;
+    aocmd_osp_rec_count= 0;
+    aocmd_osp_rec_overflow= 0;
+    aocmd_osp_rec_active= 1;
+  } else if( aocmd_cint_isprefix("stop",argv[2]) ) {
+    aocmd_osp_rec_active= 0;
+    if( !aocmd_osp_rec_save() ) aocmd_cint_printf("ERROR: 'record' could not persist recording\n");
+  } else if( aocmd_cint_isprefix("list",argv[2]) ) {
+    aocmd_osp_rec_load();
+    int pos = 0;
+    int index = 0;
+    aocmd_osp_rec_entry_t entry;
+    while( aocmd_osp_rec_next(&pos,&entry) ) {
+      aocmd_cint_printf("%3d +%luus tx %s", index++, (unsigned long)entry.dt, aoosp_prt_bytes(entry.tx,entry.txsize) );
+      if( entry.hasrx ) aocmd_cint_printf(" rx %s", aoosp_prt_bytes(entry.rx,entry.rxsize) ); else aocmd_cint_printf(" rx none");
+      aocmd_cint_printf(" %s\n", aoresult_to_str(entry.result) );
+    }
+    return;
+  } else {
+    aocmd_cint_printf("ERROR: 'record' expects 'start', 'stop' or 'list', not '%s'\n", argv[2]); return;
+  }
+  if( argv[0][0]!='@' ) aocmd_osp_record_show();
+}
+
+
+// Parse 'osp replay [ <speed> [ <maxgap> ] ]'
+static void aocmd_osp_replay( int argc, char * argv[] ) {
+  if( argc>4 ) { aocmd_cint_printf("ERROR: 'replay' has too many args\n"); return; }
+  int speed = 1;
+  if( argc>=3 && (!aocmd_cint_parse_dec(argv[2],&speed) || speed<0) ) { aocmd_cint_printf("ERROR: 'replay' expects <speed> 0, 1, 2, ..., not '%s'\n", argv[2]); return; }
+  int maxgap = AOCMD_OSP_REC_MAXGAPMS;
+  if( argc==4 && (!aocmd_cint_parse_dec(argv[3],&maxgap) || maxgap<0 || maxgap>AOCMD_OSP_REC_MAXMAXGAP) ) { aocmd_cint_printf("ERROR: 'replay' expects <maxgap> 0..%d, not '%s'\n", AOCMD_OSP_REC_MAXMAXGAP, argv[3]); return; }
+  if( aocmd_osp_rec_active ) { aocmd_cint_printf("ERROR: 'replay' not possible while recording\n"); return; }
+  aocmd_osp_rec_load();
+  if( aocmd_osp_rec_count==0 ) { aocmd_cint_printf("ERROR: 'replay' has no recorded telegrams\n"); return; }
+
+  int pos = 0;
+  int index = 0;
+  int diffs = 0;
+  aocmd_osp_rec_entry_t entry;
+  uint8_t rx[AOSPI_TELE_MAXSIZE];
+  bool aborted = false;
+  uint32_t start = micros();
+  uint32_t due = start; // time when the next telegram should be sent
+  while( !aborted && aocmd_osp_rec_next(&pos,&entry) ) {
+    // Wait (speed 0 means no waiting, otherwise recorded time divided by speed, capped at maxgap)
+    // The recorded time includes the think time of the operator between commands, hence the cap.
+    // A key press (on Serial) aborts the replay.
+    if( speed>0 ) {
+      uint32_t gap = entry.dt/speed;
+      if( gap>(uint32_t)maxgap*1000 ) gap= (uint32_t)maxgap*1000;
+      due += gap;
+      if( (int32_t)(due-micros())<0 ) due= micros(); // sending was slower than recording: don't try to catch up
+      while( (int32_t)(due-micros())>0 ) { 
+        if( Serial.available() ) { while( Serial.available() ) Serial.read(); aborted= true; break; }
+        yield(); 
+      }
+      if( aborted ) break;
+    }
+    // Send
+    aoresult_t result;
+    int actsize = 0;
+    if( entry.hasrx ) {
+      memset(rx,0xA5,AOSPI_TELE_MAXSIZE);
+      int rxsize = entry.rxsize>0 ? entry.rxsize : AOSPI_TELE_MAXSIZE; // expect same response size as recorded
+      result = aospi_txrx(entry.tx, entry.txsize, rx, rxsize, &actsize);
+    } else {
+      result = aospi_tx(entry.tx, entry.txsize);
+    }
+    aocmd_osp_tele_sent(entry.tx, entry.txsize);
+    // Compare with recording
+    bool diff = result!=entry.result || actsize!=entry.rxsize || memcmp(rx,entry.rx,actsize)!=0;
+    if( diff ) {
+      diffs++;
+      if( argv[0][0]!='@' ) {
+        aocmd_cint_printf("%3d tx %s\n", index, aoosp_prt_bytes(entry.tx,entry.txsize) );
+        aocmd_cint_printf("    was %s %s\n", entry.hasrx ? aoosp_prt_bytes(entry.rx,entry.rxsize) : "none", aoresult_to_str(entry.result) );
+        aocmd_cint_printf("    now %s %s\n", entry.hasrx ? aoosp_prt_bytes(rx,actsize) : "none", aoresult_to_str(result) );
+      }
+    }
+    index++;
+  }
+  uint32_t us = micros()-start;
+  aocmd_cint_printf("replay: %d telegrams, %d diffs, %lu us", index, diffs, (unsigned long)us );
+  if( aborted ) aocmd_cint_printf(" (aborted by key)");
+  if( us>0 ) aocmd_cint_printf(" (%lu telegrams/s)", (unsigned long)(1000000ULL*index/us) );
+  aocmd_cint_printf("\n");
+}
+
+
+// Show monitor status
+static void aocmd_osp_monitor_show() {
+  aocmd_cint_printf("monitor: %s, interval %lu ms (%lu..%lu), tlimit %02X\n", aocmd_osp_mon_enabled ? "on" : "off",
+    (unsigned long)aocmd_osp_mon_intervalms, (unsigned long)aocmd_osp_mon_minms, (unsigned long)aocmd_osp_mon_maxms, aocmd_osp_mon_tlimit );
+  aocmd_cint_printf("monitor: polls %d yields %d fails %d errors %d hots %d\n", 
+    aocmd_osp_mon.polls, aocmd_osp_mon.yields, aocmd_osp_mon.fails, aocmd_osp_mon.errors, aocmd_osp_mon.hots );
+  aocmd_cint_printf("monitor: p4err %03X temp %02X stat %02X, tinfo max %02X min %02X, vinfo max %02X min %02X\n",
+    aocmd_osp_mon.erraddr, aocmd_osp_mon.errtemp, aocmd_osp_mon.errstat, 
+    aocmd_osp_mon.tmax, aocmd_osp_mon.tmin, aocmd_osp_mon.vmax, aocmd_osp_mon.vmin );
+}
+
+
+// Parse 'osp monitor [ on | off | reset | interval <min> <max> | tlimit <temp> ]'
+static void aocmd_osp_monitor( int argc, char * argv[] ) {
+  if( argc==2 ) { aocmd_osp_monitor_show(); return; }
+  if( aocmd_cint_isprefix("on",argv[2]) && argc==3 ) {
+    aocmd_osp_mon_enabled = 1;
+    aocmd_osp_mon_intervalms = aocmd_osp_mon_minms;
+    aocmd_osp_mon_infail = 0;
+    aocmd_osp_mon_txcount = aospi_txcount_get();
+  } else if( aocmd_cint_isprefix("off",argv[2]) && argc==3 ) {
+    aocmd_osp_mon_enabled = 0;
+  } else if( aocmd_cint_isprefix("reset",argv[2]) && argc==3 ) {
+    memset( &aocmd_osp_mon, 0, sizeof aocmd_osp_mon );
+  } else if( aocmd_cint_isprefix("interval",argv[2]) ) {
+    int minms, maxms;
+    if( argc!=5 ) { aocmd_cint_printf("ERROR: 'monitor interval' expects <min> <max>\n"); return; }
+    if( !aocmd_cint_parse_dec(argv[3],&minms) || minms<1 ) { aocmd_cint_printf("ERROR: 'monitor interval' expects <min> (ms), not '%s'\n",argv[3]); return; }
+    if( !aocmd_cint_parse_dec(argv[4],&maxms) || maxms<minms ) { aocmd_cint_printf("ERROR: 'monitor interval' expects <max> (ms) at least <min>, not '%s'\n",argv[4]); return; }
+    aocmd_osp_mon_minms = minms;
+    aocmd_osp_mon_maxms = maxms;
+    aocmd_osp_mon_intervalms = minms;
+  } else if( aocmd_cint_isprefix("tlimit",argv[2]) ) {
+    uint16_t tlimit;
+    if( argc!=4 ) { aocmd_cint_printf("ERROR: 'monitor tlimit' expects <temp>\n"); return; }
+    if( !aocmd_cint_parse_hex(argv[3],&tlimit) || tlimit>0xFF ) { aocmd_cint_printf("ERROR: 'monitor tlimit' expects <temp> 00..FF, not '%s'\n",argv[3]); return; }
+    aocmd_osp_mon_tlimit = tlimit;
+  } else {
+    aocmd_cint_printf("ERROR: 'monitor' expects 'on', 'off', 'reset', 'interval' or 'tlimit', ");
+    aocmd_cint_printf("not '%s'\n", argv[2]); return;
+  }
+  if( argv[0][0]!='@' ) aocmd_osp_monitor_show();
+}
+
+
+// Sends telegram tid without payload (p4err, asktinfo, readtempstat) to addr, response in rx[3..4]; increments *count
+static aoresult_t aocmd_osp_locate_txrx( uint16_t addr, int tid, uint8_t * rx, int * count ) {
+  uint8_t tx[AOSPI_TELE_MAXSIZE];
+  int txsize = aocmd_osp_tele_frame(tx, addr, tid, 0);
+  (*count)++;
+  return aospi_txrx(tx, txsize, rx, 4+2);
+}
+
+
+// Parse 'osp locate (error | temp <temp>)'
+// One serial cast telegram from 001 checks the whole chain. For 'error' that is p4err: the first 
+// node with an error answers, so that one telegram also locates it. For 'temp' that is asktinfo, 
+// which only gives the max temperature over the chain; when it is at or above the limit, the
+// nodes are probed one by one with unicast readtempstat (O(n) telegrams, only for a hot chain).
+static void aocmd_osp_locate( int argc, char * argv[] ) {
+  if( argc<3 ) { aocmd_cint_printf("ERROR: 'locate' expects 'error' or 'temp'\n"); return; }
+  int   doerror = aocmd_cint_isprefix("error",argv[2]);
+  uint16_t tlimit = 0;
+  if( doerror ) {
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'locate error' has too many args\n"); return; }
+  } else if( aocmd_cint_isprefix("temp",argv[2]) ) {
+    if( argc!=4 ) { aocmd_cint_printf("ERROR: 'locate temp' expects <temp>\n"); return; }
+    if( !aocmd_cint_parse_hex(argv[3],&tlimit) || tlimit>0xFF ) { aocmd_cint_printf("ERROR: 'locate temp' expects <temp> 00..FF, not '%s'\n",argv[3]); return; }
+  } else {
+    aocmd_cint_printf("ERROR: 'locate' expects 'error' or 'temp', not '%s'\n", argv[2]); return;
+  }
+  uint16_t last = aoosp_exec_resetinit_last();
+  if( last==0 ) { aocmd_cint_printf("ERROR: 'locate' needs an initialized chain (run 'osp resetinit')\n"); return; }
+
+  uint8_t    rx[AOSPI_TELE_MAXSIZE];
+  aoresult_t result;
+  int        count = 0;
+  int        found = 0;
+  uint32_t   us = micros();
+  // Check whole chain with one serial cast telegram; get first node to probe
+  uint16_t   first = 0; // first node to probe (temp only); 0 means no probing
+  if( doerror ) {
+    int tid = aospi_dirmux_is_loop() ? 0x09 : 0x08; // p4errloop or p4errbidir
+    result = aocmd_osp_locate_txrx(AOOSP_ADDR_UNICASTMIN, tid, rx, &count);
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: locate failed (%s)\n", aoresult_to_str(result) ); return; }
+    uint16_t node = aocmd_osp_tele_addr(rx);
+    if( AOOSP_ADDR_ISUNICAST(node) && node<=last && aocmd_osp_stat_errors(node, rx[4], &count)!=0 ) {
+      if( argv[0][0]!='@' ) aocmd_cint_printf("locate: error at %03X (temp %02X stat %02X)\n", node, rx[3], rx[4]);
+      found++;
+    }
+  } else {
+    result = aocmd_osp_locate_txrx(AOOSP_ADDR_UNICASTMIN, 0x0A, rx, &count); // asktinfo
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: locate failed (%s)\n", aoresult_to_str(result) ); return; }
+    if( rx[3]>=tlimit ) first = AOOSP_ADDR_UNICASTMIN;
+  }
+  // Probe the nodes one by one
+  for( uint16_t addr=first; first!=0 && addr<=last; addr++ ) {
+    result = aocmd_osp_locate_txrx(addr, 0x42, rx, &count); // readtempstat
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: locate failed at %03X (%s)\n", addr, aoresult_to_str(result) ); return; }
+    if( rx[3]<tlimit ) continue;
+    if( argv[0][0]!='@' ) aocmd_cint_printf("locate: temp at %03X is %02X (at or above %02X)\n", addr, rx[3], tlimit);
+    found++;
+  }
+  us = micros() - us;
+  if( argv[0][0]!='@' ) {
+    if( found==0 ) aocmd_cint_printf("locate: no node found\n");
+    aocmd_cint_printf("locate: %d telegrams, %lu us (chain of %d nodes)\n", count, (unsigned long)us, last);
   }
-  Serial.printf(" %s\n",aoresult_to_str(result));
 }
 
 
 // Parse 'osp resetinit'
 static void aocmd_osp_resetinit( int argc, char * argv[] ) {
-  if( argc!=2 ) { Serial.printf("ERROR: 'resetinit' has too many args\n"); return; }
+  if( argc!=2 ) { aocmd_cint_printf("ERROR: 'resetinit' has too many args\n"); return; }
 
   uint16_t last; int loop;
   aoresult_t result = aoosp_exec_resetinit(&last,&loop);
-  if(result!=aoresult_ok) { Serial.printf("ERROR: resetinit failed (%s)\n", aoresult_to_str(result) ); return; }
-  if( argv[0][0]!='@' ) Serial.printf("resetinit: %s %03X (%s)\n", (loop?"loop":"bidir"), last, aoresult_to_str(result) );
+  aocmd_said_otp_cache_invalidate(0);
+  aocmd_osp_stat_idaddr= 0;
+  if(result!=aoresult_ok) { aocmd_cint_printf("ERROR: resetinit failed (%s)\n", aoresult_to_str(result) ); return; }
+  if( argv[0][0]!='@' ) aocmd_cint_printf("resetinit: %s %03X (%s)\n", (loop?"loop":"bidir"), last, aoresult_to_str(result) ); // parsed by python/libosplink
+  aocmd_said_i2c_freq_restore(); // the reset cleared the speeds tuned with 'said i2c <addr> freq auto' (prints errors)
 }
 
 
 // Parse 'osp enum'
 static void aocmd_osp_enum( int argc, char * argv[] ) {
-  if( argc!=2 ) { Serial.printf("ERROR: 'enum' has too many args\n"); return; }
+  if( argc!=2 ) { aocmd_cint_printf("ERROR: 'enum' has too many args\n"); return; }
 
   uint16_t last; int loop;
   aoresult_t result = aoosp_exec_resetinit(&last,&loop);
-  if(result!=aoresult_ok) { Serial.printf("ERROR: resetinit failed (%s)\n", aoresult_to_str(result) ); return; }
+  aocmd_said_otp_cache_invalidate(0);
+  aocmd_osp_stat_idaddr= 0;
+  if(result!=aoresult_ok) { aocmd_cint_printf("ERROR: resetinit failed (%s)\n", aoresult_to_str(result) ); return; }
+  aocmd_said_i2c_freq_restore(); // the reset cleared the speeds tuned with 'said i2c <addr> freq auto' (prints errors)
   
   // Scan all OSP nodes
   int triplets=0;
@@ -730,56 +1542,56 @@ static void aocmd_osp_enum( int argc, char * argv[] ) {
     // Print sio1 comm
     uint8_t  com;
     result = aoosp_send_readcomst(addr, &com );
-    if( result!=aoresult_ok ) { Serial.printf("comst %s\n", aoresult_to_str(result) ); break; }
-    Serial.printf("%4s", aoosp_prt_com_sio1(com) );
+    if( result!=aoresult_ok ) { aocmd_cint_printf("comst %s\n", aoresult_to_str(result) ); break; }
+    aocmd_cint_printf("%4s", aoosp_prt_com_sio1(com) );
     // Print addr and id
     uint32_t id;
     result = aoosp_send_identify(addr, &id );
-    if( result!=aoresult_ok ) { Serial.printf("ERROR: aoosp_send_identify(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
-    Serial.printf(" N%03X %08lX",addr,id);
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: aoosp_send_identify(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+    aocmd_cint_printf(" N%03X %08lX",addr,(unsigned long)id);
     // Print name
     if( AOOSP_IDENTIFY_IS_SAID(id) ) {
       num_said++;
-      Serial.printf("/SAID T%d T%d", triplets, triplets+1);
+      aocmd_cint_printf("/SAID T%d T%d", triplets, triplets+1);
       // Is this SAID having I2C bridge enabled?
       int enable;
       result = aoosp_exec_i2cenable_get(addr, &enable);
-      if(result!=aoresult_ok) { Serial.printf("ERROR: aoosp_exec_i2cenable_get(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+      if(result!=aoresult_ok) { aocmd_cint_printf("ERROR: aoosp_exec_i2cenable_get(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
       if( enable ) {
-        Serial.printf(" I%d", i2cbridges); 
+        aocmd_cint_printf(" I%d", i2cbridges); 
         triplets+=2; 
         i2cbridges+=1;
       } else {
-        Serial.printf(" T%d", triplets+2);
+        aocmd_cint_printf(" T%d", triplets+2);
         triplets+=3;
       }
     } else if( AOOSP_IDENTIFY_IS_RGBI(id) ) {
       num_rgbi++;
-      Serial.printf("/RGBI T%d", triplets);
+      aocmd_cint_printf("/RGBI T%d", triplets);
       triplets += 1;
     } else {
-      Serial.printf("/OTHER");
+      aocmd_cint_printf("/OTHER");
     }
-    Serial.printf(" %s", aoosp_prt_com_sio2(com) );
-    Serial.printf("\n");
+    aocmd_cint_printf(" %s", aoosp_prt_com_sio2(com) );
+    aocmd_cint_printf("\n");
   }
   // summary
-  Serial.printf("nodes(N) 1..%d, ", last );
-  Serial.printf("triplets(T) 0..%d, ", triplets-1 );
+  aocmd_cint_printf("nodes(N) 1..%d, ", last );
+  aocmd_cint_printf("triplets(T) 0..%d, ", triplets-1 );
   if( i2cbridges == 0 ) 
-    Serial.printf("i2cbridges(I) none, " );
+    aocmd_cint_printf("i2cbridges(I) none, " );
   else
-    Serial.printf("i2cbridges(I) 0..%d, ", i2cbridges-1 );
-  Serial.printf("dir %s\n", loop?"loop":"bidir");
+    aocmd_cint_printf("i2cbridges(I) 0..%d, ", i2cbridges-1 );
+  aocmd_cint_printf("dir %s\n", loop?"loop":"bidir");
   // Print count summary
-  Serial.printf("count rgbi %d said %d\n", num_rgbi, num_said);
+  aocmd_cint_printf("count rgbi %d said %d\n", num_rgbi, num_said);
   // Print power summary
   int said_50mA= num_rgbi*3;
   int said_ch0_48mA= num_said*3;
   int said_ch1_24mA= num_said*3;
   int said_ch2_24mA= (num_said-i2cbridges)*3;
   int cur_mA= said_50mA*50 + said_ch0_48mA*48 + said_ch1_24mA*24 + said_ch2_24mA*24;
-  Serial.printf("maxpower %dx50mA + %dx48mA + %dx24mA + %dx24mA = %.3fA (%.3fW)\n", 
+  aocmd_cint_printf("maxpower %dx50mA + %dx48mA + %dx24mA + %dx24mA = %.3fA (%.3fW)\n", 
     said_50mA, said_ch0_48mA, said_ch1_24mA , said_ch2_24mA,
     cur_mA/1000.0, 5.0*cur_mA/1000.0);
 }
@@ -791,73 +1603,92 @@ static void aocmd_osp_main( int argc, char * argv[] ) {
   if( argc==1 ) {
     aocmd_osp_dirmux_show();
     aocmd_osp_validate_show();
+    aocmd_osp_format_show();
     aocmd_osp_count_show();
     aocmd_osp_log_show(); 
   } else if( aocmd_cint_isprefix("dirmux",argv[1]) ) {
     if( argc==2 ) { aocmd_osp_dirmux_show(); return; }
-    if( argc!=3 ) { Serial.printf("ERROR: 'dirmux' has too many args\n"); return; }
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'dirmux' has too many args\n"); return; }
     if( aocmd_cint_isprefix("bidir",argv[2]) ) aospi_dirmux_set_bidir();
     else if( aocmd_cint_isprefix("loop",argv[2]) ) aospi_dirmux_set_loop();
-    else { Serial.printf("ERROR: 'dirmux' expects 'bidir' or 'loop', not '%s'\n", argv[2]); return; }
+    else { aocmd_cint_printf("ERROR: 'dirmux' expects 'bidir' or 'loop', not '%s'\n", argv[2]); return; }
     if( argv[0][0]!='@' ) aocmd_osp_dirmux_show();
   } else if( aocmd_cint_isprefix("validate",argv[1]) ) {
     if( argc==2 ) { aocmd_osp_validate_show(); return; }
-    if( argc!=3 ) { Serial.printf("ERROR: 'validate' has too many args\n"); return; }
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'validate' has too many args\n"); return; }
     if( aocmd_cint_isprefix("enable",argv[2]) ) oacmd_osp_validate=1;
     else if( aocmd_cint_isprefix("disable",argv[2]) ) oacmd_osp_validate=0;
-    else { Serial.printf("ERROR: 'validate' expects 'enable' or 'disable', not '%s'\n",argv[2]); return; }
+    else { aocmd_cint_printf("ERROR: 'validate' expects 'enable' or 'disable', not '%s'\n",argv[2]); return; }
     if( argv[0][0]!='@' ) aocmd_osp_validate_show();
   } else if( aocmd_cint_isprefix("hwtest",argv[1]) ) {
     if( argc==2 ) { aocmd_osp_hwtestout_show(); aocmd_osp_hwtestin_show(); return; }
-    if( argc>4 ) { Serial.printf("ERROR: 'hwtest' has too many args\n"); return; }
+    if( argc>4 ) { aocmd_cint_printf("ERROR: 'hwtest' has too many args\n"); return; }
     if( aocmd_cint_isprefix("out",argv[2]) ) {
       if( argc==3 ) { aocmd_osp_hwtestout_show(); return; }
       if( aocmd_cint_isprefix("enable",argv[3]) ) aospi_outoena_set(HIGH);
       else if( aocmd_cint_isprefix("disable",argv[3]) ) aospi_outoena_set(LOW);
-      else { Serial.printf("ERROR: 'hwtest out' expects 'enable' or 'disable', not '%s'\n",argv[3]); return; }
+      else { aocmd_cint_printf("ERROR: 'hwtest out' expects 'enable' or 'disable', not '%s'\n",argv[3]); return; }
       if( argv[0][0]!='@' ) aocmd_osp_hwtestout_show();
     } else if( aocmd_cint_isprefix("in",argv[2]) ) {
       if( argc==3 ) { aocmd_osp_hwtestin_show(); return; }
       if( aocmd_cint_isprefix("enable",argv[3]) ) aospi_inoena_set(HIGH);
       else if( aocmd_cint_isprefix("disable",argv[3]) ) aospi_inoena_set(LOW);
-      else { Serial.printf("ERROR: 'hwtest in' expects 'enable' or 'disable', not '%s'\n",argv[3]); return; }
+      else { aocmd_cint_printf("ERROR: 'hwtest in' expects 'enable' or 'disable', not '%s'\n",argv[3]); return; }
       if( argv[0][0]!='@' ) aocmd_osp_hwtestin_show();
-    } else { Serial.printf("ERROR: 'hwtest' expects 'out' or 'in', not '%s'\n", argv[2]); return; }
+    } else { aocmd_cint_printf("ERROR: 'hwtest' expects 'out' or 'in', not '%s'\n", argv[2]); return; }
   } else if( aocmd_cint_isprefix("count",argv[1]) ) {
     if( argc==2 ) { aocmd_osp_count_show(); return; }
-    if( argc!=3 ) { Serial.printf("ERROR: 'count' has too many args\n"); return; }
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'count' has too many args\n"); return; }
     if( aocmd_cint_isprefix("reset",argv[2]) ) { /*nothing */ }
-    else { Serial.printf("ERROR: 'count' expects 'reset', not '%s'\n", argv[2]); return; }
+    else { aocmd_cint_printf("ERROR: 'count' expects 'reset', not '%s'\n", argv[2]); return; }
     aospi_txcount_reset();
     aospi_rxcount_reset();
     if( argv[0][0]!='@' ) aocmd_osp_count_show();
   } else if( aocmd_cint_isprefix("log",argv[1]) ) {
     if( argc==2 ) { aocmd_osp_log_show(); return; }
-    if( argc!=3 ) { Serial.printf("ERROR: 'log' has too many args\n"); return; }
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'log' has too many args\n"); return; }
     aoosp_loglevel_t level;
     if( aocmd_cint_isprefix("none",argv[2]) ) level= aoosp_loglevel_none;
     else if( aocmd_cint_isprefix("args",argv[2]) ) level= aoosp_loglevel_args;
     else if( aocmd_cint_isprefix("tele",argv[2]) ) level= aoosp_loglevel_tele;
-    else { Serial.printf("ERROR: 'log' expects 'none', 'args', or 'tele', not '%s'\n", argv[2]); return; }
+    else { aocmd_cint_printf("ERROR: 'log' expects 'none', 'args', or 'tele', not '%s'\n", argv[2]); return; }
     aoosp_loglevel_set(level);
     if( argv[0][0]!='@' ) aocmd_osp_log_show();
+  } else if( aocmd_cint_isprefix("locate",argv[1]) ) {
+    aocmd_osp_locate(argc, argv);
+  #if AOCMD_CONFIG_OSP_INFO
   } else if( aocmd_cint_isprefix("info",argv[1]) ) {
     if( argc==2 ) { aocmd_osp_info_show(); return; }
-    if( argc!=3 ) { Serial.printf("ERROR: 'info' has too many args\n"); return; }
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'info' has too many args\n"); return; }
     // todo: add sub-command to search in descriptions?
     #define LIST_FINDMAX 9
     int variants[LIST_FINDMAX];
     int found = aocmd_osp_variant_find( argv[2], variants, LIST_FINDMAX);
-    if( found==0 ) { Serial.printf("ERROR: 'info' <tele> '%s' has no match\n", argv[2]); return; }
+    if( found==0 ) { aocmd_cint_printf("ERROR: 'info' <tele> '%s' has no match\n", argv[2]); return; }
     int list= found==LIST_FINDMAX ? found-1 : found;
     for( int i=0; i<list; i++ ) aocmd_osp_variant_print( &aocmd_osp_variant[variants[i]] );
-    if( found!=list ) { Serial.printf("WARNING: 'info' has too many matches (list truncated)\n"); return; }
+    if( found!=list ) { aocmd_cint_printf("WARNING: 'info' has too many matches (list truncated)\n"); return; }
   } else if( aocmd_cint_isprefix("aoresult",argv[1]) ) {
     aocmd_osp_aoresult(argc, argv);
+  #endif
   } else if( aocmd_cint_isprefix("fields",argv[1]) ) {
     aocmd_osp_fields(argc, argv);
+  } else if( aocmd_cint_isprefix("format",argv[1]) ) {
+    if( argc==2 ) { aocmd_osp_format_show(); return; }
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'format' has too many args\n"); return; }
+    if( aocmd_cint_isprefix("raw",argv[2]) ) aocmd_osp_format=AOCMD_OSP_FORMAT_RAW;
+    else if( aocmd_cint_isprefix("fields",argv[2]) ) aocmd_osp_format=AOCMD_OSP_FORMAT_FIELDS;
+    else if( aocmd_cint_isprefix("compact",argv[2]) ) aocmd_osp_format=AOCMD_OSP_FORMAT_COMPACT;
+    else { aocmd_cint_printf("ERROR: 'format' expects 'raw', 'fields' or 'compact', not '%s'\n",argv[2]); return; }
+    if( argv[0][0]!='@' ) aocmd_osp_format_show();
   } else if( aocmd_cint_isprefix("resetinit",argv[1]) ) {
     aocmd_osp_resetinit(argc, argv);
+  } else if( aocmd_cint_isprefix("record",argv[1]) ) {
+    aocmd_osp_record(argc, argv);
+  } else if( aocmd_cint_isprefix("replay",argv[1]) ) {
+    aocmd_osp_replay(argc, argv);
+  } else if( aocmd_cint_isprefix("monitor",argv[1]) ) {
+    aocmd_osp_monitor(argc, argv);
   } else if( aocmd_cint_isprefix("enum",argv[1]) ) {
     aocmd_osp_enum(argc, argv);
   } else if( aocmd_cint_isprefix("send",argv[1]) ) {
@@ -865,7 +1696,7 @@ static void aocmd_osp_main( int argc, char * argv[] ) {
   } else if( aocmd_cint_isprefix("tx",argv[1]) || aocmd_cint_isprefix("trx",argv[1])) {
     aocmd_osp_trx(argc, argv);
   } else {
-    Serial.printf("ERROR: 'osp' has unknown argument ('%s')\n", argv[1]); return;
+    aocmd_cint_printf("ERROR: 'osp' has unknown argument ('%s')\n", argv[1]); return;
   }
 }
 
@@ -873,7 +1704,7 @@ static void aocmd_osp_main( int argc, char * argv[] ) {
 // The long help text for the "osp" command.
 static const char aocmd_osp_longhelp[] =
   "SYNTAX: osp\n"
-  "- shows dirmux, validate, count and log status\n"
+  "- shows dirmux, validate, format, count and log status\n"
   "SYNTAX: osp dirmux [ bidir | loop ]\n"
   "- without optional argument shows the status of the direction mux\n"
   "- with optional argument sets the direction mux to bi-directional or loop\n"
@@ -881,7 +1712,12 @@ static const char aocmd_osp_longhelp[] =
   "- without optional argument shows the status of telegram validation\n"
   "- with optional argument sets it\n"
   "- this validates (checks consistency of) telegrams issued with 'send'/'tx'\n"
-  "- enabled is slower, but invalid telegrams will be sent anyhow\n"
+  "- validation is table driven, messages only when issues; invalid telegrams are sent anyhow\n"
+  "SYNTAX: osp format [ raw | fields | compact ]\n"
+  "- without optional argument shows how 'send' prints responses\n"
+  "- 'raw' prints all response bytes (header, payload, crc) in hex\n"
+  "- 'fields' prints the payload decoded as <field>=<hex> (see info)\n"
+  "- 'compact' prints only the payload bytes, in hex without spaces\n"
   "SYNTAX: osp count [ reset ]\n"
   "- without optional argument shows how many telegrams were sent and received\n"
   "- with 'reset', resets counters to 0\n"
@@ -896,12 +1732,14 @@ static const char aocmd_osp_longhelp[] =
   "- with optional argument sets it\n"
   "- these output enable lines also control two signaling LEDs on OSP32\n"
   "- this is for testing only; do not use when telegrams are sent\n"
+  #if AOCMD_CONFIG_OSP_INFO
   "SYNTAX: osp info [ <tele> ]\n"
   "- without optional arguments lists all (known) telegrams\n"
   "- with argument, gives info on telegrams with <tele> in name (max 8)\n"
   "SYNTAX: osp aoresult [ <filter> ]\n"
   "- lists all aoresult codes (that match <filter>)\n"
   "- <filter> is an decimal number or a string\n"
+  #endif
   "SYNTAX: osp fields <data>...\n"
   "- pretty prints telegram dissected into fields (except for the payload)\n"
   "- last line is in decimal, line before that in hex\n"
@@ -911,6 +1749,30 @@ static const char aocmd_osp_longhelp[] =
   "- resetinit tries reset-initloop, then reset-initbidir (controls dirmux)\n"
   "SYNTAX: osp enum\n"
   "- enumerates all nodes in the chain (starts with resetinit)\n"
+  "SYNTAX: osp record [ start | stop | list ]\n"
+  "- without optional argument shows recording status\n"
+  "- 'start' clears the recording and records telegrams from 'send'/'tx'/'trx'\n"
+  "- 'stop' stops recording and persists the recording (survives reset)\n"
+  "- 'list' lists recorded telegrams with time since previous one\n"
+  "SYNTAX: osp replay [ <speed> [ <maxgap> ] ]\n"
+  "- sends the recorded telegrams again, printing responses that differ\n"
+  "- <speed> 1 (default) keeps recorded timing, 2 is twice as fast, etc\n"
+  "- <speed> 0 sends the telegrams back-to-back (e.g. for throughput tests)\n"
+  "- waits between telegrams are capped to <maxgap> ms (default 1000)\n"
+  "- pressing a key aborts the replay\n"
+  "SYNTAX: osp monitor [ on | off | reset | interval <min> <max> | tlimit <temp> ]\n"
+  "- without optional argument shows monitor status and counters\n"
+  "- monitor sends p4err, asktinfo and askvinfo (serial cast) in background\n"
+  "- interval (ms) doubles up to <max> when healthy, drops to <min> on anomaly\n"
+  "- failing telegrams are reported once (and back off), as is their recovery\n"
+  "- skips when other telegrams are sent; prints a line when health changes\n"
+  "- <temp> is raw asktinfo max temperature that counts as anomaly (hex)\n"
+  "- requires application to call aocmd_osp_monitor_poll() from loop()\n"
+  "SYNTAX: osp locate ( error | temp <temp> )\n"
+  "- 'error' reports the first node with error flags (one p4err telegram)\n"
+  "- 'temp' lists all nodes with temperature at or above <temp> (raw, hex)\n"
+  "- 'temp' checks with one asktinfo, if hot probes each node (readtempstat)\n"
+  "- reports number of telegrams and elapsed time; needs 'resetinit' first\n"
   "SYNTAX: osp send <addr> <tele> <data>...\n"
   "- this is a high level send, with auto-fill for pre-amble, PSI, CRC\n"
   "- sends telegram <tele> to node <addr> with optional <data>\n"
@@ -939,13 +1801,8 @@ static const char aocmd_osp_longhelp[] =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_osp_register() {
-  return aocmd_cint_register(aocmd_osp_main, "osp", "sends and receives OSP telegrams", aocmd_osp_longhelp);
+  return aocmd_cint_register(aocmd_osp_main, "osp", "sends and receives OSP telegrams", AOCMD_LONGHELP(aocmd_osp_longhelp));
 }
 
 
-
-
-
-  
-
-
+#endif // AOCMD_CONFIG_OSP
@@ -22,14 +22,38 @@
 #define _AOCMD_OSP_H_
 
 
+#include <aocmd_config.h> // AOCMD_CONFIG_OSP
+
+
 // Registers the built-in "osp" command with the command interpreter.
 int aocmd_osp_register();
 
 
+#if AOCMD_CONFIG_OSP
 // Initializes the telegram parser.
 void aocmd_osp_init();
 
 
+// Runs the chain health monitor ('osp monitor'); call from loop().
+void aocmd_osp_monitor_poll();
+#else
+// The "osp" command is compiled out (see aocmd_config.h); these stubs keep the callers unchanged.
+static inline void aocmd_osp_init() {}
+static inline void aocmd_osp_monitor_poll() {}
+#endif
+
+
+// Events of the chain health monitor.
+#define AOCMD_OSP_MONITOR_EVENT_ERROR        1 // p4err found a node with error flags
+#define AOCMD_OSP_MONITOR_EVENT_ERRORCLEARED 2 // p4err no longer finds a node with error flags
+#define AOCMD_OSP_MONITOR_EVENT_HOT          3 // asktinfo max temperature reached the limit
+#define AOCMD_OSP_MONITOR_EVENT_COOLED       4 // asktinfo max temperature dropped below the limit
+#define AOCMD_OSP_MONITOR_EVENT_FAIL         5 // a monitor telegram failed (after succeeding ones)
+#define AOCMD_OSP_MONITOR_EVENT_RECOVERED    6 // a monitor telegram succeeded (after failing ones)
+// UPCALL: The chain health monitor upcalls this function when chain health changes; default prints to the output sink.
+void aocmd_osp_monitor_event(int event, uint16_t addr, uint8_t val1, uint8_t val2);
+
+
 #endif
 
 
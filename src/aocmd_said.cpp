@@ -21,56 +21,366 @@
 
 
 #include <Arduino.h>        // Serial.printf
+#include <aospi.h>          // aospi_txcount_get()
 #include <aoosp.h>          // aoosp_crc()
 #include <aocmd_cint.h>     // aocmd_cint_register, aocmd_cint_isprefix, ...
+#include <aocmd_file.h>     // aocmd_file_read()
 #include <aocmd_said.h>     // own
 
 
-// Prints results of a scan of an I2C bus (for single SAID)
-static int aocmd_said_i2c_scan_uni(uint16_t addr, int verbose) {
-  // Scan all i2c devices
-  if( verbose ) Serial.printf("SAID %03X has I2C (now powered)\n",addr);
+#if AOCMD_CONFIG_SAID
+
+
+// === I2C scan ===
+
+
+// I2C addresses 0000xxx and 1111xxx are reserved (general call, CBUS, Hs-mode, 10-bit, ...) and not scanned
+#define AOCMD_SAID_I2C_DADDR7_ISRESERVED(daddr7) ( (daddr7)<0x08 || (daddr7)>0x77 )
+
+
+// Number of SAIDs scanned in parallel; one i2cread telegram per SAID before the first status is collected
+#define AOCMD_SAID_I2C_SCAN_BATCH   16
+// Bytes on the I2C bus for one probe (i2cread8 of 1 byte: daddr+W, raddr, daddr+R, data)
+#define AOCMD_SAID_I2C_SCAN_BYTES   4
+// A busy I2C bus counts as hung after MARGIN times the bus time of the transaction, plus STRETCHUS for clock stretching
+#define AOCMD_SAID_I2C_BUSY_MARGIN    4
+#define AOCMD_SAID_I2C_BUSY_STRETCHUS 2000
+// Number of SAIDs for which the scan result is cached
+#define AOCMD_SAID_I2C_CACHE_SIZE   32
+
+
+// Scan result of one SAID: bit daddr7 of present[] is set when device daddr7 acknowledged
+typedef struct aocmd_said_i2c_scan_s {
+  uint16_t addr;
+  uint8_t  present[16];
+} aocmd_said_i2c_scan_t;
+
+
+// Scan results of the most recent scans
+static aocmd_said_i2c_scan_t aocmd_said_i2c_cache[AOCMD_SAID_I2C_CACHE_SIZE];
+static int aocmd_said_i2c_cache_num;
+
+
+// Stores a scan result in the cache (replaces older result for same SAID, drops it when cache is full)
+static void aocmd_said_i2c_cache_put(const aocmd_said_i2c_scan_t * scan) {
+  int ix=0;
+  while( ix<aocmd_said_i2c_cache_num && aocmd_said_i2c_cache[ix].addr!=scan->addr ) ix++;
+  if( ix==AOCMD_SAID_I2C_CACHE_SIZE ) return;
+  if( ix==aocmd_said_i2c_cache_num ) aocmd_said_i2c_cache_num++;
+  aocmd_said_i2c_cache[ix]= *scan;
+}
+
+
+/*!
+    @brief  Looks up whether I2C device `daddr7` was found on the bus of SAID `addr` in a previous scan.
+    @param  addr
+            The address of the SAID.
+    @param  daddr7
+            The 7-bit I2C device address.
+    @return 1 if present, 0 if absent, -1 if the SAID was not (yet) scanned.
+    @note   No telegrams are sent; the cache is filled by 'said i2c <addr> scan'.
+*/
+int aocmd_said_i2c_scan_cached(uint16_t addr, uint8_t daddr7) {
+  for( int ix=0; ix<aocmd_said_i2c_cache_num; ix++ ) {
+    if( aocmd_said_i2c_cache[ix].addr==addr ) return (aocmd_said_i2c_cache[ix].present[daddr7/8] >> (daddr7%8)) & 1;
+  }
+  return -1;
+}
+
+
+// Returns the time (us) that an I2C transaction of `bytes` bytes at `freq` Hz may keep the bus busy.
+static uint32_t aocmd_said_i2c_busy_us(int bytes, int freq) {
+  if( freq<=0 ) freq= 1000; // unknown speed: be lenient
+  return (uint32_t)bytes*9*1000000/freq*AOCMD_SAID_I2C_BUSY_MARGIN + AOCMD_SAID_I2C_BUSY_STRETCHUS;
+}
+
+
+// Scans the I2C busses of `num` SAIDs (addresses in scan[].addr) in parallel, fills scan[].present.
+// For each device address, an i2cread8 is sent to all SAIDs, before the status is collected with 
+// readi2ccfg (NACK flag). So the I2C transactions run on all busses while telegrams travel the chain.
+// A bus that stays busy longer than the transaction may take (at the configured speed) is reported as 
+// timeout; the scan then stops, since a next i2cread8 would go to a busy bus.
+static aoresult_t aocmd_said_i2c_scan_engine(aocmd_said_i2c_scan_t * scan, int num) {
+  aoresult_t result;
+  for( int ix=0; ix<num; ix++ ) memset(scan[ix].present,0,sizeof scan[ix].present);
+  for( uint8_t daddr7=0; daddr7<0x80; daddr7++ ) {
+    if( AOCMD_SAID_I2C_DADDR7_ISRESERVED(daddr7) ) continue;
+    // Issue: start the I2C read on all SAIDs
+    for( int ix=0; ix<num; ix++ ) {
+      result= aoosp_send_i2cread8(scan[ix].addr, daddr7, 0x00, 1);
+      if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: i2cread8(%03X) failed (%s)\n", scan[ix].addr, aoresult_to_str(result) ); return result; }
+    }
+    // Collect: by now, most transactions have completed
+    for( int ix=0; ix<num; ix++ ) {
+      uint8_t flags, speed;
+      uint32_t us= micros();
+      uint32_t busyus= 0; // known after the first readi2ccfg (it returns the speed)
+      while( 1 ) {
+        result= aoosp_send_readi2ccfg(scan[ix].addr, &flags, &speed);
+        if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: readi2ccfg(%03X) failed (%s)\n", scan[ix].addr, aoresult_to_str(result) ); return result; }
+        if( !(flags & AOOSP_I2CCFG_FLAGS_BUSY) ) break;
+        if( busyus==0 ) busyus= aocmd_said_i2c_busy_us(AOCMD_SAID_I2C_SCAN_BYTES, aoosp_prt_i2ccfg_speed(speed));
+        if( micros()-us > busyus ) { 
+          aocmd_cint_printf("ERROR: i2c bus of SAID %03X still busy at device %02x (%s)\n", scan[ix].addr, daddr7, aoresult_to_str(aoresult_dev_i2ctimeout) ); 
+          return aoresult_dev_i2ctimeout; 
+        }
+      }
+      if( (flags & AOOSP_I2CCFG_FLAGS_NACK)==0 ) scan[ix].present[daddr7/8] |= 1<<(daddr7%8);
+    }
+  }
+  return aoresult_ok;
+}
+
+
+// Prints scan result of one SAID, returns number of devices
+static int aocmd_said_i2c_scan_print(const aocmd_said_i2c_scan_t * scan, int verbose) {
+  if( verbose ) aocmd_cint_printf("SAID %03X has I2C (now powered)\n",scan->addr);
   int count= 0;
   for( uint8_t daddr7=0; daddr7<0x80; daddr7++ ) {
-    if( verbose ) if( daddr7 % 16 == 0) Serial.printf("  %02x: ",daddr7);
-    // Try to read at address 0 of device daddr7
-    uint8_t buf[8];
-    aoresult_t result = aoosp_exec_i2cread8(addr, daddr7, 0x00, buf, 1);
-    int i2cfail=  result==aoresult_dev_i2cnack || result==aoresult_dev_i2ctimeout;
-    if( result!=aoresult_ok && !i2cfail ) { Serial.printf("ERROR: aoosp_exec_i2cread8(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return 0; }
-    if( i2cfail ) { if(verbose) Serial.printf(" %02x ",daddr7); } else Serial.printf("[%02x]",daddr7); // [] brackets indicate presence
-    if( !i2cfail ) count++;
-    if( verbose ) if( daddr7 % 16 == 15) Serial.printf("\n");
-  }
-  if( !verbose && count>0 ) Serial.printf(" ");
-  Serial.printf("SAID %03X has %d I2C devices\n",addr, count);
+    if( verbose ) if( daddr7 % 16 == 0) aocmd_cint_printf("  %02x: ",daddr7);
+    int present= (scan->present[daddr7/8] >> (daddr7%8)) & 1;
+    if( present ) aocmd_cint_printf("[%02x]",daddr7); // [] brackets indicate presence
+    else if( verbose ) aocmd_cint_printf( AOCMD_SAID_I2C_DADDR7_ISRESERVED(daddr7) ? " -- " : " %02x ",daddr7);
+    if( present ) count++;
+    if( verbose ) if( daddr7 % 16 == 15) aocmd_cint_printf("\n");
+  }
+  if( !verbose && count>0 ) aocmd_cint_printf(" ");
+  aocmd_cint_printf("SAID %03X has %d I2C devices\n",scan->addr, count);
+  return count;
+}
+
+
+// Prints results of a scan of an I2C bus (for single SAID)
+static int aocmd_said_i2c_scan_uni(uint16_t addr, int verbose) {
+  aocmd_said_i2c_scan_t scan;
+  scan.addr= addr;
+  uint32_t us= micros();
+  if( aocmd_said_i2c_scan_engine(&scan,1)!=aoresult_ok ) return 0;
+  us= micros()-us;
+  aocmd_said_i2c_cache_put(&scan);
+  int count= aocmd_said_i2c_scan_print(&scan,verbose);
+  if( verbose ) aocmd_cint_printf("scan %lu us\n", (unsigned long)us);
   return count;
 }
 
 
-// Prints I2C bus scan result for "broadcast" (loops over chain)
+// Scans a batch of SAIDs in parallel, prints and caches the results; returns number of I2C devices (-1 on error)
+static int aocmd_said_i2c_scan_batch(aocmd_said_i2c_scan_t * batch, int num, int verbose) {
+  if( aocmd_said_i2c_scan_engine(batch,num)!=aoresult_ok ) return -1;
+  int i2ccount=0;
+  for( int ix=0; ix<num; ix++ ) {
+    aocmd_said_i2c_cache_put(&batch[ix]);
+    i2ccount+= aocmd_said_i2c_scan_print(&batch[ix],verbose);
+    if( verbose ) aocmd_cint_printf("\n");
+  }
+  return i2ccount;
+}
+
+
+// Prints I2C bus scan result for "broadcast" (loops over chain, scanning batches of SAIDs in parallel)
 static void aocmd_said_i2c_scan_broad(int verbose) {
+  aocmd_said_i2c_scan_t batch[AOCMD_SAID_I2C_SCAN_BATCH];
   int i2ccount=0;
   int saidcount=0;
+  int num=0;
+  uint32_t us= micros();
   for( int addr=AOOSP_ADDR_UNICASTMIN; addr<=aoosp_exec_resetinit_last(); addr++ ) {
     if( aoosp_exec_i2cpower(addr)==aoresult_ok ) {
-      i2ccount+= aocmd_said_i2c_scan_uni(addr,verbose);
+      batch[num++].addr= addr;
       saidcount++;
-      if( verbose ) Serial.printf("\n");
     }
+    if( num==AOCMD_SAID_I2C_SCAN_BATCH ) {
+      int count= aocmd_said_i2c_scan_batch(batch,num,verbose);
+      if( count<0 ) return;
+      i2ccount+= count;
+      num= 0;
+    }
+  }
+  if( num>0 ) {
+    int count= aocmd_said_i2c_scan_batch(batch,num,verbose);
+    if( count<0 ) return;
+    i2ccount+= count;
+  }
+  us= micros()-us;
+  aocmd_cint_printf("total %d SAIDs have %d I2C devices (%lu us)\n", saidcount, i2ccount, (unsigned long)us);
+}
+
+
+// === I2C block transfer ===
+
+
+// Maximum number of bytes per i2cread8/readlast, respectively i2cwrite8 telegram
+#define AOCMD_SAID_I2C_BLOCK_RCHUNK    8
+#define AOCMD_SAID_I2C_BLOCK_WCHUNK    6
+// Number of readi2ccfg telegrams to wait for a busy I2C bus
+#define AOCMD_SAID_I2C_BLOCK_TRIES     8
+// Number of times a NACKed write is retried (e.g. EEPROM busy with its write cycle)
+#define AOCMD_SAID_I2C_BLOCK_WRETRIES  50
+
+
+// Returns the I2C bus frequency (Hz) of SAID `addr` (0 on error)
+static int aocmd_said_i2c_block_freq(uint16_t addr) {
+  uint8_t flags, speed;
+  if( aoosp_send_readi2ccfg(addr, &flags, &speed)!=aoresult_ok ) return 0;
+  return aoosp_prt_i2ccfg_speed(speed);
+}
+
+
+// Waits until the I2C transaction of `bytes` bytes on SAID `addr` completes. First waits the time the
+// transaction takes on the bus (9 bits per byte at `freq`), so that typically one readi2ccfg suffices.
+static aoresult_t aocmd_said_i2c_block_wait(uint16_t addr, int bytes, int freq) {
+  if( freq>0 ) delayMicroseconds( (uint32_t)bytes*9*1000000/freq );
+  int tries= AOCMD_SAID_I2C_BLOCK_TRIES;
+  uint8_t flags, speed;
+  do {
+    aoresult_t result= aoosp_send_readi2ccfg(addr, &flags, &speed);
+    if( result!=aoresult_ok ) return result;
+  } while( (flags & AOOSP_I2CCFG_FLAGS_BUSY) && --tries>0 );
+  if( flags & AOOSP_I2CCFG_FLAGS_BUSY ) return aoresult_dev_i2ctimeout;
+  if( flags & AOOSP_I2CCFG_FLAGS_NACK ) return aoresult_dev_i2cnack;
+  return aoresult_ok;
+}
+
+
+/*!
+    @brief  Reads `len` bytes from I2C device `daddr7`, starting at register `raddr`, via SAID `addr`.
+    @param  addr
+            The address of the SAID (its I2C bus must be powered).
+    @param  daddr7
+            The 7-bit I2C device address.
+    @param  raddr
+            The first register; subsequent chunks use raddr+8, raddr+16, ... (device must auto-increment).
+    @param  buf
+            Receives the `len` bytes.
+    @param  len
+            Number of bytes to read; raddr+len may not exceed 0x100.
+    @return aoresult_ok if all reads succeeded, otherwise the first error.
+    @note   Splits the transfer in i2cread8/readlast pairs of at most 8 bytes. Instead of 
+            polling readi2ccfg during the transaction, it waits the bus time, then confirms once.
+*/
+aoresult_t aocmd_said_i2c_readblock(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t * buf, int len) {
+  if( len<0 || raddr+len>0x100 ) return aoresult_osp_arg;
+  int freq= aocmd_said_i2c_block_freq(addr);
+  for( int pos=0; pos<len; pos+=AOCMD_SAID_I2C_BLOCK_RCHUNK ) {
+    int count= len-pos<AOCMD_SAID_I2C_BLOCK_RCHUNK ? len-pos : AOCMD_SAID_I2C_BLOCK_RCHUNK;
+    aoresult_t result= aoosp_send_i2cread8(addr, daddr7, raddr+pos, count);
+    if( result!=aoresult_ok ) return result;
+    result= aocmd_said_i2c_block_wait(addr, 4+count, freq); // daddr+raddr, daddr (restart), data
+    if( result!=aoresult_ok ) return result;
+    result= aoosp_send_readlast(addr, buf+pos, count);
+    if( result!=aoresult_ok ) return result;
+  }
+  return aoresult_ok;
+}
+
+
+/*!
+    @brief  Writes `len` bytes to I2C device `daddr7`, starting at register `raddr`, via SAID `addr`.
+    @param  addr
+            The address of the SAID (its I2C bus must be powered).
+    @param  daddr7
+            The 7-bit I2C device address.
+    @param  raddr
+            The first register; subsequent chunks use raddr+6, raddr+12, ... (device must auto-increment).
+    @param  buf
+            The `len` bytes to write.
+    @param  len
+            Number of bytes to write; raddr+len may not exceed 0x100.
+    @return aoresult_ok if all writes succeeded, otherwise the first error.
+    @note   Splits the transfer in i2cwrite8 telegrams with 6, 4, 2 or 1 bytes (the legal sizes).
+    @note   A NACK is retried (acknowledge polling), as e.g. EEPROMs NACK during their write cycle.
+            The caller must respect page boundaries of the device.
+*/
+aoresult_t aocmd_said_i2c_writeblock(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, int len) {
+  if( len<0 || raddr+len>0x100 ) return aoresult_osp_arg;
+  int freq= aocmd_said_i2c_block_freq(addr);
+  int pos= 0;
+  while( pos<len ) {
+    int count= len-pos;
+    if( count>=6 ) count=6; else if( count>=4 ) count=4; else if( count>=2 ) count=2;
+    int retries= AOCMD_SAID_I2C_BLOCK_WRETRIES;
+    aoresult_t result;
+    do {
+      result= aoosp_send_i2cwrite8(addr, daddr7, raddr+pos, buf+pos, count);
+      if( result!=aoresult_ok ) return result;
+      result= aocmd_said_i2c_block_wait(addr, 2+count, freq); // daddr+raddr, data
+    } while( result==aoresult_dev_i2cnack && --retries>0 );
+    if( result!=aoresult_ok ) return result;
+    pos+= count;
+  }
+  return aoresult_ok;
+}
+
+
+// Prints `len` bytes from `buf` as compact hex, 32 bytes per line prefixed with the register address
+static void aocmd_said_i2c_block_print(uint8_t raddr, const uint8_t * buf, int len) {
+  for( int pos=0; pos<len; pos++ ) {
+    if( pos%32==0 ) aocmd_cint_printf("  %02x: ",raddr+pos);
+    aocmd_cint_printf("%02X",buf[pos]);
+    if( pos%32==31 || pos==len-1 ) aocmd_cint_printf("\n");
   }
-  Serial.printf("total %d SAIDs have %d I2C devices\n", saidcount, i2ccount);
+}
+
+
+// Command handler for 'said i2c <addr> readblock <daddr7> <raddr> <len>'
+static void aocmd_said_i2c_readblock_cmd(int argc, char * argv[], uint16_t addr ) {
+  if( argc!=7 ) { aocmd_cint_printf("ERROR: 'readblock' expects <daddr7> <raddr> <len>\n"); return; }
+  uint16_t daddr7, raddr, len;
+  if( !aocmd_cint_parse_hex(argv[4],&daddr7) || daddr7>0x7F ) { aocmd_cint_printf("ERROR: 'readblock' expects <daddr7> 00..7F, not '%s'\n",argv[4]); return; }
+  if( !aocmd_cint_parse_hex(argv[5],&raddr) || raddr>0xFF ) { aocmd_cint_printf("ERROR: 'readblock' expects <raddr> 00..FF, not '%s'\n",argv[5]); return; }
+  if( !aocmd_cint_parse_hex(argv[6],&len) || len<1 || raddr+len>0x100 ) { aocmd_cint_printf("ERROR: 'readblock' expects <len> 1..%X, not '%s'\n",0x100-raddr,argv[6]); return; }
+  uint8_t buf[0x100];
+  uint32_t us= micros();
+  aoresult_t result= aocmd_said_i2c_readblock(addr, daddr7, raddr, buf, len);
+  us= micros()-us;
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: readblock(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+  if( argv[0][0]!='@' ) aocmd_cint_printf("said(%03X).i2c.dev(%02X).reg(%02X) %d bytes\n",addr,daddr7,raddr,len );
+  aocmd_said_i2c_block_print(raddr, buf, len);
+  if( argv[0][0]!='@' ) aocmd_cint_printf("readblock %lu us, %lu bytes/s at %d Hz\n", (unsigned long)us, 
+    (unsigned long)((uint64_t)len*1000000/(us?us:1)), aocmd_said_i2c_block_freq(addr) );
+}
 
+
+// Command handler for 'said i2c <addr> writeblock <daddr7> <raddr> <data>...' (each <data> may have multiple bytes)
+static void aocmd_said_i2c_writeblock_cmd(int argc, char * argv[], uint16_t addr ) {
+  if( argc<7 ) { aocmd_cint_printf("ERROR: 'writeblock' expects <daddr7> <raddr> <data>...\n"); return; }
+  uint16_t daddr7, raddr;
+  if( !aocmd_cint_parse_hex(argv[4],&daddr7) || daddr7>0x7F ) { aocmd_cint_printf("ERROR: 'writeblock' expects <daddr7> 00..7F, not '%s'\n",argv[4]); return; }
+  if( !aocmd_cint_parse_hex(argv[5],&raddr) || raddr>0xFF ) { aocmd_cint_printf("ERROR: 'writeblock' expects <raddr> 00..FF, not '%s'\n",argv[5]); return; }
+  uint8_t buf[0x100];
+  int len= 0;
+  for( int argix=6; argix<argc; argix++ ) {
+    const char * s= argv[argix];
+    int slen= strlen(s);
+    if( slen%2!=0 ) { aocmd_cint_printf("ERROR: 'writeblock' expects <data> with even number of hex digits, "); aocmd_cint_printf("not '%s'\n",s); return; }
+    for( int i=0; i<slen; i+=2 ) {
+      char hex[3]= { s[i], s[i+1], 0 };
+      uint16_t byte;
+      if( !aocmd_cint_parse_hex(hex,&byte) ) { aocmd_cint_printf("ERROR: 'writeblock' expects hex <data>, not '%s'\n",s); return; }
+      if( raddr+len>=0x100 ) { aocmd_cint_printf("ERROR: 'writeblock' <data> exceeds register FF\n"); return; }
+      buf[len++]= byte;
+    }
+  }
+  uint32_t us= micros();
+  aoresult_t result= aocmd_said_i2c_writeblock(addr, daddr7, raddr, buf, len);
+  us= micros()-us;
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: writeblock(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+  if( argv[0][0]=='@' ) return;
+  aocmd_cint_printf("said(%03X).i2c.dev(%02X).reg(%02X) %d bytes, %lu us, ",addr,daddr7,raddr,len,(unsigned long)us);
+  aocmd_cint_printf("%lu bytes/s at %d Hz\n", (unsigned long)((uint64_t)len*1000000/(us?us:1)), aocmd_said_i2c_block_freq(addr) );
 }
 
 
+// === I2C frequency ===
+
+
 // Shows the current I2C bus frequency
 static void aocmd_said_i2c_freq_show(uint16_t addr) {
   uint8_t flags;
   uint8_t speed;
   aoresult_t result= aoosp_send_readi2ccfg(addr, &flags, &speed);
-  if( result!=aoresult_ok ) { Serial.printf("ERROR: readi2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
-  Serial.printf("said(%03X).i2c.freq %d Hz (speed %d)\n", addr, aoosp_prt_i2ccfg_speed(speed), speed );
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: readi2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+  aocmd_cint_printf("said(%03X).i2c.freq %d Hz (speed %d)\n", addr, aoosp_prt_i2ccfg_speed(speed), speed );
 }
 
 
@@ -81,22 +391,176 @@ static aoresult_t aocmd_said_i2c_freq_set(uint16_t addr, int speed) {
   aoresult_t result;
   // read old flags
   result= aoosp_send_readi2ccfg(addr, &flags, &oldspeed);
-  if( result!=aoresult_ok ) { Serial.printf("ERROR: readi2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return result; }
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: readi2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return result; }
   // write flags and new speed
   result= aoosp_send_seti2ccfg(addr, flags, speed);
-  if( result!=aoresult_ok ) { Serial.printf("ERROR: seti2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return result; }
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: seti2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return result; }
   return aoresult_ok;
 }
 
 
-// Command handler for 'said i2c <addr> freq [<freq>]'
+// === I2C frequency tuning ===
+
+
+// Number of reads per device per speed during tuning
+#define AOCMD_SAID_I2C_TUNE_READS      3
+// Number of bytes (from register 00) read per device during tuning
+#define AOCMD_SAID_I2C_TUNE_BYTES      8
+// Number of SAIDs for which the tuned speed is stored
+#define AOCMD_SAID_I2C_TUNE_SIZE       32
+
+
+// Tuned speed per SAID (survives until reboot; 'osp resetinit' resets the SAIDs, and then restores these with aocmd_said_i2c_freq_restore)
+static struct { uint16_t addr; uint8_t speed; } aocmd_said_i2c_tuned[AOCMD_SAID_I2C_TUNE_SIZE];
+static int aocmd_said_i2c_tuned_num;
+
+
+/*!
+    @brief  Returns the speed code found by 'said i2c <addr> freq auto' for SAID `addr`.
+    @param  addr
+            The address of the SAID.
+    @return The speed code (AOOSP_I2CCFG_SPEED_MAX..AOOSP_I2CCFG_SPEED_MIN), or -1 if not tuned.
+*/
+int aocmd_said_i2c_freq_tuned(uint16_t addr) {
+  for( int ix=0; ix<aocmd_said_i2c_tuned_num; ix++ ) {
+    if( aocmd_said_i2c_tuned[ix].addr==addr ) return aocmd_said_i2c_tuned[ix].speed;
+  }
+  return -1;
+}
+
+
+// Stores speed as the tuned speed for SAID addr
+static void aocmd_said_i2c_freq_store(uint16_t addr, uint8_t speed) {
+  int ix=0;
+  while( ix<aocmd_said_i2c_tuned_num && aocmd_said_i2c_tuned[ix].addr!=addr ) ix++;
+  if( ix==AOCMD_SAID_I2C_TUNE_SIZE ) return;
+  if( ix==aocmd_said_i2c_tuned_num ) aocmd_said_i2c_tuned_num++;
+  aocmd_said_i2c_tuned[ix].addr= addr;
+  aocmd_said_i2c_tuned[ix].speed= speed;
+}
+
+
+// Reads the tuning bytes of device daddr7 at the current speed
+static aoresult_t aocmd_said_i2c_tune_read(uint16_t addr, uint8_t daddr7, uint8_t * buf) {
+  return aocmd_said_i2c_readblock(addr, daddr7, 0x00, buf, AOCMD_SAID_I2C_TUNE_BYTES);
+}
+
+
+// Reads reference bytes of the `num` devices `devs` at the current (slowest) speed, then tries the speeds 
+// from fastest to slowest; returns the first speed at which all devices read back ok (or -1).
+// Caller allocates `ref` for `num` blocks of reference bytes, followed by `num` blocks of masks.
+static int aocmd_said_i2c_freq_search(uint16_t addr, const uint8_t * devs, int num, uint8_t * ref, int verbose) {
+  uint8_t * mask= ref + num*AOCMD_SAID_I2C_TUNE_BYTES;
+  // Reference (with mask of stable bytes) at slowest speed
+  for( int ix=0; ix<num; ix++ ) {
+    uint8_t * r= ref + ix*AOCMD_SAID_I2C_TUNE_BYTES;
+    uint8_t buf[AOCMD_SAID_I2C_TUNE_BYTES];
+    aoresult_t result1= aocmd_said_i2c_tune_read(addr, devs[ix], r);
+    aoresult_t result2= aocmd_said_i2c_tune_read(addr, devs[ix], buf);
+    if( result1!=aoresult_ok || result2!=aoresult_ok ) { 
+      aocmd_cint_printf("ERROR: device %02X on SAID %03X fails at lowest speed (%s)\n", devs[ix], addr, aoresult_to_str(result1!=aoresult_ok?result1:result2) ); 
+      return -1; 
+    }
+    for( int i=0; i<AOCMD_SAID_I2C_TUNE_BYTES; i++ ) mask[ix*AOCMD_SAID_I2C_TUNE_BYTES+i]= r[i]==buf[i] ? 0xFF : 0x00;
+  }
+
+  // From fastest to slowest, the first speed that passes wins
+  for( int speed=AOOSP_I2CCFG_SPEED_MAX; speed<=AOOSP_I2CCFG_SPEED_MIN; speed++ ) {
+    if( aocmd_said_i2c_freq_set(addr,speed)!=aoresult_ok ) return -1;
+    int fails= 0;
+    for( int ix=0; ix<num; ix++ ) {
+      for( int r=0; r<AOCMD_SAID_I2C_TUNE_READS; r++ ) {
+        uint8_t buf[AOCMD_SAID_I2C_TUNE_BYTES];
+        if( aocmd_said_i2c_tune_read(addr, devs[ix], buf)!=aoresult_ok ) { fails++; continue; }
+        for( int i=0; i<AOCMD_SAID_I2C_TUNE_BYTES; i++ ) if( (buf[i]^ref[ix*AOCMD_SAID_I2C_TUNE_BYTES+i]) & mask[ix*AOCMD_SAID_I2C_TUNE_BYTES+i] ) { fails++; break; }
+      }
+    }
+    if( verbose ) aocmd_cint_printf("said(%03X).i2c.freq %d Hz (speed %d) %s\n", addr, aoosp_prt_i2ccfg_speed(speed), speed, fails ? "fails" : "ok" );
+    if( fails==0 ) return speed;
+  }
+  aocmd_cint_printf("ERROR: SAID %03X has no speed at which all I2C devices read back ok\n", addr);
+  return -1;
+}
+
+
+// Finds the fastest speed for SAID `addr` (see aocmd_said_i2c_freq_auto), leaves the bus at some tried speed on failure.
+static int aocmd_said_i2c_freq_find(uint16_t addr, int verbose) {
+  // Devices to verify against (scanned at slowest speed if not yet cached)
+  if( aocmd_said_i2c_freq_set(addr,AOOSP_I2CCFG_SPEED_MIN)!=aoresult_ok ) return -1;
+  if( aocmd_said_i2c_scan_cached(addr,0x08)<0 ) {
+    aocmd_said_i2c_scan_t scan;
+    scan.addr= addr;
+    if( aocmd_said_i2c_scan_engine(&scan,1)!=aoresult_ok ) return -1;
+    aocmd_said_i2c_cache_put(&scan);
+  }
+  uint8_t devs[0x80];
+  int num= 0;
+  for( uint8_t daddr7=0; daddr7<0x80; daddr7++ ) if( aocmd_said_i2c_scan_cached(addr,daddr7)==1 ) devs[num++]= daddr7;
+  if( num==0 ) { aocmd_cint_printf("ERROR: SAID %03X has no I2C devices to verify against\n", addr); return -1; }
+
+  // Reference bytes and masks only live during the search (sized by the number of devices)
+  uint8_t * ref= (uint8_t *)malloc( 2*num*AOCMD_SAID_I2C_TUNE_BYTES );
+  if( ref==0 ) { aocmd_cint_printf("ERROR: 'freq auto' failed (%s)\n", aoresult_to_str(aoresult_outofmem) ); return -1; }
+  int speed= aocmd_said_i2c_freq_search(addr, devs, num, ref, verbose);
+  free(ref);
+  return speed;
+}
+
+
+/*!
+    @brief  Finds the fastest I2C speed at which all devices on the bus of SAID `addr` read back reliably.
+    @param  addr
+            The address of the SAID (its I2C bus must be powered).
+    @param  verbose
+            When set, prints the verification result per speed.
+    @return The selected speed code (which is also configured and stored), or -1 on failure.
+    @note   Devices are taken from the scan cache (a scan is done when the SAID was not scanned).
+            Reference bytes are read twice at AOOSP_I2CCFG_SPEED_MIN; bytes that differ 
+            (e.g. live sensor data) are not compared. Then speeds are tried from 
+            AOOSP_I2CCFG_SPEED_MAX downward; the first one where every read is acknowledged 
+            and matches the reference is selected.
+    @note   On failure, the bus is set back to the speed it had before the call.
+*/
+int aocmd_said_i2c_freq_auto(uint16_t addr, int verbose) {
+  uint8_t flags, orgspeed;
+  aoresult_t result= aoosp_send_readi2ccfg(addr, &flags, &orgspeed);
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: readi2ccfg(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return -1; }
+  int speed= aocmd_said_i2c_freq_find(addr,verbose);
+  if( speed<0 ) { aocmd_said_i2c_freq_set(addr,orgspeed); return -1; }
+  aocmd_said_i2c_freq_store(addr,speed);
+  return speed;
+}
+
+
+/*!
+    @brief  Configures all SAIDs that were tuned with 'said i2c <addr> freq auto' to their tuned speed.
+    @return aoresult_ok if all succeeded, otherwise the first error.
+    @note   A reset of the chain (e.g. 'osp resetinit') resets the I2C configuration 
+            of the SAIDs; call this afterwards to restore the tuned speeds.
+*/
+aoresult_t aocmd_said_i2c_freq_restore() {
+  for( int ix=0; ix<aocmd_said_i2c_tuned_num; ix++ ) {
+    aoresult_t result= aocmd_said_i2c_freq_set(aocmd_said_i2c_tuned[ix].addr,aocmd_said_i2c_tuned[ix].speed);
+    if( result!=aoresult_ok ) return result;
+  }
+  return aoresult_ok;
+}
+
+
+// Command handler for 'said i2c <addr> freq [<freq>|auto]'
 static void aocmd_said_i2c_freq(int argc, char * argv[], uint16_t addr ) {
   // Read freq?
   if( argc==4 ) { aocmd_said_i2c_freq_show(addr); return; }
-  if( argc>5 ) { Serial.printf("ERROR: 'freq' has too many args\n"); return; }
+  if( argc>5 ) { aocmd_cint_printf("ERROR: 'freq' has too many args\n"); return; }
+  // Auto tune
+  if( aocmd_cint_isprefix("auto",argv[4]) ) {
+    if( aocmd_said_i2c_freq_auto(addr,argv[0][0]!='@')<0 ) return;
+    if( argv[0][0]!='@' ) aocmd_said_i2c_freq_show(addr);
+    return;
+  }
   // Write freq, get the Hz
   int freq;
-  if( !aocmd_cint_parse_dec(argv[4],&freq) ) { Serial.printf("ERROR: 'freq' expects <freq>, not '%s'\n",argv[4]); return; }
+  if( !aocmd_cint_parse_dec(argv[4],&freq) ) { aocmd_cint_printf("ERROR: 'freq' expects <freq>, not '%s'\n",argv[4]); return; }
   // Convert freq to speed (hw speed code)
   int speed=AOOSP_I2CCFG_SPEED_MAX;
   while( speed!=AOOSP_I2CCFG_SPEED_MIN && freq<aoosp_prt_i2ccfg_speed(speed) ) {
@@ -118,77 +582,132 @@ static void aocmd_said_i2c_write(int argc, char * argv[], uint16_t addr ) {
   int bufix= 0;
   while( argix<argc ) {
     uint16_t byte;
-    if( !aocmd_cint_parse_hex(argv[argix],&byte) || byte > 255 ) { Serial.printf("ERROR: 'write' expects 00..FF, not '%s'\n",argv[argix]); return; }
+    if( !aocmd_cint_parse_hex(argv[argix],&byte) || byte > 255 ) { aocmd_cint_printf("ERROR: 'write' expects 00..FF, not '%s'\n",argv[argix]); return; }
     buf[bufix]= byte;
     argix++;
     bufix++;
-    if( bufix>WBUFSIZE ) { Serial.printf("ERROR: 'write' has too many args\n"); return; }
+    if( bufix>WBUFSIZE ) { aocmd_cint_printf("ERROR: 'write' has too many args\n"); return; }
   }
   // Checks
-  if( bufix==0 || bufix==1 ) { Serial.printf("ERROR: 'write' expects <daddr7> and <raddr>\n"); return; }
-  if( buf[0] & ~ 0x7F ) { Serial.printf("ERROR: 'write' expects <daddr7> to be 00..7F, not %02X\n",buf[0]); return; }
+  if( bufix==0 || bufix==1 ) { aocmd_cint_printf("ERROR: 'write' expects <daddr7> and <raddr>\n"); return; }
+  if( buf[0] & ~ 0x7F ) { aocmd_cint_printf("ERROR: 'write' expects <daddr7> to be 00..7F, not %02X\n",buf[0]); return; }
   int count= bufix-2;
-  if( count!=1 && count!=2 && count!=4 && count!=6 ) { Serial.printf("ERROR: 'write' payload can only be 1, 2, 4, or 6 bytes (not %d)\n",count); return; }
+  if( count!=1 && count!=2 && count!=4 && count!=6 ) { aocmd_cint_printf("ERROR: 'write' payload can only be 1, 2, 4, or 6 bytes (not %d)\n",count); return; }
   // Now write
   aoresult_t result= aoosp_exec_i2cwrite8(addr, buf[0], buf[1], buf+2, count);
   // Feedback
-  if( result!=aoresult_ok ) { Serial.printf("ERROR: write(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
-  if( argv[0][0]!='@' ) Serial.printf("said(%03X).i2c.dev(%02X).reg(%02X) %s\n",addr,buf[0],buf[1], aoosp_prt_bytes(buf+2,count) );
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: write(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+  if( argv[0][0]!='@' ) aocmd_cint_printf("said(%03X).i2c.dev(%02X).reg(%02X) %s\n",addr,buf[0],buf[1], aoosp_prt_bytes(buf+2,count) );
 }
 
 
 // Command handler for 'said i2c <addr> read <daddr7> <raddr> <count>'
 static void aocmd_said_i2c_read(int argc, char * argv[], uint16_t addr ) {
   // <daddr7>
-  if( argc<5 ) { Serial.printf("ERROR: 'read' expects <daddr7>\n"); return; }
+  if( argc<5 ) { aocmd_cint_printf("ERROR: 'read' expects <daddr7>\n"); return; }
   uint16_t daddr7;
-  if( !aocmd_cint_parse_hex(argv[4],&daddr7) || daddr7>0x7F ) { Serial.printf("ERROR: 'read' expects <daddr7> 00..7F, not '%s'\n",argv[4]); return; }
+  if( !aocmd_cint_parse_hex(argv[4],&daddr7) || daddr7>0x7F ) { aocmd_cint_printf("ERROR: 'read' expects <daddr7> 00..7F, not '%s'\n",argv[4]); return; }
   // <raddr>
-  if( argc<6 ) { Serial.printf("ERROR: 'read' expects <raddr>\n"); return; }
+  if( argc<6 ) { aocmd_cint_printf("ERROR: 'read' expects <raddr>\n"); return; }
   uint16_t raddr;
-  if( !aocmd_cint_parse_hex(argv[5],&raddr) || raddr>0xFF ) { Serial.printf("ERROR: 'read' expects <raddr> 00..FF, not '%s'\n",argv[5]); return; }
+  if( !aocmd_cint_parse_hex(argv[5],&raddr) || raddr>0xFF ) { aocmd_cint_printf("ERROR: 'read' expects <raddr> 00..FF, not '%s'\n",argv[5]); return; }
   // <count>
   uint16_t count;
   if( argc==6 ) {
     count= 1;
   } else if( argc==7 ) {
-    if( !aocmd_cint_parse_hex(argv[6],&count) || count<1 || count>8 ) { Serial.printf("ERROR: 'read' expects <count> 1..8, not '%s'\n",argv[6]); return; }
+    if( !aocmd_cint_parse_hex(argv[6],&count) || count<1 || count>8 ) { aocmd_cint_printf("ERROR: 'read' expects <count> 1..8, not '%s'\n",argv[6]); return; }
   } else {
-    Serial.printf("ERROR: 'read' has too many args\n"); return;
+    aocmd_cint_printf("ERROR: 'read' has too many args\n"); return;
   }
   // Now read
   #define RBUFSIZE 8
   uint8_t buf[RBUFSIZE];
   aoresult_t result= aoosp_exec_i2cread8(addr, daddr7, raddr, buf, count);
   // Feedback
-  if( result!=aoresult_ok ) { Serial.printf("ERROR: read(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
-  if( argv[0][0]!='@' ) Serial.printf("said(%03X).i2c.dev(%02X).reg(%02X) ",addr,daddr7,raddr );
-  Serial.printf("%s\n", aoosp_prt_bytes(buf,count) );
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: read(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+  if( argv[0][0]!='@' ) aocmd_cint_printf("said(%03X).i2c.dev(%02X).reg(%02X) ",addr,daddr7,raddr );
+  aocmd_cint_printf("%s\n", aoosp_prt_bytes(buf,count) );
+}
+
+
+// === I2C watch ===
+
+
+// Poll interval of 'watch': starts at MIN, doubles after every poll, until MAX (in us)
+#define AOCMD_SAID_I2C_WATCH_MINUS     100
+#define AOCMD_SAID_I2C_WATCH_MAXUS     50000
+// Default and maximum timeout of 'watch' (in ms); the maximum keeps the timeout in us within 32 bits
+#define AOCMD_SAID_I2C_WATCH_TIMEOUT   1000
+#define AOCMD_SAID_I2C_WATCH_MAXTIMEOUT 600000
+
+
+// Command handler for 'said i2c <addr> watch <daddr7> <raddr> <mask> <value> [<timeout>]'
+static void aocmd_said_i2c_watch(int argc, char * argv[], uint16_t addr ) {
+  if( argc<8 ) { aocmd_cint_printf("ERROR: 'watch' expects <daddr7> <raddr> <mask> <value>\n"); return; }
+  if( argc>9 ) { aocmd_cint_printf("ERROR: 'watch' has too many args\n"); return; }
+  uint16_t daddr7, raddr, mask, value;
+  if( !aocmd_cint_parse_hex(argv[4],&daddr7) || daddr7>0x7F ) { aocmd_cint_printf("ERROR: 'watch' expects <daddr7> 00..7F, not '%s'\n",argv[4]); return; }
+  if( !aocmd_cint_parse_hex(argv[5],&raddr) || raddr>0xFF ) { aocmd_cint_printf("ERROR: 'watch' expects <raddr> 00..FF, not '%s'\n",argv[5]); return; }
+  if( !aocmd_cint_parse_hex(argv[6],&mask) || mask>0xFF ) { aocmd_cint_printf("ERROR: 'watch' expects <mask> 00..FF, not '%s'\n",argv[6]); return; }
+  if( !aocmd_cint_parse_hex(argv[7],&value) || value>0xFF ) { aocmd_cint_printf("ERROR: 'watch' expects <value> 00..FF, not '%s'\n",argv[7]); return; }
+  int timeout= AOCMD_SAID_I2C_WATCH_TIMEOUT;
+  if( argc==9 && (!aocmd_cint_parse_dec(argv[8],&timeout) || timeout<0 || timeout>AOCMD_SAID_I2C_WATCH_MAXTIMEOUT) ) { aocmd_cint_printf("ERROR: 'watch' expects <timeout> 0..%d (ms), not '%s'\n",AOCMD_SAID_I2C_WATCH_MAXTIMEOUT,argv[8]); return; }
+
+  // Poll with backing off interval until (reg & mask)==value, or timeout; a key press (on Serial) aborts
+  uint32_t start= micros();
+  uint32_t deadline= start+(uint32_t)timeout*1000;
+  uint32_t interval= AOCMD_SAID_I2C_WATCH_MINUS;
+  uint32_t next= start;
+  int polls= 0;
+  uint8_t reg;
+  bool match;
+  bool aborted= false;
+  while( true ) {
+    aoresult_t result= aoosp_exec_i2cread8(addr, daddr7, raddr, &reg, 1);
+    polls++;
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: watch(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+    match= (reg & mask)==value;
+    if( match || micros()-start>=(uint32_t)timeout*1000 ) break;
+    next+= interval;
+    if( interval<AOCMD_SAID_I2C_WATCH_MAXUS ) interval*= 2;
+    if( (int32_t)(next-deadline)>0 ) next= deadline; // last poll at the deadline, not an interval later
+    while( (int32_t)(next-micros())>0 ) {
+      if( Serial.available() ) { while( Serial.available() ) Serial.read(); aborted= true; break; }
+      yield();
+    }
+    if( aborted ) break;
+  }
+  uint32_t us= micros()-start;
+  const char * status= match ? "matches" : (aborted ? "aborted" : "timeout");
+  if( argv[0][0]!='@' ) aocmd_cint_printf("said(%03X).i2c.dev(%02X).reg(%02X) %02X %s after %lu us (%d polls)\n",
+    addr, daddr7, raddr, reg, status, (unsigned long)us, polls );
+  else if( !match ) aocmd_cint_printf("%s\n", status);
 }
 
 
-// Parse 'said i2c <addr> ( scan | freq [<freq>] | write <daddr7> <raddr> <data>... | read <daddr7> <raddr> <count> )'
+// Parse 'said i2c <addr> ( scan | freq [<freq>] | write <daddr7> <raddr> <data>... | read <daddr7> <raddr> <count> | writeblock ... | readblock ... | watch ... )'
 static void aocmd_said_i2c( int argc, char * argv[] ) {
-  if( argc<3 ) { Serial.printf("ERROR: i2c requires <addr>\n"); return; }
+  if( argc<3 ) { aocmd_cint_printf("ERROR: i2c requires <addr>\n"); return; }
 
   // get <addr>
   uint16_t addr;
   if( !aocmd_cint_parse_hex(argv[2],&addr) || !AOOSP_ADDR_ISOK(addr) || OAOSP_ADDR_ISMULTICAST(addr) ) {
-    Serial.printf("ERROR: illegal <addr> '%s'\n",argv[2]);
+    aocmd_cint_printf("ERROR: illegal <addr> '%s'\n",argv[2]);
     return;
   }
 
   if( AOOSP_ADDR_ISUNICAST(addr) ) { // 'said i2c 000 scan' allows broadcast, skip next check
     aoresult_t result= aoosp_exec_i2cpower(addr);
-    if( result==aoresult_sys_id ) { Serial.printf("ERROR: not a SAID at %03x\n", addr ); return; }
-    if( result==aoresult_dev_noi2cbridge ) { Serial.printf("ERROR: SAID at %03x has no I2C (OTP bit not set)\n", addr ); return; }
-    if( result!=aoresult_ok ) { Serial.printf("ERROR: i2cpower(%03X) failed (%s) - forgot 'osp resetinit'?\n", addr, aoresult_to_str(result) ); return; }
+    if( result==aoresult_sys_id ) { aocmd_cint_printf("ERROR: not a SAID at %03x\n", addr ); return; }
+    if( result==aoresult_dev_noi2cbridge ) { aocmd_cint_printf("ERROR: SAID at %03x has no I2C (OTP bit not set)\n", addr ); return; }
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: i2cpower(%03X) failed (%s) - forgot 'osp resetinit'?\n", addr, aoresult_to_str(result) ); return; }
   }
 
-  if( argc<4 ) { Serial.printf("ERROR: 'i2c' expects 'scan', 'freq', 'write', or 'read'\n"); return; }
+  if( argc<4 ) { aocmd_cint_printf("ERROR: 'i2c' expects 'scan', 'freq', 'write', 'read', 'writeblock', "); aocmd_cint_printf("'readblock', or 'watch'\n"); return; }
 
   if( aocmd_cint_isprefix("scan",argv[3]) ) {
-    if( argc!=4 ) { Serial.printf("ERROR: 'scan' has unknown argument ('%s')\n", argv[4]); return; }
+    if( argc!=4 ) { aocmd_cint_printf("ERROR: 'scan' has unknown argument ('%s')\n", argv[4]); return; }
     if( AOOSP_ADDR_ISUNICAST(addr) ) {
       aocmd_said_i2c_scan_uni(addr,argv[0][0]!='@');
     } else {
@@ -200,9 +719,261 @@ static void aocmd_said_i2c( int argc, char * argv[] ) {
     aocmd_said_i2c_write(argc,argv,addr);
   } else if( aocmd_cint_isprefix("read",argv[3]) ) {
     aocmd_said_i2c_read(argc,argv,addr);
+  } else if( aocmd_cint_isprefix("watch",argv[3]) ) {
+    aocmd_said_i2c_watch(argc,argv,addr);
+  } else if( aocmd_cint_isprefix("writeblock",argv[3]) ) {
+    aocmd_said_i2c_writeblock_cmd(argc,argv,addr);
+  } else if( aocmd_cint_isprefix("readblock",argv[3]) ) {
+    aocmd_said_i2c_readblock_cmd(argc,argv,addr);
   } else {
-    Serial.printf("ERROR: 'i2c' has unknown argument ('%s')\n", argv[3]); return;
+    aocmd_cint_printf("ERROR: 'i2c' has unknown argument ('%s')\n", argv[3]); return;
+  }
+}
+
+
+// === OTP cache ===
+
+
+// The OTP cache holds the customer area of SAIDs, read with 8-byte readotp telegrams.
+// It is invalidated by aocmd_said_otp_cache_invalidate() (osp resetinit/enum, reset and setotp telegrams).
+#define AOCMD_SAID_OTP_SIZE        (AOOSP_OTPADDR_CUSTOMER_MAX-AOOSP_OTPADDR_CUSTOMER_MIN+1)
+#define AOCMD_SAID_OTP_CACHE_SIZE  64
+
+
+// Cached OTP customer area of one node (issaid==0 means the node is not a SAID)
+typedef struct aocmd_said_otp_s {
+  uint16_t addr;
+  uint8_t  issaid;
+  uint8_t  otp[AOCMD_SAID_OTP_SIZE];
+} aocmd_said_otp_t;
+static aocmd_said_otp_t aocmd_said_otp_cache[AOCMD_SAID_OTP_CACHE_SIZE];
+static int aocmd_said_otp_cache_num;
+
+
+/*!
+    @brief  Invalidates the OTP cache for node `addr`.
+    @param  addr
+            The address of the node, or 0 (or a group address) to invalidate the whole cache.
+    @note   Must be called when the OTP (mirror) of nodes changes (setotp) or 
+            the chain is reset (addresses may change).
+*/
+void aocmd_said_otp_cache_invalidate(uint16_t addr) {
+  if( !AOOSP_ADDR_ISUNICAST(addr) ) { aocmd_said_otp_cache_num= 0; return; }
+  for( int ix=0; ix<aocmd_said_otp_cache_num; ix++ ) {
+    if( aocmd_said_otp_cache[ix].addr==addr ) {
+      aocmd_said_otp_cache[ix]= aocmd_said_otp_cache[--aocmd_said_otp_cache_num];
+      return;
+    }
+  }
+}
+
+
+/*!
+    @brief  Returns the OTP customer area of the SAID at `addr`, from cache or read from the node.
+    @param  addr
+            The address of the node.
+    @param  otp
+            Receives a pointer to AOCMD_SAID_OTP_SIZE bytes (OTP AOOSP_OTPADDR_CUSTOMER_MIN upwards).
+    @param  telecount
+            If not null, incremented with the number of telegrams sent.
+    @return aoresult_ok, aoresult_sys_id if the node is not a SAID, or a telegram error.
+    @note   When the cache is full, the data is read into a scratch entry (valid until the next call).
+*/
+aoresult_t aocmd_said_otp_cache_get(uint16_t addr, const uint8_t ** otp, int * telecount) {
+  aocmd_said_otp_t * entry= 0;
+  for( int ix=0; ix<aocmd_said_otp_cache_num; ix++ ) if( aocmd_said_otp_cache[ix].addr==addr ) entry= &aocmd_said_otp_cache[ix];
+  if( entry==0 ) {
+    static aocmd_said_otp_t scratch;
+    entry= aocmd_said_otp_cache_num<AOCMD_SAID_OTP_CACHE_SIZE ? &aocmd_said_otp_cache[aocmd_said_otp_cache_num] : &scratch;
+    uint32_t id;
+    aoresult_t result= aoosp_send_identify(addr, &id);
+    if( telecount ) (*telecount)++;
+    if( result!=aoresult_ok ) return result;
+    entry->addr= addr;
+    entry->issaid= AOOSP_IDENTIFY_IS_SAID(id);
+    // 8 bytes per readotp; the last chunk is moved down so that it does not read past the customer area
+    for( int pos=0; entry->issaid && pos<AOCMD_SAID_OTP_SIZE; pos+=8 ) {
+      int start= pos+8<=AOCMD_SAID_OTP_SIZE ? pos : AOCMD_SAID_OTP_SIZE-8;
+      result= aoosp_send_readotp(addr, AOOSP_OTPADDR_CUSTOMER_MIN+start, entry->otp+start, 8);
+      if( telecount ) (*telecount)++;
+      if( result!=aoresult_ok ) return result;
+    }
+    if( entry!=&scratch ) aocmd_said_otp_cache_num++;
+  }
+  if( !entry->issaid ) return aoresult_sys_id;
+  *otp= entry->otp;
+  return aoresult_ok;
+}
+
+
+// Parses `s`, a hex string of AOCMD_SAID_OTP_SIZE bytes (OTP customer area), into `image`
+static bool aocmd_said_otp_parse_image(const char * s, uint8_t * image) {
+  if( strlen(s)!=2*AOCMD_SAID_OTP_SIZE ) return false;
+  for( int i=0; i<AOCMD_SAID_OTP_SIZE; i++ ) {
+    char hex[3]= { s[2*i], s[2*i+1], 0 };
+    uint16_t byte;
+    if( !aocmd_cint_parse_hex(hex,&byte) ) return false;
+    image[i]= byte;
+  }
+  return true;
+}
+
+
+#define AOCMD_SAID_OTP_FILEPREFIX "file:" // <image> argument that names a file in the file store
+
+
+// Gets `image` from argument `arg`: a hex string, or file:<name> from the file store. The file
+// holds the AOCMD_SAID_OTP_SIZE bytes raw (e.g. 'file upload') or as hex (white space allowed).
+// Returns false (with error printed, mentioning `cmd`) when there is no valid image.
+static bool aocmd_said_otp_get_image(const char * cmd, const char * arg, uint8_t * image) {
+  int prefixlen= strlen(AOCMD_SAID_OTP_FILEPREFIX);
+  if( strncmp(arg,AOCMD_SAID_OTP_FILEPREFIX,prefixlen)!=0 ) {
+    if( aocmd_said_otp_parse_image(arg,image) ) return true;
+    aocmd_cint_printf("ERROR: '%s' expects <image> of %d hex bytes or %s<name>, ",cmd,AOCMD_SAID_OTP_SIZE,AOCMD_SAID_OTP_FILEPREFIX);
+    aocmd_cint_printf("not '%s'\n",arg);
+    return false;
+  }
+  const char * name= arg+prefixlen;
+#if AOCMD_CONFIG_FILE
+  char buf[4*AOCMD_SAID_OTP_SIZE+1]; // hex with a separator per byte
+  int size= aocmd_file_read(name, buf, sizeof buf);
+  if( size==-1 ) { aocmd_cint_printf("ERROR: '%s' image file '%s' does not exist\n",cmd,name); return false; }
+  if( size<0 ) { aocmd_cint_printf("ERROR: '%s' image file '%s' is corrupt or too big\n",cmd,name); return false; }
+  if( size==AOCMD_SAID_OTP_SIZE ) { memcpy(image,buf,AOCMD_SAID_OTP_SIZE); return true; }
+  // Hex: drop white space, then parse
+  int len= 0;
+  for( int i=0; i<size; i++ ) if( !isspace((unsigned char)buf[i]) ) buf[len++]= buf[i];
+  buf[len]= '\0';
+  if( aocmd_said_otp_parse_image(buf,image) ) return true;
+  aocmd_cint_printf("ERROR: '%s' image file '%s' must hold %d bytes (raw or hex)\n",cmd,name,AOCMD_SAID_OTP_SIZE);
+#else
+  aocmd_cint_printf("ERROR: '%s' can not read '%s' (file store compiled out)\n",cmd,name);
+#endif
+  return false;
+}
+
+
+// Parse 'said otp 000 diff [ <addr> | <image> ]'
+static void aocmd_said_otp_diff( int argc, char * argv[] ) {
+  if( argc>5 ) { aocmd_cint_printf("ERROR: 'otp diff' has too many args\n"); return; }
+  uint32_t us= micros();
+  int telecount= 0;
+  aoresult_t result;
+
+  // Reference image: from <image>, from SAID <addr>, or from first SAID
+  uint8_t ref[AOCMD_SAID_OTP_SIZE];
+  uint16_t refaddr= 0;
+  const uint8_t * otp;
+  if( argc==5 && strlen(argv[4])>3 ) {
+    if( !aocmd_said_otp_get_image("otp diff",argv[4],ref) ) return;
+  } else {
+    if( argc==5 ) {
+      if( !aocmd_cint_parse_hex(argv[4],&refaddr) || !AOOSP_ADDR_ISUNICAST(refaddr) ) { aocmd_cint_printf("ERROR: 'otp diff' expects <addr> %03X..%03X, not '%s'\n",AOOSP_ADDR_UNICASTMIN,AOOSP_ADDR_UNICASTMAX,argv[4]); return; }
+      result= aocmd_said_otp_cache_get(refaddr, &otp, &telecount);
+    } else {
+      result= aoresult_sys_id;
+      for( refaddr=AOOSP_ADDR_UNICASTMIN; refaddr<=aoosp_exec_resetinit_last() && result==aoresult_sys_id; refaddr++ ) result= aocmd_said_otp_cache_get(refaddr, &otp, &telecount);
+      refaddr--;
+    }
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: no reference SAID (%s)\n", aoresult_to_str(result) ); return; }
+    memcpy(ref,otp,AOCMD_SAID_OTP_SIZE);
+  }
+  if( argv[0][0]!='@' ) {
+    if( refaddr ) aocmd_cint_printf("reference SAID %03X:",refaddr); else aocmd_cint_printf("reference image:");
+    aocmd_cint_printf(" %s\n", aoosp_prt_bytes(ref,AOCMD_SAID_OTP_SIZE) );
+  }
+
+  // Compare all SAIDs
+  int saidcount= 0;
+  int diffcount= 0;
+  for( uint16_t addr=AOOSP_ADDR_UNICASTMIN; addr<=aoosp_exec_resetinit_last(); addr++ ) {
+    result= aocmd_said_otp_cache_get(addr, &otp, &telecount);
+    if( result==aoresult_sys_id ) continue;
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: otp(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+    saidcount++;
+    if( memcmp(otp,ref,AOCMD_SAID_OTP_SIZE)==0 ) continue;
+    diffcount++;
+    aocmd_cint_printf("SAID %03X differs:", addr);
+    for( int i=0; i<AOCMD_SAID_OTP_SIZE; i++ ) {
+      if( otp[i]!=ref[i] ) aocmd_cint_printf(" %02X:%02X/%02X", AOOSP_OTPADDR_CUSTOMER_MIN+i, otp[i], ref[i] );
+    }
+    aocmd_cint_printf("\n");
   }
+  us= micros()-us;
+  aocmd_cint_printf("total %d SAIDs, %d differ (%d telegrams, %lu us)\n", saidcount, diffcount, telecount, (unsigned long)us);
+}
+
+
+// Max number of OTP bytes in one setotp telegram (payload is the bytes plus the OTP address, at most 8)
+#define AOCMD_SAID_OTP_BATCH 7
+
+
+// Programs the OTP customer area of SAID `addr` to `image`; writes only differing bytes, then verifies.
+// The write set is batched: one settestpw, then one setotp per run of up to AOCMD_SAID_OTP_BATCH bytes
+// (equal bytes between differing ones are rewritten with their current value, which changes nothing).
+// Returns number of bytes written, or -1 on failure (error printed, also when `addr` is not a SAID).
+static int aocmd_said_otp_program_uni(uint16_t addr, const uint8_t * image) {
+  const uint8_t * otp;
+  aoresult_t result= aocmd_said_otp_cache_get(addr, &otp, 0);
+  if( result==aoresult_sys_id ) { aocmd_cint_printf("ERROR: node %03X is not a SAID\n", addr ); return -1; }
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: otp(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return -1; }
+  if( memcmp(otp,image,AOCMD_SAID_OTP_SIZE)==0 ) return 0;
+  // The cached content is the current content, so no read-modify-write per byte (as aoosp_exec_setotp does)
+  result= aoosp_send_settestpw(addr, aoosp_said_testpw_get());
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: settestpw(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return -1; }
+  int written= 0;
+  int i= 0;
+  while( i<AOCMD_SAID_OTP_SIZE ) {
+    if( otp[i]==image[i] ) { i++; continue; }
+    // Run from i up to the last differing byte within the batch size
+    int len= 1;
+    for( int j=i+1; j<i+AOCMD_SAID_OTP_BATCH && j<AOCMD_SAID_OTP_SIZE; j++ ) if( otp[j]!=image[j] ) len= j-i+1;
+    if( len==6 ) len= i+7<=AOCMD_SAID_OTP_SIZE ? 7 : 5; // a payload of 7 bytes does not exist
+    for( int j=i; j<i+len; j++ ) if( otp[j]!=image[j] ) written++;
+    result= aoosp_send_setotp(addr, AOOSP_OTPADDR_CUSTOMER_MIN+i, image+i, len);
+    if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: setotp(%03X,%02X) failed (%s)\n", addr, AOOSP_OTPADDR_CUSTOMER_MIN+i, aoresult_to_str(result) ); aocmd_said_otp_cache_invalidate(addr); return -1; }
+    i+= len;
+  }
+  // Verify by reading back
+  aocmd_said_otp_cache_invalidate(addr);
+  result= aocmd_said_otp_cache_get(addr, &otp, 0);
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: otp(%03X) read back failed (%s)\n", addr, aoresult_to_str(result) ); return -1; }
+  for( int i=0; i<AOCMD_SAID_OTP_SIZE; i++ ) {
+    if( otp[i]!=image[i] ) { aocmd_cint_printf("ERROR: SAID %03X verify failed at %02X: %02X/%02X\n", addr, AOOSP_OTPADDR_CUSTOMER_MIN+i, otp[i], image[i] ); return -1; }
+  }
+  return written;
+}
+
+
+// Parse 'said otp <addr> program <image>'
+static void aocmd_said_otp_program( int argc, char * argv[], uint16_t addr ) {
+  if( argc!=5 ) { aocmd_cint_printf("ERROR: 'otp program' expects <image>\n"); return; }
+  uint8_t image[AOCMD_SAID_OTP_SIZE];
+  if( !aocmd_said_otp_get_image("otp program",argv[4],image) ) return;
+  uint16_t first= addr==AOOSP_ADDR_BROADCAST ? AOOSP_ADDR_UNICASTMIN : addr;
+  uint16_t last = addr==AOOSP_ADDR_BROADCAST ? aoosp_exec_resetinit_last() : addr;
+  const uint8_t * otp;
+  if( addr!=AOOSP_ADDR_BROADCAST && aocmd_said_otp_cache_get(addr, &otp, 0)==aoresult_sys_id ) { aocmd_cint_printf("ERROR: node %03X is not a SAID\n", addr ); return; }
+  int saidcount= 0;
+  int programmed= 0;
+  int failed= 0;
+  uint32_t us= micros();
+  for( uint16_t a=first; a<=last; a++ ) {
+    // Telegrams are counted by aospi, so this includes all that aoosp_exec_setotp() sends
+    int telecount= aospi_txcount_get();
+    uint32_t nodeus= micros();
+    if( addr==AOOSP_ADDR_BROADCAST && aocmd_said_otp_cache_get(a, &otp, 0)==aoresult_sys_id ) continue; // skip non-SAIDs in chain
+    int written= aocmd_said_otp_program_uni(a, image);
+    nodeus= micros()-nodeus;
+    telecount= aospi_txcount_get()-telecount;
+    saidcount++;
+    if( written<0 ) failed++; 
+    if( written>0 ) programmed++;
+    if( argv[0][0]!='@' && written>=0 ) aocmd_cint_printf("SAID %03X: %d bytes written%s (%d telegrams, %lu us)\n", a, written, written ? ", verified" : "", telecount, (unsigned long)nodeus);
+  }
+  us= micros()-us;
+  aocmd_cint_printf("total %d SAIDs, %d programmed, %d failed ", saidcount, programmed, failed );
+  aocmd_cint_printf("(%lu us, %lu us per SAID)\n", (unsigned long)us, (unsigned long)(saidcount ? us/saidcount : 0) );
 }
 
 
@@ -210,32 +981,48 @@ static void aocmd_said_i2c( int argc, char * argv[] ) {
 static void aocmd_said_otp( int argc, char * argv[] ) {
   aoresult_t result;
 
-  if( argc<3 ) { Serial.printf("ERROR: 'otp' expects <addr> of SAID\n"); return; }
+  if( argc<3 ) { aocmd_cint_printf("ERROR: 'otp' expects <addr> of SAID\n"); return; }
+
+  // Action: program (one SAID or entire chain)
+  if( argc>=4 && aocmd_cint_isprefix("program",argv[3]) ) {
+    uint16_t addr;
+    if( !aocmd_cint_parse_hex(argv[2],&addr) || (addr!=AOOSP_ADDR_BROADCAST && !AOOSP_ADDR_ISUNICAST(addr)) ) { aocmd_cint_printf("ERROR: 'otp program' expects <addr> 000..%03X, not '%s'\n",AOOSP_ADDR_UNICASTMAX,argv[2]); return; }
+    aocmd_said_otp_program(argc,argv,addr);
+    return;
+  }
+
+  // Action: diff (over entire chain)
+  if( argc>=4 && aocmd_cint_isprefix("diff",argv[3]) ) {
+    uint16_t addr;
+    if( !aocmd_cint_parse_hex(argv[2],&addr) || addr!=AOOSP_ADDR_BROADCAST ) { aocmd_cint_printf("ERROR: 'otp diff' expects <addr> 000, not '%s'\n",argv[2]); return; }
+    aocmd_said_otp_diff(argc,argv);
+    return;
+  }
 
   // get <addr>
   uint16_t addr;
   if( !aocmd_cint_parse_hex(argv[2],&addr) || !AOOSP_ADDR_ISUNICAST(addr) ) {
-    Serial.printf("ERROR: 'otp' expects <addr> %03X..%03X, not '%s'\n",AOOSP_ADDR_UNICASTMIN,AOOSP_ADDR_UNICASTMAX,argv[2]);
+    aocmd_cint_printf("ERROR: 'otp' expects <addr> %03X..%03X, not '%s'\n",AOOSP_ADDR_UNICASTMIN,AOOSP_ADDR_UNICASTMAX,argv[2]);
     return;
   }
 
   // Check if it is a SAID
   uint32_t id;
   result = aoosp_send_identify(addr, &id );
-  if( result!=aoresult_ok ) { Serial.printf("ERROR: identify(%03X) failed (%s) - forgot 'osp resetinit'?\n", addr, aoresult_to_str(result) ); return; }
-  if( ! AOOSP_IDENTIFY_IS_SAID(id) ) { Serial.printf("ERROR: node %03X is not a SAID (id %08lX)\n", addr,id ); return; }
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: identify(%03X) failed (%s) - forgot 'osp resetinit'?\n", addr, aoresult_to_str(result) ); return; }
+  if( ! AOOSP_IDENTIFY_IS_SAID(id) ) { aocmd_cint_printf("ERROR: node %03X is not a SAID (id %08lX)\n", addr,(unsigned long)id ); return; }
 
   // Action: Dump
   if( argc==3 ) {
     result= aoosp_exec_otpdump(addr, AOOSP_OTPDUMP_CUSTOMER_HEX | AOOSP_OTPDUMP_CUSTOMER_FIELDS );
-    if( result!=aoresult_ok ) Serial.printf("ERROR: otp dump failed %d %s\n", result, aoresult_to_str(result) );
+    if( result!=aoresult_ok ) aocmd_cint_printf("ERROR: otp dump failed %d %s\n", result, aoresult_to_str(result) );
     return;
   }
 
   // get <otpaddr>
   uint16_t otpaddr;
   if( !aocmd_cint_parse_hex(argv[3],&otpaddr) || otpaddr<AOOSP_OTPADDR_CUSTOMER_MIN || otpaddr>AOOSP_OTPADDR_CUSTOMER_MAX ) {
-    Serial.printf("ERROR: 'otp' expects <otpaddr> %02X..%02X, not '%s'\n",AOOSP_OTPADDR_CUSTOMER_MIN,AOOSP_OTPADDR_CUSTOMER_MAX,argv[3]);
+    aocmd_cint_printf("ERROR: 'otp' expects <otpaddr> %02X..%02X, not '%s'\n",AOOSP_OTPADDR_CUSTOMER_MIN,AOOSP_OTPADDR_CUSTOMER_MAX,argv[3]);
     return;
   }
 
@@ -243,29 +1030,224 @@ static void aocmd_said_otp( int argc, char * argv[] ) {
   if( argc==4 ) {
     uint8_t data;
     result = aoosp_send_readotp(addr, otpaddr, &data, 1);
-    Serial.printf("SAID[%03X].OTP[%02X] -> %02X (%s)\n", addr, otpaddr, data, aoresult_to_str(result) );
+    aocmd_cint_printf("SAID[%03X].OTP[%02X] -> %02X (%s)\n", addr, otpaddr, data, aoresult_to_str(result) );
     return;
   }
 
   // get <data>
   uint16_t data;
   if( !aocmd_cint_parse_hex(argv[4],&data) || data>0xFF ) {
-    Serial.printf("ERROR: illegal <data> '%s' (0x00..0xFF)\n",argv[2]);
+    aocmd_cint_printf("ERROR: illegal <data> '%s' (0x00..0xFF)\n",argv[2]);
     return;
   }
 
   // Action: write
-  if( argc>5 ) { Serial.printf("ERROR: 'otp' has too many args\n"); return; }
+  if( argc>5 ) { aocmd_cint_printf("ERROR: 'otp' has too many args\n"); return; }
   result = aoosp_exec_setotp(addr, otpaddr, data, 0x00);
-  if( argv[0][0]!='@' ) Serial.printf("SAID[%03X].OTP[%02X] <- %02X (%s)\n", addr, otpaddr, data, aoresult_to_str(result) );
+  aocmd_said_otp_cache_invalidate(addr);
+  if( argv[0][0]!='@' ) aocmd_cint_printf("SAID[%03X].OTP[%02X] <- %02X (%s)\n", addr, otpaddr, data, aoresult_to_str(result) );
+}
+
+
+
+// === I2C sampler ===
+
+
+// The sampler reads I2C registers on a schedule and stores timestamped samples in a ring buffer.
+// Due entries on the same SAID and device whose registers are close are read with one block read.
+// The application must call aocmd_said_sample_poll() from loop().
+#define AOCMD_SAID_SAMPLE_ENTRIES   8     // number of sampler entries
+#define AOCMD_SAID_SAMPLE_MAXLEN    8     // max bytes per entry
+#define AOCMD_SAID_SAMPLE_SPAN      16    // max register span of a coalesced read
+#define AOCMD_SAID_SAMPLE_BUFSIZE   1024  // ring buffer size; a sample takes 6+len bytes (ms, entry, len, data)
+
+
+// Sampler entries
+typedef struct aocmd_said_sample_s {
+  uint16_t addr;
+  uint8_t  daddr7;
+  uint8_t  raddr;
+  uint8_t  len;
+  uint32_t periodms;
+  uint32_t nextms;
+} aocmd_said_sample_t;
+static aocmd_said_sample_t aocmd_said_sample_entries[AOCMD_SAID_SAMPLE_ENTRIES];
+static int aocmd_said_sample_num;
+
+
+// Sampler state
+static int      aocmd_said_sample_running;
+static int      aocmd_said_sample_stream;    // print samples when taken (instead of only buffering)
+static uint8_t  aocmd_said_sample_buf[AOCMD_SAID_SAMPLE_BUFSIZE];
+static int      aocmd_said_sample_head;      // next write position
+static int      aocmd_said_sample_tail;      // oldest sample
+static int      aocmd_said_sample_used;      // bytes in use
+static struct { int reads; int samples; int drops; int fails; } aocmd_said_sample_stats;
+
+
+// Ring buffer access (byte wise)
+static void aocmd_said_sample_putc(uint8_t b) { aocmd_said_sample_buf[aocmd_said_sample_head]= b; aocmd_said_sample_head= (aocmd_said_sample_head+1) % AOCMD_SAID_SAMPLE_BUFSIZE; aocmd_said_sample_used++; }
+static uint8_t aocmd_said_sample_getc() { uint8_t b= aocmd_said_sample_buf[aocmd_said_sample_tail]; aocmd_said_sample_tail= (aocmd_said_sample_tail+1) % AOCMD_SAID_SAMPLE_BUFSIZE; aocmd_said_sample_used--; return b; }
+static uint8_t aocmd_said_sample_peek(int offset) { return aocmd_said_sample_buf[(aocmd_said_sample_tail+offset) % AOCMD_SAID_SAMPLE_BUFSIZE]; }
+
+
+// Prints one sample: <ms> <entry> <data as compact hex>
+static void aocmd_said_sample_print(uint32_t ms, int ix, const uint8_t * data, int len) {
+  aocmd_cint_printf("%lu %d ", (unsigned long)ms, ix);
+  for( int i=0; i<len; i++ ) aocmd_cint_printf("%02X",data[i]);
+  aocmd_cint_printf("\n");
+}
+
+
+// Reads (removes) the oldest sample from the ring; returns its length (or -1 when empty)
+static int aocmd_said_sample_get(uint32_t * ms, int * ix, uint8_t * data) {
+  if( aocmd_said_sample_used==0 ) return -1;
+  uint32_t t= 0;
+  for( int i=0; i<4; i++ ) t= (t<<8) | aocmd_said_sample_getc();
+  *ms= t;
+  *ix= aocmd_said_sample_getc();
+  int len= aocmd_said_sample_getc();
+  for( int i=0; i<len; i++ ) data[i]= aocmd_said_sample_getc();
+  return len;
+}
+
+
+// Appends a sample to the ring, dropping the oldest samples when full
+static void aocmd_said_sample_put(uint32_t ms, int ix, const uint8_t * data, int len) {
+  aocmd_said_sample_stats.samples++;
+  if( aocmd_said_sample_stream ) aocmd_said_sample_print(ms,ix,data,len);
+  while( AOCMD_SAID_SAMPLE_BUFSIZE-aocmd_said_sample_used < 6+len ) {
+    int oldlen= aocmd_said_sample_peek(5);
+    for( int i=0; i<6+oldlen; i++ ) aocmd_said_sample_getc();
+    aocmd_said_sample_stats.drops++;
+  }
+  for( int i=3; i>=0; i-- ) aocmd_said_sample_putc( ms>>(8*i) );
+  aocmd_said_sample_putc(ix);
+  aocmd_said_sample_putc(len);
+  for( int i=0; i<len; i++ ) aocmd_said_sample_putc(data[i]);
 }
 
 
+/*!
+    @brief  Runs the I2C sampler (when started with 'said sample start').
+    @note   Call this from loop(), e.g. next to aocmd_cint_pollserial().
+            It returns immediately when the sampler is stopped or no entry is due.
+    @note   Due entries on the same SAID and I2C device are coalesced into one block read 
+            when their registers span at most AOCMD_SAID_SAMPLE_SPAN bytes.
+*/
+void aocmd_said_sample_poll() {
+  if( !aocmd_said_sample_running || aoosp_exec_resetinit_last()==0 ) return;
+  uint32_t now= millis();
+  uint8_t  due[AOCMD_SAID_SAMPLE_ENTRIES];
+  for( int ix=0; ix<aocmd_said_sample_num; ix++ ) due[ix]= (int32_t)(now-aocmd_said_sample_entries[ix].nextms)>=0;
+  for( int ix=0; ix<aocmd_said_sample_num; ix++ ) {
+    if( !due[ix] ) continue;
+    aocmd_said_sample_t * e= &aocmd_said_sample_entries[ix];
+    // Collect due entries on the same bus and device that fit in the span
+    int lo= e->raddr;
+    int hi= e->raddr+e->len;
+    uint8_t group[AOCMD_SAID_SAMPLE_ENTRIES];
+    int num= 0;
+    for( int jx=ix; jx<aocmd_said_sample_num; jx++ ) {
+      aocmd_said_sample_t * f= &aocmd_said_sample_entries[jx];
+      if( !due[jx] || f->addr!=e->addr || f->daddr7!=e->daddr7 ) continue;
+      int newlo= f->raddr<lo ? f->raddr : lo;
+      int newhi= f->raddr+f->len>hi ? f->raddr+f->len : hi;
+      if( newhi-newlo>AOCMD_SAID_SAMPLE_SPAN ) continue;
+      lo= newlo; hi= newhi;
+      group[num++]= jx;
+      due[jx]= 0;
+    }
+    // One read for the whole group
+    uint8_t buf[AOCMD_SAID_SAMPLE_SPAN];
+    aoresult_t result= aocmd_said_i2c_readblock(e->addr, e->daddr7, lo, buf, hi-lo);
+    aocmd_said_sample_stats.reads++;
+    if( result!=aoresult_ok ) aocmd_said_sample_stats.fails++;
+    for( int gx=0; gx<num; gx++ ) {
+      aocmd_said_sample_t * f= &aocmd_said_sample_entries[group[gx]];
+      if( result==aoresult_ok ) aocmd_said_sample_put(now, group[gx], buf+f->raddr-lo, f->len);
+      f->nextms+= f->periodms;
+      if( (int32_t)(now-f->nextms)>=0 ) f->nextms= now+f->periodms; // do not catch up on missed periods
+    }
+  }
+}
+
+
+// Shows sampler configuration and status
+static void aocmd_said_sample_show() {
+  for( int ix=0; ix<aocmd_said_sample_num; ix++ ) {
+    aocmd_said_sample_t * e= &aocmd_said_sample_entries[ix];
+    aocmd_cint_printf("sample %d: said(%03X).i2c.dev(%02X).reg(%02X) %d bytes every %lu ms\n", ix, e->addr, e->daddr7, e->raddr, e->len, (unsigned long)e->periodms);
+  }
+  aocmd_cint_printf("sampler: %s%s, %d entries, buffer %d/%d bytes\n", aocmd_said_sample_running?"running":"stopped", aocmd_said_sample_stream?" (stream)":"",
+    aocmd_said_sample_num, aocmd_said_sample_used, AOCMD_SAID_SAMPLE_BUFSIZE );
+  aocmd_cint_printf("sampler: reads %d samples %d drops %d fails %d\n", aocmd_said_sample_stats.reads, aocmd_said_sample_stats.samples, 
+    aocmd_said_sample_stats.drops, aocmd_said_sample_stats.fails );
+}
+
+
+// Parse 'said sample add <addr> <daddr7> <raddr> <len> <period>'
+static void aocmd_said_sample_add( int argc, char * argv[] ) {
+  if( argc!=8 ) { aocmd_cint_printf("ERROR: 'sample add' expects <addr> <daddr7> <raddr> <len> <period>\n"); return; }
+  if( aocmd_said_sample_num==AOCMD_SAID_SAMPLE_ENTRIES ) { aocmd_cint_printf("ERROR: 'sample add' has no free entries (max %d)\n",AOCMD_SAID_SAMPLE_ENTRIES); return; }
+  uint16_t addr, daddr7, raddr, len;
+  int period;
+  if( !aocmd_cint_parse_hex(argv[3],&addr) || !AOOSP_ADDR_ISUNICAST(addr) ) { aocmd_cint_printf("ERROR: 'sample add' expects <addr> %03X..%03X, not '%s'\n",AOOSP_ADDR_UNICASTMIN,AOOSP_ADDR_UNICASTMAX,argv[3]); return; }
+  if( !aocmd_cint_parse_hex(argv[4],&daddr7) || daddr7>0x7F ) { aocmd_cint_printf("ERROR: 'sample add' expects <daddr7> 00..7F, not '%s'\n",argv[4]); return; }
+  if( !aocmd_cint_parse_hex(argv[5],&raddr) || raddr>0xFF ) { aocmd_cint_printf("ERROR: 'sample add' expects <raddr> 00..FF, not '%s'\n",argv[5]); return; }
+  if( !aocmd_cint_parse_hex(argv[6],&len) || len<1 || len>AOCMD_SAID_SAMPLE_MAXLEN || raddr+len>0x100 ) { aocmd_cint_printf("ERROR: 'sample add' expects <len> 1..%d, not '%s'\n",AOCMD_SAID_SAMPLE_MAXLEN,argv[6]); return; }
+  if( !aocmd_cint_parse_dec(argv[7],&period) || period<1 ) { aocmd_cint_printf("ERROR: 'sample add' expects <period> (ms), not '%s'\n",argv[7]); return; }
+  aoresult_t result= aoosp_exec_i2cpower(addr);
+  if( result!=aoresult_ok ) { aocmd_cint_printf("ERROR: i2cpower(%03X) failed (%s)\n", addr, aoresult_to_str(result) ); return; }
+  aocmd_said_sample_t * e= &aocmd_said_sample_entries[aocmd_said_sample_num++];
+  e->addr= addr;
+  e->daddr7= daddr7;
+  e->raddr= raddr;
+  e->len= len;
+  e->periodms= period;
+  e->nextms= millis();
+  if( argv[0][0]!='@' ) aocmd_said_sample_show();
+}
+
+
+// Parse 'said sample [ add ... | clear | start | stop | stream (on|off) | drain ]'
+static void aocmd_said_sample( int argc, char * argv[] ) {
+  if( argc==2 ) { aocmd_said_sample_show(); return; }
+  if( aocmd_cint_isprefix("add",argv[2]) ) {
+    aocmd_said_sample_add(argc,argv);
+    return;
+  } else if( aocmd_cint_isprefix("drain",argv[2]) ) {
+    if( argc!=3 ) { aocmd_cint_printf("ERROR: 'sample drain' has too many args\n"); return; }
+    uint32_t ms; int ix; uint8_t data[AOCMD_SAID_SAMPLE_MAXLEN];
+    int len;
+    while( (len=aocmd_said_sample_get(&ms,&ix,data))>=0 ) aocmd_said_sample_print(ms,ix,data,len);
+    return;
+  } else if( aocmd_cint_isprefix("clear",argv[2]) && argc==3 ) {
+    aocmd_said_sample_num= 0;
+    aocmd_said_sample_running= 0;
+    aocmd_said_sample_head= aocmd_said_sample_tail= aocmd_said_sample_used= 0;
+    memset(&aocmd_said_sample_stats,0,sizeof aocmd_said_sample_stats);
+  } else if( aocmd_cint_isprefix("start",argv[2]) && argc==3 ) {
+    uint32_t now= millis();
+    for( int ix=0; ix<aocmd_said_sample_num; ix++ ) aocmd_said_sample_entries[ix].nextms= now;
+    aocmd_said_sample_running= 1;
+  } else if( aocmd_cint_isprefix("stop",argv[2]) && argc==3 ) {
+    aocmd_said_sample_running= 0;
+  } else if( aocmd_cint_isprefix("stream",argv[2]) && argc==4 ) {
+    if( aocmd_cint_isprefix("on",argv[3]) ) aocmd_said_sample_stream= 1;
+    else if( aocmd_cint_isprefix("off",argv[3]) ) aocmd_said_sample_stream= 0;
+    else { aocmd_cint_printf("ERROR: 'sample stream' expects 'on' or 'off', not '%s'\n",argv[3]); return; }
+  } else {
+    aocmd_cint_printf("ERROR: 'sample' expects 'add', 'clear', 'start', 'stop', 'stream', or 'drain'\n"); return;
+  }
+  if( argv[0][0]!='@' ) aocmd_said_sample_show();
+}
+
 
 // Print the SAID password as it is registered
 static void aocmd_said_password_show() {
   uint64_t pw = aoosp_said_testpw_get();
-  Serial.printf("stored password: %012llX\n", pw  );
+  aocmd_cint_printf("stored password: %012llX\n", (unsigned long long)pw );
 }
 
 
@@ -276,19 +1258,19 @@ static void aocmd_said_password( int argc, char * argv[] ) {
   } else if( argc==3 ) { 
     const char * s= argv[2];
     int len = strlen(s);
-    if( len>12 ) { Serial.printf("ERROR: password too long\n"); return; }
+    if( len>12 ) { aocmd_cint_printf("ERROR: password too long\n"); return; }
     uint64_t pw = 0;
     for( int i=0; i<len; i++ ) {
       char ch = s[i];
       if( '0'<=ch && ch<='9' ) pw= pw*16 + (ch-'0');
       else if( 'a'<=ch && ch<='f' ) pw= pw*16 + (ch-'a'+10);
       else if( 'A'<=ch && ch<='F' ) pw= pw*16 + (ch-'A'+10);
-      else { Serial.printf("ERROR: password expects hex chars, not '%c'\n", ch); return; }
+      else { aocmd_cint_printf("ERROR: password expects hex chars, not '%c'\n", ch); return; }
     }
     aoosp_said_testpw_set(pw);
     if( argv[0][0]!='@' ) aocmd_said_password_show();
   } else {
-    Serial.printf("ERROR: 'password' has too many args\n"); 
+    aocmd_cint_printf("ERROR: 'password' has too many args\n"); 
   }
 }
 
@@ -300,35 +1282,69 @@ static void aocmd_said_main( int argc, char * argv[] ) {
     return;
   }
   
-  if( aoosp_exec_resetinit_last()==0 ) Serial.printf("WARNING: 'osp resetinit' must be run first\n");
+  if( aoosp_exec_resetinit_last()==0 ) aocmd_cint_printf("WARNING: 'osp resetinit' must be run first\n");
   
   if( argc==1 ) {
-    Serial.printf("ERROR: 'said' expects argument\n"); return;
+    aocmd_cint_printf("ERROR: 'said' expects argument\n"); return;
   } else if( aocmd_cint_isprefix("i2c",argv[1]) ) {
     aocmd_said_i2c(argc, argv);
   } else if( aocmd_cint_isprefix("otp",argv[1]) ) {
     aocmd_said_otp(argc, argv);
+  } else if( aocmd_cint_isprefix("sample",argv[1]) ) {
+    aocmd_said_sample(argc, argv);
   } else {
-    Serial.printf("ERROR: 'said' has unknown argument ('%s')\n", argv[1]); return;
+    aocmd_cint_printf("ERROR: 'said' has unknown argument ('%s')\n", argv[1]); return;
   }
 }
 
 
 // The long help text for the "said" command.
 static const char aocmd_said_longhelp[] =
-  "SYNTAX: said i2c <addr> ( scan | freq [<freq>] | <rw> )\n"
+  "SYNTAX: said i2c <addr> ( scan | freq [<freq>|auto] | <rw> )\n"
   "- checks <addr> is a SAID with I2C enabled (OTP), if so powers bus, then\n"
   "- 'scan' scans for I2C devices on bus (<addr> 000 loops over entire chain)\n"
+  "- scan skips reserved <daddr7> (00..07, 78..7F); scans 16 SAIDs in parallel\n"
   "- 'freq' gets or sets I2C bus frequency (in Hz)\n"
+  "- 'freq auto' selects fastest speed at which all devices read back ok\n"
+  "- 'osp resetinit' restores the speeds found by 'freq auto'; on failure the old speed stays\n"
   "- <rw> can be 'write' <daddr7> <raddr> <data>...\n"
   "- this writes the <data> bytes to register <raddr> of i2c device <daddr7>\n"
   "- <rw> can be 'read <daddr7> <raddr> [<count>]'\n"
   "- this reads <count> bytes from register <raddr> of i2c device <daddr7>\n"
+  "- <rw> can be 'writeblock' <daddr7> <raddr> <data>...\n"
+  "- each <data> may have multiple bytes (e.g. 0011AAFF); any length is split\n"
+  "- <rw> can be 'readblock <daddr7> <raddr> <len>' (<len> up to 100-<raddr>)\n"
+  "- block transfers assume register auto-increment; they report bytes/s\n"
+  "- <rw> can be 'watch <daddr7> <raddr> <mask> <value> [<timeout>]'\n"
+  "- this polls until (register & <mask>) equals <value>, or <timeout> (ms, max 600000)\n"
+  "- polling starts at 100us interval, then backs off; reports latency\n"
+  "- pressing a key aborts the watch\n"
   "SYNTAX: said otp <addr> [ <otpaddr> [ <data> ] ]\n"
   "- read/writes OTP memory (customer area) of the SAID at address <addr>\n"
   "- without optional arguments dumps OTP memory\n"
   "- with <otpaddr> reads OTP location <otpaddr>\n"
   "- with <data> writes <data> to OTP location <otpaddr>\n"
+  "SYNTAX: said otp 000 diff [ <addr> | <image> ]\n"
+  "- compares OTP customer area of all SAIDs with a reference, lists deviations\n"
+  "- reference is SAID <addr>, <image>, or else first SAID\n"
+  "- deviations are listed as <otpaddr>:<actual>/<reference>\n"
+  "- OTP is cached (reset, resetinit, and setotp invalidate cache)\n"
+  "SYNTAX: said otp <addr> program <image>\n"
+  "- programs OTP customer area of SAID <addr> (000 for all) to <image>\n"
+  "- only bytes that differ are written (batched, up to 7 per setotp telegram)\n"
+  "- then all are verified by read back\n"
+  "- reports telegrams and time per SAID (requires 'said password')\n"
+  "- <image> is a hex string (OTP 0D..1F), or file:<name> naming a file that\n"
+  "  holds the 19 bytes raw (e.g. 'file upload') or as hex\n"
+  "SYNTAX: said sample [ add <addr> <daddr7> <raddr> <len> <period> ]\n"
+  "- without optional argument shows sampler entries and status\n"
+  "- 'add' adds entry: every <period> ms read <len> (1..8) bytes from <raddr>\n"
+  "- reads on the same SAID and device within 16 registers are combined\n"
+  "SYNTAX: said sample ( clear | start | stop | stream (on|off) | drain )\n"
+  "- 'clear' removes all entries and samples; 'start'/'stop' the sampler\n"
+  "- samples are buffered, 'drain' prints and removes them: <ms> <entry> <data>\n"
+  "- with 'stream on' samples are also printed when taken\n"
+  "- requires application to call aocmd_said_sample_poll() from loop()\n"
   "SYNTAX: said password [ <pw> ]\n"
   "- without optional argument shows the SAID test password in the firmware\n"
   "- with <pw> sets it (FFFFFFFFFFFF triggers warning when PW is needed)\n"
@@ -351,5 +1367,8 @@ static const char aocmd_said_longhelp[] =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_said_register() {
-  return aocmd_cint_register(aocmd_said_main, "said", "sends and receives SAID specific telegrams", aocmd_said_longhelp);
+  return aocmd_cint_register(aocmd_said_main, "said", "sends and receives SAID specific telegrams", AOCMD_LONGHELP(aocmd_said_longhelp));
 }
+
+
+#endif // AOCMD_CONFIG_SAID
@@ -22,10 +22,53 @@
 #define _AOCMD_SAID_H_
 
 
+#include <aoresult.h>     // aoresult_t
+#include <aocmd_config.h> // AOCMD_CONFIG_SAID
+
+
 // Registers the built-in "said" command with the command interpreter.
 int aocmd_said_register();
 
 
+#if AOCMD_CONFIG_SAID
+// Returns 1 if I2C device daddr7 was found on SAID addr in a previous scan, 0 if not, -1 if not scanned.
+int aocmd_said_i2c_scan_cached(uint16_t addr, uint8_t daddr7);
+
+
+// Tunes the I2C speed of SAID addr (fastest that reads back reliably), returns speed code or -1.
+int aocmd_said_i2c_freq_auto(uint16_t addr, int verbose);
+// Returns the speed code found by aocmd_said_i2c_freq_auto for addr, or -1.
+int aocmd_said_i2c_freq_tuned(uint16_t addr);
+// Configures all tuned SAIDs to their tuned speed (e.g. after a chain reset).
+aoresult_t aocmd_said_i2c_freq_restore();
+
+
+// Runs the I2C sampler ('said sample'); call from loop().
+void aocmd_said_sample_poll();
+
+
+// Returns OTP customer area of SAID addr (cached); invalidates the cache for addr (0 for all).
+aoresult_t aocmd_said_otp_cache_get(uint16_t addr, const uint8_t ** otp, int * telecount);
+void aocmd_said_otp_cache_invalidate(uint16_t addr);
+
+
+// Reads/writes len bytes from/to I2C device daddr7 starting at register raddr, via SAID addr (split in legal telegram sizes).
+aoresult_t aocmd_said_i2c_readblock(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t * buf, int len);
+aoresult_t aocmd_said_i2c_writeblock(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, int len);
+#else
+// The "said" command is compiled out (see aocmd_config.h); these stubs keep the callers unchanged.
+static inline int aocmd_said_i2c_scan_cached(uint16_t addr, uint8_t daddr7) { (void)addr; (void)daddr7; return -1; }
+static inline int aocmd_said_i2c_freq_auto(uint16_t addr, int verbose) { (void)addr; (void)verbose; return -1; }
+static inline int aocmd_said_i2c_freq_tuned(uint16_t addr) { (void)addr; return -1; }
+static inline aoresult_t aocmd_said_i2c_freq_restore() { return aoresult_ok; }
+static inline void aocmd_said_sample_poll() {}
+static inline aoresult_t aocmd_said_otp_cache_get(uint16_t addr, const uint8_t ** otp, int * telecount) { (void)addr; (void)otp; (void)telecount; return aoresult_sys_id; }
+static inline void aocmd_said_otp_cache_invalidate(uint16_t addr) { (void)addr; }
+static inline aoresult_t aocmd_said_i2c_readblock(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t * buf, int len) { (void)addr; (void)daddr7; (void)raddr; (void)buf; (void)len; return aoresult_dev_noi2cbridge; }
+static inline aoresult_t aocmd_said_i2c_writeblock(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, int len) { (void)addr; (void)daddr7; (void)raddr; (void)buf; (void)len; return aoresult_dev_noi2cbridge; }
+#endif
+
+
 #endif
 
 
@@ -28,23 +28,26 @@
 #include <aocmd.h>          // AOCMD_VERSION and own
 
 
+#if AOCMD_CONFIG_VERSION
+
+
 /*!
     @brief  The version command prints the version of the various ingredients 
             that make up the application. This function is called by it; it 
-            shall print to Serial the application name and version.
+            shall print to the output sink the application name and version.
     @note   The version command handler calls aocmd_version_app(). The 
             implementation in this library prints an error. It is weakly 
             linked, so a client should itself implement aocmd_version_app().
 */
 void __attribute__((weak)) aocmd_version_app() {
-  Serial.printf( "no application version registered\n" );
+  aocmd_cint_printf( "no application version registered\n" );
 }
 
 
 /*!
     @brief  The version command prints the version of the various ingredients 
             that make up the application. This function is called by it; it 
-            may print to Serial additional ingredients with name and version.
+            may print to the output sink additional ingredients with name and version.
     @note   The version command handler calls aocmd_version_extra(). The 
             implementation in this library is empty. It is weakly linked, 
             so a client could itself implement aocmd_version_extra().
@@ -57,17 +60,18 @@ void __attribute__((weak)) aocmd_version_extra() {
 // The handler for the "version" command
 static void aocmd_version_main( int argc, char * argv[] ) {
   if( argc==1 ) {
-    if( argv[0][0]!='@' ) Serial.printf( "app     : "); 
+    // Note: python/libosplink (osplink.py version()) parses these lines; keep the labels stable
+    if( argv[0][0]!='@' ) aocmd_cint_printf( "app     : "); 
     aocmd_version_app();  
-    if( argv[0][0]!='@' ) Serial.printf( "runtime : Arduino ESP32 " ARDUINO_ESP32_RELEASE "\n" );
-    if( argv[0][0]!='@' ) Serial.printf( "compiler: " __VERSION__ "\n" );
-    if( argv[0][0]!='@' ) Serial.printf( "arduino : %d%s\n",ARDUINO, (ARDUINO<10800?" (likely IDE2.x)":"") );
-    if( argv[0][0]!='@' ) Serial.printf( "compiled: " __DATE__ ", " __TIME__ "\n" );
-    if( argv[0][0]!='@' ) Serial.printf( "aolibs  : result %s spi %s osp %s cmd %s\n", AORESULT_VERSION, AOSPI_VERSION, AOOSP_VERSION, AOCMD_VERSION);
+    if( argv[0][0]!='@' ) aocmd_cint_printf( "runtime : Arduino ESP32 " ARDUINO_ESP32_RELEASE "\n" );
+    if( argv[0][0]!='@' ) aocmd_cint_printf( "compiler: " __VERSION__ "\n" );
+    if( argv[0][0]!='@' ) aocmd_cint_printf( "arduino : %d%s\n",ARDUINO, (ARDUINO<10800?" (likely IDE2.x)":"") );
+    if( argv[0][0]!='@' ) aocmd_cint_printf( "compiled: " __DATE__ ", " __TIME__ "\n" );
+    if( argv[0][0]!='@' ) aocmd_cint_printf( "aolibs  : result %s spi %s osp %s cmd %s\n", AORESULT_VERSION, AOSPI_VERSION, AOOSP_VERSION, AOCMD_VERSION);
     if( argv[0][0]!='@' ) aocmd_version_extra();
     return;
   }
-  Serial.printf("ERROR: 'version' has unknown argument ('%s')\n", argv[1]); return;
+  aocmd_cint_printf("ERROR: 'version' has unknown argument ('%s')\n", argv[1]); return;
 }
 
 
@@ -88,6 +92,8 @@ static const char aocmd_version_longhelp[] =
             its own aocmd_register() then this function could be called from there.
 */
 int aocmd_version_register() {
-  return aocmd_cint_register(aocmd_version_main, "version", "version of this application, its libraries and tools to build it", aocmd_version_longhelp);
+  return aocmd_cint_register(aocmd_version_main, "version", "version of this application, its libraries and tools to build it", AOCMD_LONGHELP(aocmd_version_longhelp));
 }
 
+
+#endif // AOCMD_CONFIG_VERSION
@@ -26,9 +26,9 @@
 int aocmd_version_register();
 
 
-// UPCALL: The "version" command upcalls this function; it shall print to Serial the application name and version.
+// UPCALL: The "version" command upcalls this function; it shall print to the output sink (aocmd_cint_printf) the application name and version.
 void aocmd_version_app();
-// UPCALL: The "version" command upcalls this function; it may print to Serial additional ingredients with name and version.
+// UPCALL: The "version" command upcalls this function; it may print to the output sink additional ingredients with name and version.
 void aocmd_version_extra();
 
 
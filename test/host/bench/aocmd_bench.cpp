@@ -0,0 +1,198 @@
+// aocmd_bench.cpp - measures the command interpreter on recorded workloads (host build)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <Arduino.h>    // Serial, Print
+#include <aospi.h>      // aospi_init()
+#include <aoosp.h>      // aoosp_init()
+#include <aocmd.h>      // generic include for whole aocmd lib
+#include <aohost.h>     // aohost_clock_us(), aohost_chain_config()
+
+
+/*
+DESCRIPTION
+This is the host counterpart of examples/aocmd_bench. It feeds recorded
+workloads (files with command lines, as a host like osplink.py would send
+them) with aocmd_cint_addstr() to the interpreter. The telegrams go to the
+simulated chain (see aohost.h), so workloads that need a chain run too.
+
+Each workload is run twice: once with an output sink that only counts
+bytes, and once with the null sink (which skips formatting). For each run
+it reports the host time (wall clock, so it shows interpreter cost) and
+the simulated time (the ESP32 view: telegrams, node and I2C latencies).
+The UART is not in either figure: the sinks replace it.
+
+USAGE
+  aocmd_bench [--reps <n>] [--chain <spec>] [--lines] <workload.cmd>...
+  --reps   runs each workload <n> times (default 10)
+  --chain  sets the simulated chain (default AOHOST_CHAIN_DEFAULT)
+  --lines  also prints the figures per command line
+
+WORKLOAD FILE
+One command line per line. Empty lines and lines starting with # are skipped,
+except the directive
+  #! chain <spec>   runs this workload on chain <spec> (instead of --chain)
+*/
+
+
+// A workload is a list of command lines (each ending in \n)
+typedef struct bench_workload_s {
+  std::string              name;
+  std::string              chain; // chain spec (empty for --chain or default)
+  std::vector<std::string> lines;
+} bench_workload_t;
+
+
+// Measurement of one line (or a whole workload)
+typedef struct bench_time_s {
+  uint64_t hostns;  // host wall clock
+  uint64_t simus;   // simulated time
+} bench_time_t;
+
+
+// An output sink that only counts the bytes written
+class bench_countsink_c : public Print {
+  public:
+    uint64_t count;
+    size_t write(uint8_t ch) override { (void)ch; count++; return 1; }
+    size_t write(const uint8_t * buf, size_t size) override { (void)buf; count+=size; return size; }
+};
+static bench_countsink_c bench_countsink;
+
+
+// Loads workload from file `path`; returns false if it can not be read
+static bool bench_load(const char * path, bench_workload_t * wl) {
+  std::ifstream in(path);
+  if( !in ) return false;
+  std::string name= path;
+  size_t slash= name.find_last_of('/');
+  if( slash!=std::string::npos ) name= name.substr(slash+1);
+  size_t dot= name.rfind('.');
+  if( dot!=std::string::npos ) name= name.substr(0,dot);
+  wl->name= name;
+  wl->chain.clear();
+  wl->lines.clear();
+  std::string line;
+  while( std::getline(in,line) ) {
+    if( !line.empty() && line.back()=='\r' ) line.pop_back();
+    if( line.compare(0,9,"#! chain ")==0 ) { wl->chain= line.substr(9); continue; }
+    if( line.empty() || line[0]=='#' ) continue;
+    wl->lines.push_back(line+"\n");
+  }
+  return true;
+}
+
+
+// Feeds line `line` to the command interpreter, returns its cost
+static bench_time_t bench_line( const std::string & line ) {
+  std::chrono::steady_clock::time_point t0= std::chrono::steady_clock::now();
+  uint64_t us= aohost_clock_us();
+  aocmd_cint_addstr(line.c_str());
+  bench_time_t t;
+  t.simus= aohost_clock_us()-us;
+  t.hostns= std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-t0).count();
+  return t;
+}
+
+
+// Feeds all lines of workload `wl` `reps` times to the command interpreter; per line totals in `perline` (if not 0)
+static bench_time_t bench_time( const bench_workload_t * wl, int reps, std::vector<bench_time_t> * perline ) {
+  bench_time_t total= {0,0};
+  if( perline ) perline->assign(wl->lines.size(), total);
+  for( int r=0; r<reps; r++ ) {
+    for( size_t i=0; i<wl->lines.size(); i++ ) {
+      bench_time_t t= bench_line(wl->lines[i]);
+      total.hostns+= t.hostns;
+      total.simus+= t.simus;
+      if( perline ) { (*perline)[i].hostns+= t.hostns; (*perline)[i].simus+= t.simus; }
+    }
+  }
+  return total;
+}
+
+
+// Runs workload `wl` `reps` times with the counting sink, and with the null sink, and prints the results
+static void bench_run( const bench_workload_t * wl, int reps, bool showlines, const std::string & chain ) {
+  if( wl->lines.empty() ) { printf("%-10s (no lines)\n", wl->name.c_str()); return; }
+  const std::string & spec= wl->chain.empty() ? chain : wl->chain;
+  if( aohost_chain_config(spec.c_str())<0 ) { printf("%-10s (chain has syntax error in '%s')\n", wl->name.c_str(), spec.c_str()); return; }
+  std::vector<bench_time_t> perline;
+  Print * out= aocmd_cint_out_get();
+  bench_countsink.count= 0;
+  aocmd_cint_out_set(&bench_countsink);
+  bench_time_t t_count= bench_time(wl, reps, &perline);
+  aocmd_cint_out_set(0);
+  bench_time_t t_null= bench_time(wl, reps, 0);
+  aocmd_cint_out_set(out);
+  uint64_t lines= wl->lines.size()*reps;
+  printf("%-10s %5zu %5d %13llu %13llu %13llu %10llu %5d\n", wl->name.c_str(), wl->lines.size(), reps,
+    (unsigned long long)(t_count.hostns/lines), (unsigned long long)(t_null.hostns/lines),
+    (unsigned long long)(t_count.simus/lines), (unsigned long long)(bench_countsink.count/lines), aohost_chain_size() );
+  if( showlines ) {
+    for( size_t i=0; i<wl->lines.size(); i++ ) {
+      std::string cmd= wl->lines[i].substr(0, wl->lines[i].size()-1);
+      printf("  %12llu ns %12llu us  %s\n", (unsigned long long)(perline[i].hostns/reps), (unsigned long long)(perline[i].simus/reps), cmd.c_str());
+    }
+  }
+}
+
+
+int main(int argc, char * argv[]) {
+  int reps= 10;
+  bool showlines= false;
+  std::string chain= AOHOST_CHAIN_DEFAULT;
+  std::vector<bench_workload_t> workloads;
+  for( int i=1; i<argc; i++ ) {
+    std::string arg= argv[i];
+    if( arg=="--reps" && i+1<argc ) {
+      reps= atoi(argv[++i]);
+      if( reps<1 ) { fprintf(stderr, "ERROR: --reps must be positive, not '%s'\n", argv[i]); return 2; }
+    } else if( arg=="--chain" && i+1<argc ) {
+      chain= argv[++i];
+      if( aohost_chain_config(chain.c_str())<0 ) { fprintf(stderr, "ERROR: --chain has syntax error in '%s'\n", argv[i]); return 2; }
+    } else if( arg=="--lines" ) {
+      showlines= true;
+    } else if( arg[0]=='-' ) {
+      fprintf(stderr, "ERROR: unknown option '%s'\n", arg.c_str()); return 2;
+    } else {
+      bench_workload_t wl;
+      if( !bench_load(argv[i], &wl) ) { fprintf(stderr, "ERROR: can not read workload '%s'\n", argv[i]); return 2; }
+      workloads.push_back(wl);
+    }
+  }
+  if( workloads.empty() ) { fprintf(stderr, "SYNTAX: aocmd_bench [--reps <n>] [--chain <spec>] [--lines] <workload.cmd>...\n"); return 2; }
+
+  // Startup output (banners) is not of interest
+  std::string startup;
+  aohost_serial_capture(&startup);
+  Serial.begin(115200);
+  aospi_init();
+  aoosp_init();
+  aocmd_init();
+  aocmd_register();
+  aohost_serial_capture(0);
+
+  printf("workload   lines  reps ns/line(host) ns/line(null)  us/line(sim) bytes/line nodes\n");
+  for( size_t i=0; i<workloads.size(); i++ ) bench_run(&workloads[i], reps, showlines, chain);
+  return 0;
+}
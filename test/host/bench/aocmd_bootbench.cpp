@@ -0,0 +1,171 @@
+// aocmd_bootbench.cpp - times boot.cmd on power-on, precompiled versus interpreted (host build)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <Arduino.h>    // Serial
+#include <aospi.h>      // aospi_init()
+#include <aoosp.h>      // aoosp_init()
+#include <aocmd.h>      // generic include for whole aocmd lib
+#include <aohost.h>     // aohost_clock_us(), aohost_chain_ontx(), aohost_nvs_putfail()
+
+
+/*
+DESCRIPTION
+Measures what precompiling boot.cmd buys at startup. A boot script is
+stored as boot.cmd (with aocmd_file_write) and run the way an application
+runs it on power-on: aocmd_file_bootcmd_exec_on_por(). Each run starts on
+a freshly plugged chain and measures up to the first telegram (aospi_tx or
+aospi_txrx, so typically "time to first light") and up to the end of the
+script.
+
+The script runs in two modes:
+  precompiled   the precompiled form (NVS key ~bootbin) is used
+  interpreted   the precompiled form can not be stored (NVS put fails, as
+                when NVS is full), so the text is fed to the interpreter;
+                this includes the compile attempt that fails
+For both it reports the host time (wall clock, so it shows interpreter
+cost) and the simulated time (the ESP32 view: UART, telegrams, latencies).
+The output goes to the (simulated) UART, as on a board.
+
+USAGE
+  aocmd_bootbench [--reps <n>] [--chain <spec>] <boot.cmd>
+  --reps   runs each mode <n> times (default 100)
+  --chain  sets the simulated chain (default AOHOST_CHAIN_DEFAULT)
+*/
+
+
+// Host and simulated time at the start of the first telegram of a run
+static bool                                  bootbench_txseen;
+static std::chrono::steady_clock::time_point bootbench_txhost;
+static uint64_t                              bootbench_txsim;
+
+
+// Called by the simulated chain at the start of each telegram
+static void bootbench_ontx() {
+  if( bootbench_txseen ) return;
+  bootbench_txseen= true;
+  bootbench_txhost= std::chrono::steady_clock::now();
+  bootbench_txsim= aohost_clock_us();
+}
+
+
+// Measurement of one mode (totals over all runs)
+typedef struct bootbench_time_s {
+  uint64_t txhostns;  // host wall clock up to the first telegram
+  uint64_t txsimus;   // simulated time up to the first telegram
+  uint64_t hostns;    // host wall clock of the whole script
+  uint64_t simus;     // simulated time of the whole script
+  int      notx;      // runs without a telegram
+} bootbench_time_t;
+
+
+// Runs boot.cmd `reps` times as on power-on, each time on a freshly plugged chain `spec`
+static bootbench_time_t bootbench_run(int reps, const std::string & spec) {
+  bootbench_time_t t= {0,0,0,0,0};
+  std::string output;
+  aohost_serial_capture(&output);
+  for( int r=0; r<reps; r++ ) {
+    aohost_chain_config(spec.c_str());
+    aohost_reset_reason_set(ESP_RST_POWERON);
+    output.clear();
+    Serial.flush(); // start with an empty UART
+    bootbench_txseen= false;
+    std::chrono::steady_clock::time_point t0= std::chrono::steady_clock::now();
+    uint64_t us= aohost_clock_us();
+    aocmd_file_bootcmd_exec_on_por();
+    Serial.flush();
+    std::chrono::steady_clock::time_point t1= std::chrono::steady_clock::now();
+    t.hostns+= std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count();
+    t.simus+= aohost_clock_us()-us;
+    if( !bootbench_txseen ) { t.notx++; continue; }
+    t.txhostns+= std::chrono::duration_cast<std::chrono::nanoseconds>(bootbench_txhost-t0).count();
+    t.txsimus+= bootbench_txsim-us;
+  }
+  aohost_serial_capture(0);
+  return t;
+}
+
+
+// Prints the results of mode `name`
+static void bootbench_print(const char * name, const bootbench_time_t * t, int reps) {
+  int txreps= reps-t->notx;
+  if( txreps==0 ) { printf("%-12s %5d %16s %16s", name, reps, "-", "-"); }
+  else printf("%-12s %5d %16llu %16llu", name, reps, (unsigned long long)(t->txhostns/txreps), (unsigned long long)(t->txsimus/txreps) );
+  printf(" %16llu %16llu\n", (unsigned long long)(t->hostns/reps), (unsigned long long)(t->simus/reps) );
+}
+
+
+int main(int argc, char * argv[]) {
+  int reps= 100;
+  std::string chain= AOHOST_CHAIN_DEFAULT;
+  const char * path= 0;
+  for( int i=1; i<argc; i++ ) {
+    std::string arg= argv[i];
+    if( arg=="--reps" && i+1<argc ) {
+      reps= atoi(argv[++i]);
+      if( reps<1 ) { fprintf(stderr, "ERROR: --reps must be positive, not '%s'\n", argv[i]); return 2; }
+    } else if( arg=="--chain" && i+1<argc ) {
+      chain= argv[++i];
+      if( aohost_chain_config(chain.c_str())<0 ) { fprintf(stderr, "ERROR: --chain has syntax error in '%s'\n", argv[i]); return 2; }
+    } else if( arg[0]=='-' || path!=0 ) {
+      fprintf(stderr, "ERROR: unexpected argument '%s'\n", arg.c_str()); return 2;
+    } else {
+      path= argv[i];
+    }
+  }
+  if( path==0 ) { fprintf(stderr, "SYNTAX: aocmd_bootbench [--reps <n>] [--chain <spec>] <boot.cmd>\n"); return 2; }
+  std::ifstream in(path, std::ios::binary);
+  if( !in ) { fprintf(stderr, "ERROR: can not read boot script '%s'\n", path); return 2; }
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string script= ss.str();
+
+  // Startup output (banners) is not of interest
+  std::string startup;
+  aohost_serial_capture(&startup);
+  aohost_nvs_clear();
+  Serial.begin(115200);
+  aospi_init();
+  aoosp_init();
+  aocmd_init();
+  aocmd_register();
+  aohost_serial_capture(0);
+  aohost_chain_ontx(bootbench_ontx);
+
+  // Precompiled: writing boot.cmd compiles it
+  aohost_nvs_putfail(0);
+  if( aocmd_file_write("boot.cmd", script.c_str(), (int)script.size())!=(int)script.size() ) { fprintf(stderr, "ERROR: can not store '%s' as boot.cmd\n", path); return 2; }
+  bootbench_run(1, chain); // warm up (caches, allocations)
+  bootbench_time_t t_bin= bootbench_run(reps, chain);
+  // Interpreted: rewriting boot.cmd drops the precompiled form, and it can not be stored again
+  aohost_nvs_putfail("~bootbin");
+  aocmd_file_write("boot.cmd", script.c_str(), (int)script.size());
+  bootbench_run(1, chain); // warm up (caches, allocations)
+  bootbench_time_t t_txt= bootbench_run(reps, chain);
+  aohost_nvs_putfail(0);
+
+  printf("mode          reps  ns(host) to tx    us(sim) to tx   ns(host) total    us(sim) total\n");
+  bootbench_print("precompiled", &t_bin, reps);
+  bootbench_print("interpreted", &t_txt, reps);
+  return 0;
+}
@@ -0,0 +1,21 @@
+// boot.cmd of a demo: run on power-on-reset
+// =========================================
+// The chain is reset and initialized, then all nodes are switched on.
+// Comments like these are stripped by the precompiled form.
+
+// Announce (useful on the serial console of the demo)
+echo line
+echo Demo configuration
+@echo wait 0
+
+// Bring up the chain
+osp resetinit
+osp send 000 clrerror
+osp send 000 goactive
+
+// All channels on, low brightness (SAID has 3 channels, RGBI 1)
+osp send 001 setpwmchn 00 00 00 10 00 10 00 10
+osp send 002 setpwm 00 10 00 10 00 10
+osp send 003 setpwmchn 00 00 00 10 00 10 00 10
+osp send 004 setpwm 00 10 00 10 00 10
+echo Demo running
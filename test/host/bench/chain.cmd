@@ -0,0 +1,12 @@
+# A typical host sequence to switch on the first node, then query the chain
+osp resetinit
+osp send 001 clrerror
+osp send 001 goactive
+osp send 001 setpwmchn 00 FF 33 33 00 00 00 00
+osp send 001 readstat
+osp send 001 readpwmchn 00
+osp send 002 readtempstat
+osp send 003 identify
+osp trx A0 04 40 11
+osp locate error
+osp enum
@@ -0,0 +1,9 @@
+# Commands that do not send telegrams (as in examples/aocmd_bench)
+echo line Hello, world!
+help osp send
+osp fields A0 04 02 A9
+osp info setpwmchn
+osp format
+file list
+version
+@echo wait 0 // comment
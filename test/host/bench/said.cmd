@@ -0,0 +1,11 @@
+# SAID I2C and OTP traffic (node 001 is a SAID with I2C bridge)
+osp resetinit
+said i2c 001 scan
+said i2c 001 read 50 00 8
+said i2c 001 write 48 04 5A
+said i2c 001 readblock 50 00 40
+said i2c 001 writeblock 50 80 00112233445566778899AABBCCDDEEFF
+said i2c 001 freq 400000
+said i2c 001 watch 48 04 FF 5A
+said otp 001 0D
+said otp 000 diff
@@ -0,0 +1,12 @@
+# I2C bus scan on a chain of 8 SAIDs with I2C: pipelined over the chain (000) versus one SAID at a time
+#! chain said:i2c said:i2c said:i2c said:i2c said:i2c said:i2c said:i2c said:i2c
+osp resetinit
+said i2c 000 scan
+said i2c 001 scan
+said i2c 002 scan
+said i2c 003 scan
+said i2c 004 scan
+said i2c 005 scan
+said i2c 006 scan
+said i2c 007 scan
+said i2c 008 scan
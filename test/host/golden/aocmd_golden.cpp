@@ -0,0 +1,286 @@
+// aocmd_golden.cpp - replays command scripts and checks output and time against golden files (host build)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Arduino.h>    // Serial
+#include <aospi.h>      // aospi_init()
+#include <aoosp.h>      // aoosp_init()
+#include <aocmd.h>      // generic include for whole aocmd lib
+#include <aohost.h>     // aohost_clock_us(), aohost_chain_config(), aohost_serial_feed()
+
+
+/*
+DESCRIPTION
+Replays a command script through the command interpreter. The lines are fed
+via Serial (as a host like osplink.py would send them) and the telegrams go
+to the simulated chain (see aohost.h). The output is compared with a golden
+output file, and the simulated time of each command line with its budget
+from a golden time file. Any output drift, or a command line that takes
+more than the tolerance above its budget, fails the run.
+
+The time of a command line runs from feeding it until its output has left
+the UART (Serial.flush()), so it includes telegrams, node and I2C latencies,
+and output volume. Since time is simulated, runs are reproducible.
+
+USAGE
+  aocmd_golden [--update] [--tolerance <pct>] [--actual <dir>] <script.cmd>
+  --update     (re)writes the golden files from this run instead of checking
+  --tolerance  a command line may take <pct> percent over its budget (default 10)
+  --actual     on drift, writes the actual output to <dir>/<script>.out
+
+SCRIPT FILE <name>.cmd
+Every line is sent to the command interpreter, also empty lines (they end
+e.g. 'file record'). Lines starting with # are not sent; they are comments
+or one of these directives
+  #! chain <spec>   sets the simulated chain (default AOHOST_CHAIN_DEFAULT)
+  #! mask <prefix>  output lines starting with <prefix> are reduced to <prefix>*
+                    (for output that differs per build, like the compile date)
+  #! data <text>    sends <text> and a newline right after the preceding command
+                    line, in the same feed (raw input, e.g. for 'file upload')
+
+GOLDEN FILES
+  <name>.out        the output (CR stripped, masks applied)
+  <name>.time       per command line: the budget in simulated us, then the line
+
+EXIT
+0 pass, 1 fail (drift, over budget, or stale golden files), 2 usage error
+*/
+
+
+// A script: its command lines, and its directives
+typedef struct golden_script_s {
+  std::string              name;   // script file name without directory and .cmd
+  std::string              base;   // script path without .cmd (golden files are base.out and base.time)
+  std::string              chain;  // chain spec (empty for default)
+  std::vector<std::string> masks;  // output line prefixes to mask
+  std::vector<std::string> lines;  // command lines (without \n)
+  std::vector<std::string> data;   // per command line: raw input sent right after it (with \n)
+} golden_script_t;
+
+
+// Reads whole file `path` into `text`; returns false if it can not be read
+static bool golden_read(const std::string & path, std::string * text) {
+  std::ifstream in(path, std::ios::binary);
+  if( !in ) return false;
+  std::stringstream ss;
+  ss << in.rdbuf();
+  *text= ss.str();
+  return true;
+}
+
+
+// Writes `text` to file `path`; returns false if it can not be written
+static bool golden_write(const std::string & path, const std::string & text) {
+  std::ofstream out(path, std::ios::binary);
+  if( !out ) return false;
+  out << text;
+  return (bool)out;
+}
+
+
+// Splits `text` in lines (a trailing \n does not start a new line)
+static std::vector<std::string> golden_split(const std::string & text) {
+  std::vector<std::string> lines;
+  std::stringstream ss(text);
+  std::string line;
+  while( std::getline(ss,line) ) lines.push_back(line);
+  return lines;
+}
+
+
+// Loads script from `path`; returns false (with message) on error
+static bool golden_load(const char * path, golden_script_t * script) {
+  std::string text;
+  if( !golden_read(path,&text) ) { fprintf(stderr, "ERROR: can not read script '%s'\n", path); return false; }
+  script->base= path;
+  size_t dot= script->base.rfind(".cmd");
+  if( dot==std::string::npos || dot+4!=script->base.size() ) { fprintf(stderr, "ERROR: script '%s' must end in .cmd\n", path); return false; }
+  script->base= script->base.substr(0,dot);
+  size_t slash= script->base.find_last_of('/');
+  script->name= slash==std::string::npos ? script->base : script->base.substr(slash+1);
+  std::vector<std::string> lines= golden_split(text);
+  for( size_t i=0; i<lines.size(); i++ ) {
+    std::string line= lines[i];
+    if( !line.empty() && line.back()=='\r' ) line.pop_back();
+    if( line.compare(0,9,"#! chain ")==0 ) {
+      script->chain= line.substr(9);
+    } else if( line.compare(0,8,"#! mask ")==0 ) {
+      script->masks.push_back(line.substr(8));
+    } else if( line.compare(0,8,"#! data ")==0 ) {
+      if( script->lines.empty() ) { fprintf(stderr, "ERROR: %s:%zu: 'data' without preceding command line\n", path, i+1); return false; }
+      script->data.back()+= line.substr(8)+"\n";
+    } else if( line.compare(0,2,"#!")==0 ) {
+      fprintf(stderr, "ERROR: %s:%zu: unknown directive '%s'\n", path, i+1, line.c_str()); return false;
+    } else if( line.empty() || line[0]!='#' ) {
+      script->lines.push_back(line);
+      script->data.push_back("");
+    }
+  }
+  return true;
+}
+
+
+// Strips CR and applies the masks of `script` to `output`
+static std::string golden_normalize(const golden_script_t * script, const std::string & output) {
+  std::vector<std::string> lines= golden_split(output);
+  std::string result;
+  for( size_t i=0; i<lines.size(); i++ ) {
+    std::string line;
+    for( size_t j=0; j<lines[i].size(); j++ ) if( lines[i][j]!='\r' ) line.push_back(lines[i][j]);
+    for( size_t m=0; m<script->masks.size(); m++ ) {
+      if( line.compare(0,script->masks[m].size(),script->masks[m])==0 ) { line= script->masks[m]+"*"; break; }
+    }
+    result+= line+"\n";
+  }
+  return result;
+}
+
+
+// Feeds all lines of `script` via Serial; returns output in `output` and the simulated time per line in `times`
+static void golden_replay(const golden_script_t * script, std::string * output, std::vector<uint64_t> * times) {
+  aohost_serial_capture(output);
+  aocmd_cint_prompt();
+  for( size_t i=0; i<script->lines.size(); i++ ) {
+    uint64_t t0= aohost_clock_us();
+    aohost_serial_feed( (script->lines[i]+"\n"+script->data[i]).c_str() );
+    while( aohost_serial_pending()>0 ) aocmd_cint_pollserial();
+    Serial.flush();
+    times->push_back( aohost_clock_us()-t0 );
+  }
+  aohost_serial_capture(0);
+}
+
+
+// Compares `actual` with `expected` output; returns false (with message on first drift) if they differ
+static bool golden_check_output(const golden_script_t * script, const std::string & expected, const std::string & actual) {
+  if( expected==actual ) return true;
+  std::vector<std::string> exp= golden_split(expected);
+  std::vector<std::string> act= golden_split(actual);
+  size_t i= 0;
+  while( i<exp.size() && i<act.size() && exp[i]==act[i] ) i++;
+  fprintf(stderr, "DRIFT: %s.out line %zu\n", script->name.c_str(), i+1);
+  fprintf(stderr, "  expected: %s\n", i<exp.size() ? exp[i].c_str() : "<end of output>");
+  fprintf(stderr, "  actual  : %s\n", i<act.size() ? act[i].c_str() : "<end of output>");
+  return false;
+}
+
+
+// Formats the time file for `script` with `times` as budgets
+static std::string golden_format_times(const golden_script_t * script, const std::vector<uint64_t> & times) {
+  std::string text;
+  char buf[32];
+  for( size_t i=0; i<script->lines.size(); i++ ) {
+    snprintf(buf, sizeof buf, "%8llu  ", (unsigned long long)times[i]);
+    text+= buf + script->lines[i] + "\n";
+  }
+  return text;
+}
+
+
+// Checks `times` against the budgets in `budgettext`; returns false (with messages) on stale budgets or regressions
+static bool golden_check_times(const golden_script_t * script, const std::string & budgettext, const std::vector<uint64_t> & times, int tolerance) {
+  std::vector<std::string> budgets= golden_split(budgettext);
+  if( budgets.size()!=script->lines.size() ) {
+    fprintf(stderr, "STALE: %s.time has %zu lines, script has %zu (run with --update)\n", script->name.c_str(), budgets.size(), script->lines.size());
+    return false;
+  }
+  bool ok= true;
+  for( size_t i=0; i<budgets.size(); i++ ) {
+    char * end;
+    unsigned long long budget= strtoull(budgets[i].c_str(), &end, 10);
+    while( *end==' ' ) end++;
+    if( end==budgets[i].c_str() || script->lines[i]!=end ) {
+      fprintf(stderr, "STALE: %s.time line %zu is for '%s' not for '%s' (run with --update)\n", script->name.c_str(), i+1, end, script->lines[i].c_str());
+      return false;
+    }
+    if( times[i]*100 > budget*(100+tolerance) ) {
+      fprintf(stderr, "TIME: %s line %zu '%s' took %llu us, budget %llu us +%d%%\n", script->name.c_str(), i+1, script->lines[i].c_str(), (unsigned long long)times[i], budget, tolerance);
+      ok= false;
+    }
+  }
+  return ok;
+}
+
+
+int main(int argc, char * argv[]) {
+  bool update= false;
+  int tolerance= 10;
+  std::string actualdir;
+  const char * path= 0;
+  for( int i=1; i<argc; i++ ) {
+    std::string arg= argv[i];
+    if( arg=="--update" ) {
+      update= true;
+    } else if( arg=="--tolerance" && i+1<argc ) {
+      tolerance= atoi(argv[++i]);
+      if( tolerance<0 ) { fprintf(stderr, "ERROR: --tolerance must not be negative, not '%s'\n", argv[i]); return 2; }
+    } else if( arg=="--actual" && i+1<argc ) {
+      actualdir= argv[++i];
+    } else if( arg[0]=='-' || path!=0 ) {
+      fprintf(stderr, "ERROR: unexpected argument '%s'\n", arg.c_str()); return 2;
+    } else {
+      path= argv[i];
+    }
+  }
+  if( path==0 ) { fprintf(stderr, "SYNTAX: aocmd_golden [--update] [--tolerance <pct>] [--actual <dir>] <script.cmd>\n"); return 2; }
+
+  golden_script_t script;
+  if( !golden_load(path, &script) ) return 2;
+  if( !script.chain.empty() && aohost_chain_config(script.chain.c_str())<0 ) { fprintf(stderr, "ERROR: %s: chain has syntax error in '%s'\n", path, script.chain.c_str()); return 2; }
+
+  // Startup output (banners) is not part of the golden output
+  std::string startup;
+  aohost_serial_capture(&startup);
+  Serial.begin(115200);
+  aospi_init();
+  aoosp_init();
+  aocmd_init();
+  aocmd_register();
+  aohost_serial_capture(0);
+
+  std::string output;
+  std::vector<uint64_t> times;
+  golden_replay(&script, &output, &times);
+  output= golden_normalize(&script, output);
+
+  if( update ) {
+    if( !golden_write(script.base+".out", output) || !golden_write(script.base+".time", golden_format_times(&script,times)) ) {
+      fprintf(stderr, "ERROR: can not write golden files for '%s'\n", path); return 2;
+    }
+    printf("%s: updated (%zu lines)\n", script.name.c_str(), script.lines.size());
+    return 0;
+  }
+
+  std::string expected, budgets;
+  if( !golden_read(script.base+".out", &expected) || !golden_read(script.base+".time", &budgets) ) {
+    fprintf(stderr, "STALE: %s has no golden files (run with --update)\n", script.name.c_str()); return 1;
+  }
+  bool outok= golden_check_output(&script, expected, output);
+  if( !outok && !actualdir.empty() ) golden_write(actualdir+"/"+script.name+".out", output);
+  bool timeok= golden_check_times(&script, budgets, times, tolerance);
+  uint64_t total= 0;
+  for( size_t i=0; i<times.size(); i++ ) total+= times[i];
+  printf("%s: %zu lines, %llu us, output %s, time %s\n", script.name.c_str(), script.lines.size(), (unsigned long long)total,
+    outok ? "ok" : "DRIFT", timeok ? "ok" : "OVER BUDGET" );
+  return outok && timeok ? 0 : 1;
+}
@@ -0,0 +1,14 @@
+# echo: plain, lines, faults, wait, @-suppression and comments
+echo
+echo Hello, world!
+echo line Hello, world!
+echo   spaced    words  
+@echo silent
+echo faults
+echo faults step
+echo faults
+echo wait 5
+echo wait 0
+echo // only a comment
+echo before // a comment
+echo line
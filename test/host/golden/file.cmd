@@ -0,0 +1,21 @@
+# file: record, list, show, append, exec, delete, and errors
+file list
+file record test.cmd
+echo line from file
+echo faults
+
+file list
+file show test.cmd
+file append test.cmd
+echo line appended
+
+file show test.cmd
+file exec test.cmd
+file record
+@echo line boot
+
+file list
+file delete test.cmd
+file list
+file show test.cmd
+file record bad/name
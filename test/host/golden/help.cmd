@@ -0,0 +1,11 @@
+# help: command list, per command help, prefixes and errors
+help
+help echo
+help ec
+help version
+help file
+help said
+help osp
+help osp send
+help osp fields
+help bogus
@@ -0,0 +1,17 @@
+# multi: several commands on one line, ';' always runs the next, '&&' only after no ERROR
+echo one ; echo two
+echo three && echo four
+echo five ; bogus ; echo six
+bogus && echo not printed
+bogus && echo not printed ; echo printed
+osp resetinit && osp send 001 identify
+osp send 001 bogus && echo not printed
+@osp send 001 identify ; echo loud
+echo line ; ; echo empty command in between
+file record multi.cmd
+echo a ; echo b
+bogus && echo c
+
+file show multi.cmd
+file exec multi.cmd
+file delete multi.cmd
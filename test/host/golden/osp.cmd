@@ -0,0 +1,31 @@
+# osp: init, send, trx, format, count, log, enum, locate against the default chain
+osp
+osp resetinit
+osp count reset
+osp send 001 clrerror
+osp send 001 goactive
+osp send 001 setpwmchn 00 FF 33 33 00 00 00 00
+osp send 001 readpwmchn 00
+osp send 001 readstat
+osp send 002 readtempstat
+osp send 003 identify
+osp send 004 readcomst
+osp format fields
+osp send 002 readtemp
+osp format compact
+osp send 003 identify
+osp format raw
+osp trx A0 04 40 11
+osp log tele
+osp resetinit
+osp log args
+osp send 001 readstat
+osp resetinit
+osp log none
+osp count
+osp locate error
+osp locate temp 80
+osp locate temp F0
+osp enum
+osp send 3FF identify
+osp send 3F1 identify
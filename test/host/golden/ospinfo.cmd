@@ -0,0 +1,11 @@
+# osp info and osp fields: offline telegram tables and dissection
+osp info
+osp info setpwmchn
+osp info readcomst
+osp info i2c
+osp info bogus
+osp fields A0 04 02 A9
+osp fields A0 07 CF 00 FF 33 33 00 00 00 00 5E
+osp fields A0 04 02 AA
+osp fields A0
+osp aoresult spi
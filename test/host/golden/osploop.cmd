@@ -0,0 +1,6 @@
+# osp: resetinit and enum on a chain wired as loop
+#! chain rgbi said rgbi loop
+osp resetinit
+osp enum
+osp send 002 readcomst
+osp dirmux
@@ -0,0 +1,18 @@
+# said otp program/diff: hex image, file: image, batched setotp writes with read-back verify, and errors
+osp resetinit
+said password 5A1D5A1D5A1D
+said otp 000 diff
+said otp 000 program 0800000000000000000000000000000011223344
+said otp 000 program 08000000000000000000000000000000112233
+said otp 000 program 0A0000C0FFEE00000000000000000000000001
+said otp 002 program 0A0000C0FFEE00000000000000000000000001
+said otp 000 diff
+file record otp.img
+08 00 00 00 00 00 00 00 00 00
+00 00 00 00 00 00 11 22 33
+
+said otp 003 program file:otp.img
+said otp 000 diff file:otp.img
+said otp 001 program file:none.img
+said otp 003 program 0A0000C0FFEE00000000000000000000000001
+file delete otp.img
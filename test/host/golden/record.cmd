@@ -0,0 +1,24 @@
+# osp record/replay: record telegrams with their timing, list them, replay at speed, and errors
+osp resetinit
+osp record
+osp replay
+osp record start
+osp record
+osp send 001 identify
+osp send 000 goactive
+echo wait 10
+osp send 003 readstat
+osp send 001 setpwmchn 00 00 00 10 00 10 00 10
+echo wait 200
+osp send 002 readstat
+osp record stop
+osp record
+osp record list
+osp replay
+osp replay 2
+osp replay 1 50
+osp replay 0
+osp record bogus
+osp record start
+osp record stop
+osp record list
@@ -0,0 +1,22 @@
+# said: i2c scan/read/write/block/freq/watch and otp on the default chain
+said i2c 001 scan
+osp resetinit
+said i2c 001 scan
+said i2c 003 scan
+said i2c 002 scan
+said i2c 001 read 50 00 8
+said i2c 001 write 48 04 5A
+said i2c 001 read 48 04
+said i2c 001 read 33 00
+said i2c 001 readblock 50 00 40
+said i2c 001 writeblock 50 80 00112233445566778899AABBCCDDEEFF
+said i2c 001 readblock 50 80 10
+said i2c 001 freq
+said i2c 001 freq 400000
+said i2c 001 watch 48 04 FF 5A
+said i2c 001 watch 48 04 FF 00 5
+said i2c 001 freq auto
+said otp 001 0D
+said otp 001
+said otp 000 diff
+said password
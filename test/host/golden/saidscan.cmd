@@ -0,0 +1,12 @@
+# said i2c 000 scan (pipelined over the chain) versus scanning one SAID at a time, on 8 SAIDs with I2C
+#! chain said:i2c said:i2c said:i2c said:i2c said:i2c said:i2c said:i2c said:i2c
+osp resetinit
+said i2c 000 scan
+said i2c 001 scan
+said i2c 002 scan
+said i2c 003 scan
+said i2c 004 scan
+said i2c 005 scan
+said i2c 006 scan
+said i2c 007 scan
+said i2c 008 scan
@@ -0,0 +1,37 @@
+# file upload: raw bytes after the command line (flow control credits), crc check, and errors
+file upload up.cmd 14 D44DA900
+#! data echo uploaded
+file list
+file show up.cmd
+file exec up.cmd
+# more than the window of 2 blocks (256 bytes): a further credit is granted while receiving
+file upload big.cmd 300 62BC143C
+#! data echo upload line 00
+#! data echo upload line 01
+#! data echo upload line 02
+#! data echo upload line 03
+#! data echo upload line 04
+#! data echo upload line 05
+#! data echo upload line 06
+#! data echo upload line 07
+#! data echo upload line 08
+#! data echo upload line 09
+#! data echo upload line 10
+#! data echo upload line 11
+#! data echo upload line 12
+#! data echo upload line 13
+#! data echo upload line 14
+file show big.cmd
+# fewer bytes than announced
+file upload short.cmd 20 00000000
+#! data echo short
+@file upload up2.cmd 28 00000000
+#! data echo uploaded
+#! data echo uploaded
+file upload up.cmd 14
+file upload up.cmd 99999 0
+file upload up.cmd 14 xyz
+file upload bad/name 14 D44DA900
+file list
+file delete up.cmd
+file delete big.cmd
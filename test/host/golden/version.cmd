@@ -0,0 +1,5 @@
+# version: library versions; build specific lines masked
+#! mask compiler:
+#! mask compiled:
+version
+version extra
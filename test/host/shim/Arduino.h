@@ -0,0 +1,134 @@
+// Arduino.h - host stand-in for the Arduino ESP32 core (the parts used by aocmd)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _ARDUINO_H_
+#define _ARDUINO_H_
+
+
+// This is not the Arduino core. It is the subset that library aocmd uses,
+// implemented on the host (see arduino.cpp), so that aocmd can be built
+// and tested without an ESP32. Time is simulated (see aohost.h).
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <limits.h>
+#include <esp32-hal-cpu.h>
+#include <freertos/FreeRTOS.h> // like esp32-hal.h, Arduino.h brings in the task API
+#include <freertos/task.h>
+
+
+#define LOW  0x0
+#define HIGH 0x1
+
+#ifndef BIT
+#define BIT(nr) (1UL << (nr)) // from esp_bit_defs.h
+#endif
+
+
+// Flash strings: on ESP32 flash is memory mapped, so these are plain pointers
+class __FlashStringHelper;
+#define F(s)                  ((const __FlashStringHelper *)(s))
+#define PSTR(s)               (s)
+#define PROGMEM
+#define pgm_read_byte(p)      (*(const uint8_t *)(p))
+#define memcpy_P              memcpy
+#define strlen_P              strlen
+#define vsnprintf_P           vsnprintf
+
+
+typedef uint8_t byte;
+
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t ch) = 0;
+    virtual size_t write(const uint8_t * buf, size_t size);
+    size_t write(const char * s) { return write((const uint8_t *)s, strlen(s)); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+    size_t printf(const char * fmt, ...) __attribute__((format(printf,2,3)));
+    size_t print(const char * s);
+    size_t print(const __FlashStringHelper * s);
+    size_t print(char ch);
+    size_t print(int val);
+    size_t println(const char * s);
+    size_t println(const __FlashStringHelper * s);
+    size_t println(int val);
+    size_t println();
+};
+
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+
+// The UART: reads chars queued with aohost_serial_feed(), writes to stdout or a capture (see aohost.h).
+// Writing takes simulated time at the configured baud rate once the 128 byte TX FIFO is full.
+class HardwareSerial : public Stream {
+  public:
+    void   begin(unsigned long baud);
+    void   end() {}
+    size_t write(uint8_t ch) override;
+    size_t write(const uint8_t * buf, size_t size) override;
+    using  Print::write;
+    int    availableForWrite() override;
+    void   flush() override;
+    int    available() override;
+    int    read() override;
+    int    peek() override;
+    operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+
+// Simulated time
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+
+class EspClass {
+  public:
+    const char * getChipModel();
+    uint8_t  getChipCores();
+    uint8_t  getChipRevision();
+    uint32_t getSketchSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    void     restart();
+};
+extern EspClass ESP;
+
+
+#endif
@@ -0,0 +1,46 @@
+// Preferences.h - host stand-in for the NVS key/value store
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _PREFERENCES_H_
+#define _PREFERENCES_H_
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+// RAM backed; content survives until aohost_nvs_clear() (like a reboot keeps it).
+class Preferences {
+  public:
+    Preferences() : _ns(0), _ro(true) {}
+    bool   begin(const char * name, bool readOnly=false);
+    void   end();
+    size_t putBytes(const char * key, const void * value, size_t len);
+    size_t getBytes(const char * key, void * buf, size_t maxLen);
+    size_t getBytesLength(const char * key);
+    bool   remove(const char * key);
+    bool   isKey(const char * key);
+  private:
+    const char * _ns;
+    bool         _ro;
+};
+
+
+#endif
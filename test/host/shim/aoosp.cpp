@@ -0,0 +1,363 @@
+// aoosp.cpp - host implementation of the aoosp shim (frames real telegrams, sends them via aospi)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <Arduino.h>    // Serial
+#include <aoosp.h>      // own
+
+
+// Only the functions aocmd uses are here. Like the real library, every send function frames one
+// telegram and sends it with aospi_tx() or aospi_txrx(); the exec functions combine several.
+
+
+#define AOOSP_RESET_US        150  // wait after a reset before the next telegram
+#define AOOSP_I2C_POLLS       200  // readi2ccfg polls before an I2C transaction is considered hung
+
+
+static aoosp_loglevel_t aoosp_loglevel;
+static uint16_t         aoosp_last;     // last node found by aoosp_exec_resetinit()
+static uint64_t         aoosp_testpw;
+
+
+void aoosp_init() {
+  aoosp_loglevel= aoosp_loglevel_none;
+  Serial.printf("osp: init\n");
+}
+
+
+void aoosp_loglevel_set(aoosp_loglevel_t level) {
+  aoosp_loglevel= level;
+}
+
+
+aoosp_loglevel_t aoosp_loglevel_get() {
+  return aoosp_loglevel;
+}
+
+
+// OSP CRC-8 (polynomial 0x2F, init 0x00)
+uint8_t aoosp_crc(const uint8_t * data, int size) {
+  uint8_t crc= 0x00;
+  for( int i=0; i<size; i++ ) {
+    crc^= data[i];
+    for( int b=0; b<8; b++ ) crc= crc & 0x80 ? (uint8_t)(crc<<1 ^ 0x2F) : (uint8_t)(crc<<1);
+  }
+  return crc;
+}
+
+
+// === Printing ==============================================================
+
+
+#define AOOSP_PRT_BYTES_MAX 32 // telegrams, but also e.g. the OTP customer area
+
+
+const char * aoosp_prt_bytes(const void * buf, int size) {
+  static char str[3*AOOSP_PRT_BYTES_MAX+1];
+  const uint8_t * bytes= (const uint8_t *)buf;
+  if( size>AOOSP_PRT_BYTES_MAX ) size= AOOSP_PRT_BYTES_MAX;
+  char * p= str;
+  *p= '\0';
+  for( int i=0; i<size; i++ ) p+= sprintf(p, i==0 ? "%02X" : " %02X", bytes[i]);
+  return str;
+}
+
+
+static const char * const aoosp_prt_com_names[]= { "LVDS", "EOL", "MCU", "CAN" };
+
+
+const char * aoosp_prt_com_sio1(uint8_t com) {
+  return aoosp_prt_com_names[com & 0x03];
+}
+
+
+const char * aoosp_prt_com_sio2(uint8_t com) {
+  return aoosp_prt_com_names[com>>2 & 0x03];
+}
+
+
+int aoosp_prt_i2ccfg_speed(uint8_t speed) {
+  speed&= 0x0F;
+  return speed==0 ? 0 : 1000000/speed;
+}
+
+
+// === Send ==================================================================
+
+
+// Frames a telegram for `addr` and `tid` with `size` bytes in `payload` into tx; returns the telegram size
+static int aoosp_frame(uint8_t * tx, uint16_t addr, uint8_t tid, const uint8_t * payload, int size) {
+  int psi= size<8 ? size : 7;
+  tx[0]= 0xA0 | (addr>>6 & 0x0F);
+  tx[1]= (addr & 0x3F)<<2 | (psi>>1 & 0x03);
+  tx[2]= (psi & 1)<<7 | tid;
+  for( int i=0; i<size; i++ ) tx[3+i]= payload[i];
+  tx[3+size]= aoosp_crc(tx, 3+size);
+  return 4+size;
+}
+
+
+// Sends telegram `tid` with `payload`; when `resp` is not 0 receives `respsize` bytes of response payload
+static aoresult_t aoosp_send(const char * name, uint16_t addr, uint8_t tid, const uint8_t * payload, int size, uint8_t * resp, int respsize) {
+  uint8_t tx[AOSPI_TELE_MAXSIZE];
+  uint8_t rx[AOSPI_TELE_MAXSIZE];
+  int txsize= aoosp_frame(tx, addr, tid, payload, size);
+  aoresult_t result;
+  if( resp ) result= aospi_txrx(tx, txsize, rx, 4+respsize);
+  else result= aospi_tx(tx, txsize);
+  if( aoosp_loglevel>=aoosp_loglevel_tele ) {
+    Serial.printf("aoosp: tx %s", aoosp_prt_bytes(tx,txsize));
+    if( resp && result==aoresult_ok ) Serial.printf(" rx %s", aoosp_prt_bytes(rx,4+respsize));
+    Serial.printf("\n");
+  }
+  if( aoosp_loglevel>=aoosp_loglevel_args ) Serial.printf("aoosp: %s(%03X) %s\n", name, addr, aoresult_to_str(result));
+  if( resp && result==aoresult_ok ) memcpy(resp, rx+3, respsize);
+  return result;
+}
+
+
+static aoresult_t aoosp_send_reset(uint16_t addr) {
+  return aoosp_send("reset", addr, 0x00, 0, 0, 0, 0);
+}
+
+
+// initbidir or initloop: serial cast from addr; the last node returns its address (in the frame) and temp/stat
+static aoresult_t aoosp_send_init(const char * name, uint8_t tid, uint16_t addr, uint16_t * last) {
+  uint8_t tx[AOSPI_TELE_MAXSIZE];
+  uint8_t rx[AOSPI_TELE_MAXSIZE];
+  int txsize= aoosp_frame(tx, addr, tid, 0, 0);
+  aoresult_t result= aospi_txrx(tx, txsize, rx, 4+2);
+  if( aoosp_loglevel>=aoosp_loglevel_tele ) {
+    Serial.printf("aoosp: tx %s", aoosp_prt_bytes(tx,txsize));
+    if( result==aoresult_ok ) Serial.printf(" rx %s", aoosp_prt_bytes(rx,4+2));
+    Serial.printf("\n");
+  }
+  if( aoosp_loglevel>=aoosp_loglevel_args ) Serial.printf("aoosp: %s(%03X) %s\n", name, addr, aoresult_to_str(result));
+  if( result==aoresult_ok ) *last= (rx[0] & 0x0F)<<6 | rx[1]>>2;
+  return result;
+}
+
+
+aoresult_t aoosp_send_identify(uint16_t addr, uint32_t * id) {
+  uint8_t resp[4];
+  aoresult_t result= aoosp_send("identify", addr, 0x07, 0, 0, resp, 4);
+  if( result==aoresult_ok ) *id= (uint32_t)resp[0]<<24 | (uint32_t)resp[1]<<16 | (uint32_t)resp[2]<<8 | resp[3];
+  return result;
+}
+
+
+aoresult_t aoosp_send_readcomst(uint16_t addr, uint8_t * com) {
+  return aoosp_send("readcomst", addr, 0x44, 0, 0, com, 1);
+}
+
+
+aoresult_t aoosp_send_setcurchn(uint16_t addr, uint8_t chn, uint8_t flags, uint8_t rcur, uint8_t gcur, uint8_t bcur) {
+  uint8_t payload[3]= { chn, (uint8_t)(flags<<4 | (rcur & 0x0F)), (uint8_t)(gcur<<4 | (bcur & 0x0F)) };
+  return aoosp_send("setcurchn", addr, 0x51, payload, 3, 0, 0);
+}
+
+
+// The SAID takes the 8-bit I2C address (7-bit address shifted left)
+aoresult_t aoosp_send_i2cread8(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t count) {
+  if( count<1 || count>8 ) return aoresult_osp_arg;
+  uint8_t payload[3]= { (uint8_t)(daddr7<<1), raddr, count };
+  return aoosp_send("i2cread8", addr, 0x18, payload, 3, 0, 0);
+}
+
+
+// Payload is daddr, raddr and count bytes, so count must be 1, 2, 4 or 6 (payload sizes 3, 4, 6, 8)
+aoresult_t aoosp_send_i2cwrite8(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, uint8_t count) {
+  if( count!=1 && count!=2 && count!=4 && count!=6 ) return aoresult_osp_arg;
+  uint8_t payload[8]= { (uint8_t)(daddr7<<1), raddr };
+  memcpy(payload+2, buf, count);
+  return aoosp_send("i2cwrite8", addr, 0x19, payload, 2+count, 0, 0);
+}
+
+
+// The bytes of the last I2C read are at the end of the 8 byte response
+aoresult_t aoosp_send_readlast(uint16_t addr, uint8_t * buf, int size) {
+  if( size<1 || size>8 ) return aoresult_osp_arg;
+  uint8_t resp[8];
+  aoresult_t result= aoosp_send("readlast", addr, 0x1E, 0, 0, resp, 8);
+  if( result==aoresult_ok ) memcpy(buf, resp+8-size, size);
+  return result;
+}
+
+
+aoresult_t aoosp_send_readi2ccfg(uint16_t addr, uint8_t * flags, uint8_t * speed) {
+  uint8_t resp[1];
+  aoresult_t result= aoosp_send("readi2ccfg", addr, 0x56, 0, 0, resp, 1);
+  if( result==aoresult_ok ) { *flags= resp[0]>>4; *speed= resp[0] & 0x0F; }
+  return result;
+}
+
+
+aoresult_t aoosp_send_seti2ccfg(uint16_t addr, uint8_t flags, uint8_t speed) {
+  uint8_t payload[1]= { (uint8_t)(flags<<4 | (speed & 0x0F)) };
+  return aoosp_send("seti2ccfg", addr, 0x57, payload, 1, 0, 0);
+}
+
+
+aoresult_t aoosp_send_readotp(uint16_t addr, uint8_t otpaddr, uint8_t * buf, int size) {
+  if( size<1 || size>8 ) return aoresult_osp_arg;
+  uint8_t resp[8];
+  aoresult_t result= aoosp_send("readotp", addr, 0x58, &otpaddr, 1, resp, 8);
+  if( result==aoresult_ok ) memcpy(buf, resp, size);
+  return result;
+}
+
+
+// Payload is the bytes followed by the OTP address
+aoresult_t aoosp_send_setotp(uint16_t addr, uint8_t otpaddr, const uint8_t * buf, int size) {
+  if( size<1 || size>7 || size==6 ) return aoresult_osp_arg; // payload 2..8, but not 7
+  uint8_t payload[8];
+  memcpy(payload, buf, size);
+  payload[size]= otpaddr;
+  return aoosp_send("setotp", addr, 0x59, payload, size+1, 0, 0);
+}
+
+
+aoresult_t aoosp_send_settestpw(uint16_t addr, uint64_t pw) {
+  uint8_t payload[6];
+  for( int i=0; i<6; i++ ) payload[i]= (uint8_t)(pw>>(40-8*i));
+  return aoosp_send("settestpw", addr, 0x5F, payload, 6, 0, 0);
+}
+
+
+// === Exec ==================================================================
+
+
+aoresult_t aoosp_exec_resetinit(uint16_t * last, int * loop) {
+  uint16_t l= 0;
+  int      lp= 0;
+  aoresult_t result= aoosp_send_reset(AOOSP_ADDR_BROADCAST);
+  if( result==aoresult_ok ) {
+    delayMicroseconds(AOOSP_RESET_US);
+    aospi_dirmux_set_bidir();
+    result= aoosp_send_init("initbidir", 0x02, AOOSP_ADDR_UNICASTMIN, &l);
+    if( result!=aoresult_ok ) {
+      aospi_dirmux_set_loop();
+      lp= 1;
+      result= aoosp_send_init("initloop", 0x03, AOOSP_ADDR_UNICASTMIN, &l);
+    }
+  }
+  aoosp_last= result==aoresult_ok ? l : 0;
+  if( last ) *last= aoosp_last;
+  if( loop ) *loop= lp;
+  return result;
+}
+
+
+uint16_t aoosp_exec_resetinit_last() {
+  return aoosp_last;
+}
+
+
+aoresult_t aoosp_exec_i2cenable_get(uint16_t addr, int * enable) {
+  uint8_t otp;
+  aoresult_t result= aoosp_send_readotp(addr, 0x0D, &otp, 1);
+  if( result==aoresult_ok ) *enable= (otp>>3) & 1;
+  return result;
+}
+
+
+// Checks that the node is a SAID with I2C bridge, then powers the bus (current on channel 2)
+aoresult_t aoosp_exec_i2cpower(uint16_t addr) {
+  uint32_t id;
+  aoresult_t result= aoosp_send_identify(addr, &id);
+  if( result!=aoresult_ok ) return result;
+  if( !AOOSP_IDENTIFY_IS_SAID(id) ) return aoresult_dev_noi2cbridge;
+  int enable;
+  result= aoosp_exec_i2cenable_get(addr, &enable);
+  if( result!=aoresult_ok ) return result;
+  if( !enable ) return aoresult_dev_noi2cbridge;
+  return aoosp_send_setcurchn(addr, 2, 0, 4, 4, 4);
+}
+
+
+// Polls readi2ccfg until the I2C transaction completes
+static aoresult_t aoosp_exec_i2cwait(uint16_t addr) {
+  for( int poll=0; poll<AOOSP_I2C_POLLS; poll++ ) {
+    uint8_t flags, speed;
+    aoresult_t result= aoosp_send_readi2ccfg(addr, &flags, &speed);
+    if( result!=aoresult_ok ) return result;
+    if( flags & AOOSP_I2CCFG_FLAGS_BUSY ) continue;
+    return flags & AOOSP_I2CCFG_FLAGS_NACK ? aoresult_dev_i2cnack : aoresult_ok;
+  }
+  return aoresult_dev_i2ctimeout;
+}
+
+
+aoresult_t aoosp_exec_i2cread8(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t * buf, int count) {
+  aoresult_t result= aoosp_send_i2cread8(addr, daddr7, raddr, count);
+  if( result!=aoresult_ok ) return result;
+  result= aoosp_exec_i2cwait(addr);
+  if( result!=aoresult_ok ) return result;
+  return aoosp_send_readlast(addr, buf, count);
+}
+
+
+aoresult_t aoosp_exec_i2cwrite8(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, int count) {
+  aoresult_t result= aoosp_send_i2cwrite8(addr, daddr7, raddr, buf, count);
+  if( result!=aoresult_ok ) return result;
+  return aoosp_exec_i2cwait(addr);
+}
+
+
+// Read-modify-write of one OTP (mirror) byte: new = (old & andmask) | ormask
+aoresult_t aoosp_exec_setotp(uint16_t addr, uint8_t otpaddr, uint8_t ormask, uint8_t andmask) {
+  aoresult_t result= aoosp_send_settestpw(addr, aoosp_testpw);
+  if( result!=aoresult_ok ) return result;
+  uint8_t val;
+  result= aoosp_send_readotp(addr, otpaddr, &val, 1);
+  if( result!=aoresult_ok ) return result;
+  val= (val & andmask) | ormask;
+  return aoosp_send_setotp(addr, otpaddr, &val, 1);
+}
+
+
+// Prints the customer area of the OTP (to Serial, like the real library)
+aoresult_t aoosp_exec_otpdump(uint16_t addr, int flags) {
+  uint8_t otp[0x20];
+  for( int pos=0; pos<0x20; pos+=8 ) {
+    aoresult_t result= aoosp_send_readotp(addr, pos, otp+pos, 8);
+    if( result!=aoresult_ok ) return result;
+  }
+  if( flags & AOOSP_OTPDUMP_CUSTOMER_HEX ) {
+    for( int pos=AOOSP_OTPADDR_CUSTOMER_MIN & ~7; pos<=AOOSP_OTPADDR_CUSTOMER_MAX; pos+=8 ) {
+      Serial.printf("otp %02X:", pos);
+      for( int i=pos; i<pos+8; i++ ) if( i<AOOSP_OTPADDR_CUSTOMER_MIN ) Serial.printf("   "); else Serial.printf(" %02X", otp[i]);
+      Serial.printf("\n");
+    }
+  }
+  if( flags & AOOSP_OTPDUMP_CUSTOMER_FIELDS ) {
+    Serial.printf("  0D.3 I2C_BRIDGE_EN %d\n", (otp[0x0D]>>3) & 1);
+  }
+  return aoresult_ok;
+}
+
+
+void aoosp_said_testpw_set(uint64_t pw) {
+  aoosp_testpw= pw;
+}
+
+
+uint64_t aoosp_said_testpw_get() {
+  return aoosp_testpw;
+}
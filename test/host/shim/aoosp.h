@@ -0,0 +1,120 @@
+// aoosp.h - host stand-in for library aoosp (OSP telegrams)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _AOOSP_H_
+#define _AOOSP_H_
+
+
+#include <stdint.h>
+#include <aoresult.h>
+#include <aospi.h>
+
+
+// Version of the library this shim stands in for
+#define AOOSP_VERSION "0.4.6"
+
+
+// Addresses
+#define AOOSP_ADDR_GLOBALMIN      0x000
+#define AOOSP_ADDR_GLOBALMAX      0x3FE
+#define AOOSP_ADDR_BROADCAST      0x000
+#define AOOSP_ADDR_UNICASTMIN     0x001
+#define AOOSP_ADDR_UNICASTMAX     0x3EF
+#define AOOSP_ADDR_GROUP0         0x3F0
+#define AOOSP_ADDR_GROUP(i)       (AOOSP_ADDR_GROUP0+(i))
+#define AOOSP_ADDR_ISOK(a)        ( (a)<=AOOSP_ADDR_GLOBALMAX )
+#define AOOSP_ADDR_ISBROADCAST(a) ( (a)==AOOSP_ADDR_BROADCAST )
+#define AOOSP_ADDR_ISUNICAST(a)   ( AOOSP_ADDR_UNICASTMIN<=(a) && (a)<=AOOSP_ADDR_UNICASTMAX )
+#define OAOSP_ADDR_ISMULTICAST(a) ( AOOSP_ADDR_GROUP0<=(a) && (a)<=AOOSP_ADDR_GLOBALMAX )
+
+
+// Identify (4 bits reserved, 10 bits manufacturer, 12 bits part, 6 bits revision)
+#define AOOSP_IDENTIFY_IS_SAID(id) ( ((id)&0xFFFFFFC0)==0x00000040 )
+#define AOOSP_IDENTIFY_IS_RGBI(id) ( ((id)&0xFFFFFFC0)==0x00000000 )
+
+
+// I2C configuration of a SAID (flags in upper nibble, speed in lower nibble)
+#define AOOSP_I2CCFG_FLAGS_INT    0x08
+#define AOOSP_I2CCFG_FLAGS_12BIT  0x04
+#define AOOSP_I2CCFG_FLAGS_NACK   0x02
+#define AOOSP_I2CCFG_FLAGS_BUSY   0x01
+#define AOOSP_I2CCFG_SPEED_MAX    1    // fastest
+#define AOOSP_I2CCFG_SPEED_MIN    15   // slowest
+
+
+// OTP of a SAID
+#define AOOSP_OTPADDR_CUSTOMER_MIN     0x0D
+#define AOOSP_OTPADDR_CUSTOMER_MAX     0x1F
+#define AOOSP_OTPDUMP_CUSTOMER_HEX     0x01
+#define AOOSP_OTPDUMP_CUSTOMER_FIELDS  0x02
+
+
+// Logging of the send functions
+typedef enum aoosp_loglevel_e {
+  aoosp_loglevel_none,
+  aoosp_loglevel_args,
+  aoosp_loglevel_tele,
+} aoosp_loglevel_t;
+void             aoosp_loglevel_set(aoosp_loglevel_t level);
+aoosp_loglevel_t aoosp_loglevel_get();
+
+
+void         aoosp_init();
+uint8_t      aoosp_crc(const uint8_t * data, int size);
+
+
+// Printing helpers (return a static buffer)
+const char * aoosp_prt_bytes(const void * buf, int size);
+const char * aoosp_prt_com_sio1(uint8_t com);
+const char * aoosp_prt_com_sio2(uint8_t com);
+int          aoosp_prt_i2ccfg_speed(uint8_t speed); // in Hz
+
+
+// Send functions (one telegram each)
+aoresult_t aoosp_send_identify(uint16_t addr, uint32_t * id);
+aoresult_t aoosp_send_readcomst(uint16_t addr, uint8_t * com);
+aoresult_t aoosp_send_setcurchn(uint16_t addr, uint8_t chn, uint8_t flags, uint8_t rcur, uint8_t gcur, uint8_t bcur);
+aoresult_t aoosp_send_i2cread8(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t count);
+aoresult_t aoosp_send_i2cwrite8(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, uint8_t count);
+aoresult_t aoosp_send_readlast(uint16_t addr, uint8_t * buf, int size);
+aoresult_t aoosp_send_readi2ccfg(uint16_t addr, uint8_t * flags, uint8_t * speed);
+aoresult_t aoosp_send_seti2ccfg(uint16_t addr, uint8_t flags, uint8_t speed);
+aoresult_t aoosp_send_readotp(uint16_t addr, uint8_t otpaddr, uint8_t * buf, int size);
+aoresult_t aoosp_send_setotp(uint16_t addr, uint8_t otpaddr, const uint8_t * buf, int size);
+aoresult_t aoosp_send_settestpw(uint16_t addr, uint64_t pw);
+
+
+// Exec functions (several telegrams)
+aoresult_t aoosp_exec_resetinit(uint16_t * last=0, int * loop=0);
+uint16_t   aoosp_exec_resetinit_last();
+aoresult_t aoosp_exec_i2cenable_get(uint16_t addr, int * enable);
+aoresult_t aoosp_exec_i2cpower(uint16_t addr);
+aoresult_t aoosp_exec_i2cread8(uint16_t addr, uint8_t daddr7, uint8_t raddr, uint8_t * buf, int count);
+aoresult_t aoosp_exec_i2cwrite8(uint16_t addr, uint8_t daddr7, uint8_t raddr, const uint8_t * buf, int count);
+aoresult_t aoosp_exec_setotp(uint16_t addr, uint8_t otpaddr, uint8_t ormask, uint8_t andmask);
+aoresult_t aoosp_exec_otpdump(uint16_t addr, int flags);
+
+
+// Test password of the SAID (needed to write OTP)
+void       aoosp_said_testpw_set(uint64_t pw);
+uint64_t   aoosp_said_testpw_get();
+
+
+#endif
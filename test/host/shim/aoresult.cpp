@@ -0,0 +1,56 @@
+// aoresult.cpp - host implementation of the aoresult shim
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <stdio.h>      // fprintf()
+#include <aoresult.h>   // own
+
+
+typedef struct aoresult_name_s {
+  const char * name;
+  const char * desc;
+} aoresult_name_t;
+
+
+static const aoresult_name_t aoresult_names[aoresult_numresultcodes] = {
+  { "ok"              , "success" },
+  { "assert"          , "assertion failed" },
+  { "outofmem"        , "out of memory" },
+  { "sys_id"          , "unknown id" },
+  { "osp_arg"         , "argument error in OSP telegram" },
+  { "spi_buf"         , "SPI response buffer has wrong size" },
+  { "spi_crc"         , "SPI response has CRC error" },
+  { "spi_noclock"     , "SPI response not received (no clock)" },
+  { "dev_noi2cbridge" , "node has no I2C bridge" },
+  { "dev_i2cnack"     , "I2C device did not acknowledge" },
+  { "dev_i2ctimeout"  , "I2C transaction did not complete" },
+};
+
+
+const char * aoresult_to_str(aoresult_t result, int verbose) {
+  if( result<0 || result>=aoresult_numresultcodes ) return verbose ? "unknown result code" : "unknown";
+  return verbose ? aoresult_names[result].desc : aoresult_names[result].name;
+}
+
+
+void aoresult_assert_fail(const char * cond, const char * file, int line) {
+  fflush(stdout);
+  fprintf(stderr, "ASSERT %s (%s:%d)\n", cond, file, line);
+  abort();
+}
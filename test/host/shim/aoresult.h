@@ -0,0 +1,59 @@
+// aoresult.h - host stand-in for library aoresult (result codes)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _AORESULT_H_
+#define _AORESULT_H_
+
+
+#include <stdint.h>
+#include <stdlib.h> // abort()
+
+
+// Version of the library this shim stands in for
+#define AORESULT_VERSION "0.4.5"
+
+
+// The result codes that aoosp/aospi (and their shims) produce, plus the ones aocmd uses
+typedef enum aoresult_e {
+  aoresult_ok,
+  aoresult_assert,
+  aoresult_outofmem,
+  aoresult_sys_id,
+  aoresult_osp_arg,
+  aoresult_spi_buf,
+  aoresult_spi_crc,
+  aoresult_spi_noclock,
+  aoresult_dev_noi2cbridge,
+  aoresult_dev_i2cnack,
+  aoresult_dev_i2ctimeout,
+  aoresult_numresultcodes, // must be last
+} aoresult_t;
+
+
+// Returns a short name (verbose==0) or a description (verbose!=0) of `result`
+const char * aoresult_to_str(aoresult_t result, int verbose=0);
+
+
+// On the host a failed assert aborts (ctest reports that as a crash)
+#define AORESULT_ASSERT(cond) do { if( !(cond) ) aoresult_assert_fail(#cond,__FILE__,__LINE__); } while(0)
+void aoresult_assert_fail(const char * cond, const char * file, int line);
+
+
+#endif
@@ -0,0 +1,87 @@
+// aospi.cpp - host implementation of the aospi shim (telegrams go to the simulated chain)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <Arduino.h>    // Serial
+#include <aospi.h>      // own
+#include <aoosp.h>      // aoosp_crc()
+#include <aohost.h>     // aohost_chain_txrx()
+
+
+static int aospi_loop;      // direction mux: 0 BiDir, 1 Loop
+static int aospi_txcount;
+static int aospi_rxcount;
+static int aospi_outoena;
+static int aospi_inoena;
+
+
+void aospi_init() {
+  aospi_loop= 0;
+  aospi_outoena= 1;
+  aospi_inoena= 1;
+  Serial.printf("spi: init\n");
+}
+
+
+aoresult_t aospi_tx(const uint8_t * tx, int txsize) {
+  if( txsize<4 || txsize>AOSPI_TELE_MAXSIZE ) return aoresult_spi_buf;
+  uint8_t rx[AOSPI_TELE_MAXSIZE];
+  aospi_txcount++;
+  aohost_chain_txrx(tx, txsize, rx, false, aospi_loop);
+  return aoresult_ok;
+}
+
+
+// When `actsize` is 0 the response must have exactly `rxsize` bytes, otherwise `rxsize` is the capacity
+aoresult_t aospi_txrx(const uint8_t * tx, int txsize, uint8_t * rx, int rxsize, int * actsize) {
+  if( txsize<4 || txsize>AOSPI_TELE_MAXSIZE ) return aoresult_spi_buf;
+  uint8_t buf[AOSPI_TELE_MAXSIZE];
+  aospi_txcount++;
+  int size= aohost_chain_txrx(tx, txsize, buf, true, aospi_loop);
+  if( size==0 ) return aoresult_spi_noclock;
+  aospi_rxcount++;
+  if( actsize ? size>rxsize : size!=rxsize ) return aoresult_spi_buf;
+  memcpy(rx, buf, size);
+  if( actsize ) *actsize= size;
+  if( rx[size-1]!=aoosp_crc(rx,size-1) ) return aoresult_spi_crc;
+  return aoresult_ok;
+}
+
+
+uint32_t aospi_txrx_us() {
+  return aohost_chain_txrx_us();
+}
+
+
+void aospi_dirmux_set_bidir() { aospi_loop= 0; }
+void aospi_dirmux_set_loop()  { aospi_loop= 1; }
+int  aospi_dirmux_is_bidir()  { return !aospi_loop; }
+int  aospi_dirmux_is_loop()   { return aospi_loop; }
+
+
+int  aospi_txcount_get()      { return aospi_txcount; }
+void aospi_txcount_reset()    { aospi_txcount= 0; }
+int  aospi_rxcount_get()      { return aospi_rxcount; }
+void aospi_rxcount_reset()    { aospi_rxcount= 0; }
+
+
+void aospi_outoena_set(int enable) { aospi_outoena= enable; }
+int  aospi_outoena_get()           { return aospi_outoena; }
+void aospi_inoena_set(int enable)  { aospi_inoena= enable; }
+int  aospi_inoena_get()            { return aospi_inoena; }
@@ -0,0 +1,65 @@
+// aospi.h - host stand-in for library aospi (2wire SPI to the OSP chain)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _AOSPI_H_
+#define _AOSPI_H_
+
+
+#include <stdint.h>
+#include <aoresult.h>
+
+
+// Version of the library this shim stands in for
+#define AOSPI_VERSION "0.5.6"
+
+
+// Largest OSP telegram (3 header bytes, 8 payload bytes, 1 crc)
+#define AOSPI_TELE_MAXSIZE 12
+
+
+// The telegrams do not go over SPI but to the simulated chain (see aohost.h)
+void       aospi_init();
+aoresult_t aospi_tx(const uint8_t * tx, int txsize);
+aoresult_t aospi_txrx(const uint8_t * tx, int txsize, uint8_t * rx, int rxsize, int * actsize=0);
+uint32_t   aospi_txrx_us();
+
+
+// Direction mux (BiDir or Loop) on the OSP32 board
+void       aospi_dirmux_set_bidir();
+void       aospi_dirmux_set_loop();
+int        aospi_dirmux_is_bidir();
+int        aospi_dirmux_is_loop();
+
+
+// Telegram counters
+int        aospi_txcount_get();
+void       aospi_txcount_reset();
+int        aospi_rxcount_get();
+void       aospi_rxcount_reset();
+
+
+// Signaling LEDs ("out" and "in") on the OSP32 board
+void       aospi_outoena_set(int enable);
+int        aospi_outoena_get();
+void       aospi_inoena_set(int enable);
+int        aospi_inoena_get();
+
+
+#endif
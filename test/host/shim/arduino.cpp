@@ -0,0 +1,436 @@
+// arduino.cpp - host implementation of the Arduino core, ESP-IDF and FreeRTOS shims
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <Arduino.h>           // own
+#include <EEPROM.h>            // own
+#include <Preferences.h>       // own
+#include <esp_attr.h>          // own
+#include <esp_chip_info.h>     // own
+#include <esp_flash.h>         // own
+#include <esp_mac.h>           // own
+#include <malloc.h>            // mallinfo2()
+#include <pthread.h>           // pthread_getattr_np()
+#include <map>
+#include <string>
+#include <vector>
+#include <aohost.h>            // own
+
+
+// === Simulated time ========================================================
+
+
+static uint64_t aohost_now; // simulated time in us since start
+
+
+uint64_t aohost_clock_us() {
+  return aohost_now;
+}
+
+
+void aohost_clock_advance(uint32_t us) {
+  aohost_now+= us;
+}
+
+
+// Every read costs 1 us, so that loops polling micros() make progress
+unsigned long micros() {
+  return (unsigned long)(aohost_now++);
+}
+
+
+unsigned long millis() {
+  return (unsigned long)(aohost_now++/1000);
+}
+
+
+void delay(unsigned long ms) {
+  aohost_now+= (uint64_t)ms*1000;
+}
+
+
+void delayMicroseconds(unsigned int us) {
+  aohost_now+= us;
+}
+
+
+void yield() {
+}
+
+
+// === Print =================================================================
+
+
+size_t Print::write(const uint8_t * buf, size_t size) {
+  size_t n= 0;
+  while( size-- ) n+= write(*buf++);
+  return n;
+}
+
+
+size_t Print::printf(const char * fmt, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, fmt);
+  int len= vsnprintf(buf, sizeof buf, fmt, args);
+  va_end(args);
+  if( len<0 ) return 0;
+  if( len>=(int)sizeof buf ) { // like the core: retry with a heap buffer
+    char * big= (char *)malloc(len+1);
+    if( big==0 ) return 0;
+    va_start(args, fmt);
+    vsnprintf(big, len+1, fmt, args);
+    va_end(args);
+    len= write((const uint8_t *)big, len);
+    free(big);
+    return len;
+  }
+  return write((const uint8_t *)buf, len);
+}
+
+
+size_t Print::print(const char * s)                    { return write((const uint8_t *)s, strlen(s)); }
+size_t Print::print(const __FlashStringHelper * s)     { return print((const char *)s); }
+size_t Print::print(char ch)                           { return write((uint8_t)ch); }
+size_t Print::print(int val)                           { return printf("%d", val); }
+size_t Print::println(const char * s)                  { return print(s) + println(); }
+size_t Print::println(const __FlashStringHelper * s)   { return print(s) + println(); }
+size_t Print::println(int val)                         { return print(val) + println(); }
+size_t Print::println()                                { return write((const uint8_t *)"\r\n", 2); }
+
+
+// === Serial ================================================================
+
+
+#define AOHOST_SERIAL_FIFOSIZE 128    // UART TX FIFO of the ESP32 (Arduino has no TX ring buffer by default)
+
+
+static std::string   aohost_serial_in;              // chars fed, not yet read
+static size_t        aohost_serial_inpos;           // index of next char to read
+static std::string * aohost_serial_out;             // capture, or 0 for stdout
+static uint32_t      aohost_serial_charns= 86806;   // ns per char (10 bits at 115200 baud)
+static uint64_t      aohost_serial_drainns;         // simulated time (ns) at which the TX FIFO is empty
+HardwareSerial       Serial;
+
+
+void aohost_serial_feed(const char * s) {
+  if( aohost_serial_inpos==aohost_serial_in.size() ) { aohost_serial_in.clear(); aohost_serial_inpos= 0; }
+  aohost_serial_in+= s;
+}
+
+
+int aohost_serial_pending() {
+  return (int)(aohost_serial_in.size()-aohost_serial_inpos);
+}
+
+
+void aohost_serial_capture(std::string * capture) {
+  aohost_serial_out= capture;
+}
+
+
+// Returns the number of ns of chars still in the TX FIFO
+static uint64_t aohost_serial_backlogns() {
+  uint64_t nowns= aohost_now*1000;
+  return aohost_serial_drainns>nowns ? aohost_serial_drainns-nowns : 0;
+}
+
+
+void HardwareSerial::begin(unsigned long baud) {
+  if( baud>0 ) aohost_serial_charns= 10*1000000000ULL/baud;
+}
+
+
+size_t HardwareSerial::write(uint8_t ch) {
+  if( aohost_serial_out ) aohost_serial_out->push_back((char)ch); else fputc(ch, stdout);
+  // Time: when the FIFO is full, wait for one char to be shifted out
+  uint64_t backlog= aohost_serial_backlogns();
+  aohost_serial_drainns= aohost_now*1000 + backlog + aohost_serial_charns;
+  uint64_t fifons= AOHOST_SERIAL_FIFOSIZE*(uint64_t)aohost_serial_charns;
+  if( backlog+aohost_serial_charns > fifons ) aohost_now+= (backlog+aohost_serial_charns-fifons+999)/1000;
+  return 1;
+}
+
+
+size_t HardwareSerial::write(const uint8_t * buf, size_t size) {
+  for( size_t i=0; i<size; i++ ) write(buf[i]);
+  return size;
+}
+
+
+int HardwareSerial::availableForWrite() {
+  uint64_t used= (aohost_serial_backlogns()+aohost_serial_charns-1)/aohost_serial_charns;
+  return used>=AOHOST_SERIAL_FIFOSIZE ? 0 : AOHOST_SERIAL_FIFOSIZE-(int)used;
+}
+
+
+// Waits until the TX FIFO is empty
+void HardwareSerial::flush() {
+  aohost_now+= (aohost_serial_backlogns()+999)/1000;
+}
+
+
+int HardwareSerial::available() {
+  return aohost_serial_pending();
+}
+
+
+int HardwareSerial::read() {
+  if( aohost_serial_inpos==aohost_serial_in.size() ) return -1;
+  return (uint8_t)aohost_serial_in[aohost_serial_inpos++];
+}
+
+
+int HardwareSerial::peek() {
+  if( aohost_serial_inpos==aohost_serial_in.size() ) return -1;
+  return (uint8_t)aohost_serial_in[aohost_serial_inpos];
+}
+
+
+// === CPU and chip ==========================================================
+
+
+static uint32_t aohost_cpu_mhz= 240;
+static int      aohost_reset_reason= ESP_RST_POWERON;
+EspClass        ESP;
+
+
+uint32_t getCpuFrequencyMhz()            { return aohost_cpu_mhz; }
+uint32_t getXtalFrequencyMhz()           { return 40; }
+bool     setCpuFrequencyMhz(uint32_t mhz){ if( mhz!=240 && mhz!=160 && mhz!=80 ) return false; aohost_cpu_mhz= mhz; return true; }
+
+
+void aohost_reset_reason_set(int reason) {
+  aohost_reset_reason= reason;
+}
+
+
+esp_reset_reason_t esp_reset_reason( void ) {
+  return (esp_reset_reason_t)aohost_reset_reason;
+}
+
+
+void esp_chip_info(esp_chip_info_t * out_info) {
+  out_info->model= 9; // CHIP_ESP32S3
+  out_info->features= 0; // external flash
+  out_info->revision= 0;
+  out_info->cores= 2;
+}
+
+
+esp_err_t esp_flash_get_size(esp_flash_t * chip, uint32_t * out_size) {
+  (void)chip;
+  *out_size= 8*1024*1024;
+  return ESP_OK;
+}
+
+
+esp_err_t esp_efuse_mac_get_default(uint8_t * mac) {
+  static const uint8_t host_mac[6]= {0x24,0x6F,0x28,0x00,0x00,0x01}; // Espressif OUI, fixed for repeatable output
+  memcpy(mac, host_mac, 6);
+  return ESP_OK;
+}
+
+
+// The heap is the host heap: free is a fixed budget minus what is allocated (so deltas are real)
+#define AOHOST_HEAP_SIZE (320*1024UL)
+static uint32_t aohost_heap_minfree= AOHOST_HEAP_SIZE;
+
+
+const char * EspClass::getChipModel()    { return "ESP32-S3"; }
+uint8_t      EspClass::getChipCores()    { return 2; }
+uint8_t      EspClass::getChipRevision() { return 0; }
+uint32_t     EspClass::getSketchSize()   { return 320000; }
+uint32_t     EspClass::getMaxAllocHeap() { return getFreeHeap(); }
+
+
+uint32_t EspClass::getFreeHeap() {
+  size_t used= mallinfo2().uordblks;
+  uint32_t free= used<AOHOST_HEAP_SIZE ? AOHOST_HEAP_SIZE-used : 0;
+  if( free<aohost_heap_minfree ) aohost_heap_minfree= free;
+  return free;
+}
+
+
+uint32_t EspClass::getMinFreeHeap() {
+  getFreeHeap();
+  return aohost_heap_minfree;
+}
+
+
+void EspClass::restart() {
+  fflush(stdout);
+  exit(0);
+}
+
+
+// === FreeRTOS ==============================================================
+
+
+// Fictitious idle tasks: core 0 is idle, core 1 runs the interpreter all the time
+UBaseType_t uxTaskGetSystemState(TaskStatus_t * tasks, UBaseType_t size, uint32_t * total) {
+  if( size<3 ) return 0;
+  *total= (uint32_t)aohost_now;
+  tasks[0]= (TaskStatus_t){ xTaskGetIdleTaskHandleForCore(0), "IDLE0"   , (uint32_t)aohost_now };
+  tasks[1]= (TaskStatus_t){ xTaskGetIdleTaskHandleForCore(1), "IDLE1"   , 0 };
+  tasks[2]= (TaskStatus_t){ (TaskHandle_t)&Serial           , "loopTask", (uint32_t)aohost_now };
+  return 3;
+}
+
+
+TaskHandle_t xTaskGetIdleTaskHandleForCore(int core) {
+  static int idle[portNUM_PROCESSORS];
+  return (TaskHandle_t)&idle[core];
+}
+
+
+// The loop task of Arduino ESP32 has 8k stack; the host does not track the high water mark
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  (void)task;
+  return 8192-1024;
+}
+
+
+// Lowest address of the stack of the calling thread
+uint8_t * pxTaskGetStackStart(TaskHandle_t task) {
+  (void)task;
+  static uint8_t * start;
+  if( start==0 ) {
+    pthread_attr_t attr;
+    void * addr;
+    size_t size;
+    pthread_getattr_np(pthread_self(), &attr);
+    pthread_attr_getstack(&attr, &addr, &size);
+    pthread_attr_destroy(&attr);
+    start= (uint8_t *)addr;
+  }
+  return start;
+}
+
+
+// === EEPROM ================================================================
+
+
+#define AOHOST_EEPROM_SIZE 4096
+static uint8_t  aohost_eeprom_flash[AOHOST_EEPROM_SIZE]; // survives EEPROM.end()
+static size_t   aohost_eeprom_size;                      // 0 when not begun
+EEPROMClass     EEPROM;
+
+
+bool EEPROMClass::begin(size_t size) {
+  if( size==0 || size>AOHOST_EEPROM_SIZE ) return false;
+  aohost_eeprom_size= size;
+  return true;
+}
+
+
+uint8_t EEPROMClass::read(int address) {
+  if( address<0 || (size_t)address>=aohost_eeprom_size ) return 0;
+  return aohost_eeprom_flash[address];
+}
+
+
+void EEPROMClass::write(int address, uint8_t val) {
+  if( address<0 || (size_t)address>=aohost_eeprom_size ) return;
+  aohost_eeprom_flash[address]= val;
+}
+
+
+bool   EEPROMClass::commit() { return aohost_eeprom_size>0; }
+void   EEPROMClass::end()    { aohost_eeprom_size= 0; }
+size_t EEPROMClass::length() { return aohost_eeprom_size; }
+
+
+// === Preferences (NVS) =====================================================
+
+
+#define AOHOST_NVS_KEYMAX 15 // NVS limit on the key (and namespace) length
+
+
+typedef std::map<std::string,std::vector<uint8_t>> aohost_nvs_ns_t;
+static std::map<std::string,aohost_nvs_ns_t> aohost_nvs;
+static std::string aohost_nvs_putfailkey; // putBytes() fails for this key (empty for none)
+
+
+void aohost_nvs_clear() {
+  aohost_nvs.clear();
+  memset(aohost_eeprom_flash, 0, sizeof aohost_eeprom_flash);
+}
+
+
+void aohost_nvs_putfail(const char * key) {
+  aohost_nvs_putfailkey= key ? key : "";
+}
+
+
+// Like NVS: opening a namespace read-only fails when it does not exist
+bool Preferences::begin(const char * name, bool readOnly) {
+  if( _ns || strlen(name)>AOHOST_NVS_KEYMAX ) return false;
+  if( aohost_nvs.find(name)==aohost_nvs.end() ) {
+    if( readOnly ) return false;
+    aohost_nvs[name];
+  }
+  _ns= aohost_nvs.find(name)->first.c_str();
+  _ro= readOnly;
+  return true;
+}
+
+
+void Preferences::end() {
+  _ns= 0;
+}
+
+
+size_t Preferences::putBytes(const char * key, const void * value, size_t len) {
+  if( !_ns || _ro || !key || !value || len==0 || strlen(key)>AOHOST_NVS_KEYMAX ) return 0;
+  if( aohost_nvs_putfailkey==key ) return 0;
+  aohost_nvs[_ns][key].assign((const uint8_t *)value, (const uint8_t *)value+len);
+  return len;
+}
+
+
+// Like NVS: a buffer that is too small for the blob reads nothing
+size_t Preferences::getBytes(const char * key, void * buf, size_t maxLen) {
+  if( !_ns || !key ) return 0;
+  aohost_nvs_ns_t & ns= aohost_nvs[_ns];
+  aohost_nvs_ns_t::iterator it= ns.find(key);
+  if( it==ns.end() || it->second.size()>maxLen || !buf ) return 0;
+  memcpy(buf, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+
+size_t Preferences::getBytesLength(const char * key) {
+  if( !_ns || !key ) return 0;
+  aohost_nvs_ns_t & ns= aohost_nvs[_ns];
+  aohost_nvs_ns_t::iterator it= ns.find(key);
+  return it==ns.end() ? 0 : it->second.size();
+}
+
+
+bool Preferences::remove(const char * key) {
+  if( !_ns || _ro || !key ) return false;
+  return aohost_nvs[_ns].erase(key)>0;
+}
+
+
+bool Preferences::isKey(const char * key) {
+  if( !_ns || !key ) return false;
+  return aohost_nvs[_ns].count(key)>0;
+}
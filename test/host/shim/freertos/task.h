@@ -0,0 +1,42 @@
+// task.h - host stand-in for the FreeRTOS task API (the parts used by aocmd)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _TASK_H_
+#define _TASK_H_
+
+
+#include <freertos/FreeRTOS.h>
+
+
+// There is one task, the host main thread; the idle tasks are fictitious (see arduino.cpp)
+typedef struct {
+  TaskHandle_t xHandle;
+  const char * pcTaskName;
+  uint32_t     ulRunTimeCounter;
+} TaskStatus_t;
+
+
+UBaseType_t  uxTaskGetSystemState(TaskStatus_t * tasks, UBaseType_t size, uint32_t * total);
+TaskHandle_t xTaskGetIdleTaskHandleForCore(int core);
+UBaseType_t  uxTaskGetStackHighWaterMark(TaskHandle_t task);
+uint8_t *    pxTaskGetStackStart(TaskHandle_t task);
+
+
+#endif
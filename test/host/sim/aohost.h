@@ -0,0 +1,94 @@
+// aohost.h - control of the host build: simulated time, serial port, NVS and OSP chain
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#ifndef _AOHOST_H_
+#define _AOHOST_H_
+
+
+#include <stdint.h>
+#include <string>
+
+
+// The host build links library aocmd against shims (directory shim) instead of the Arduino core,
+// ESP-IDF, FreeRTOS, aoresult, aospi and aoosp. The shims run on simulated time and send the
+// telegrams to a simulated OSP chain. This header lets a test or benchmark program control them.
+
+
+// === Simulated time ========================================================
+
+// Time only advances when the simulation says so: delay(), delayMicroseconds(),
+// the UART once its FIFO is full, and the chain (telegram transfer, node and I2C latencies).
+// To let busy-wait loops on micros() terminate, every read of micros() costs 1 us.
+uint64_t     aohost_clock_us();
+void         aohost_clock_advance(uint32_t us);
+
+
+// === Serial ================================================================
+
+// Queues `s` for Serial.read() (as if a host sent it over the UART).
+void         aohost_serial_feed(const char * s);
+// Number of queued chars that Serial.read() did not yet consume.
+int          aohost_serial_pending();
+// Sends Serial output to `capture` (appended), or to stdout when `capture` is 0.
+void         aohost_serial_capture(std::string * capture);
+
+
+// === Non-volatile memory ===================================================
+
+// Erases NVS (Preferences) and the EEPROM (like a fresh flash).
+void         aohost_nvs_clear();
+// Makes Preferences::putBytes() fail for `key` (as when NVS is full); 0 ends that.
+void         aohost_nvs_putfail(const char * key);
+// Sets what esp_reset_reason() reports (default ESP_RST_POWERON).
+void         aohost_reset_reason_set(int reason);
+
+
+// === Simulated OSP chain ===================================================
+
+// The chain is described by a list of nodes, separated by spaces, from the MCU onwards:
+//   rgbi           an RGBI (1 channel, no I2C)
+//   said           a SAID (3 channels, I2C bridge disabled in OTP)
+//   said:i2c       a SAID with I2C bridge enabled; on its bus an EEPROM at 50 (256 bytes, 400 kHz max,
+//                  5 ms write cycle) and a sensor at 48 (reg 00 is a free running ms counter, 1 MHz max)
+// Options append to a node with ':' (e.g. said:i2c:temp=70):
+//   temp=<hex>     the raw temperature the node reports (default 6F for SAID, 8C for RGBI: both 25C)
+//   err=<hex>      error flags in STAT that stay set, also after clrerror (e.g. 04 for CE)
+//   hang           (SAID with I2C) the I2C bus never finishes a transaction
+// The word `loop` (anywhere in the list) wires the chain as Loop, otherwise it is BiDir.
+// SAIDs accept AOHOST_SAID_TESTPW as test password (needed to write the OTP mirror).
+// Returns the number of nodes, or -1 (chain unchanged) when `spec` has a syntax error.
+// The chain starts powered and uninitialized (as after power-on); call it again to replug.
+#define AOHOST_CHAIN_DEFAULT "said:i2c rgbi said rgbi"
+#define AOHOST_SAID_TESTPW   0x5A1D5A1D5A1DULL
+int          aohost_chain_config(const char * spec);
+// Number of nodes in the chain.
+int          aohost_chain_size();
+// Sends telegram `tx` into the chain and advances time: only the transfer when `wantresponse` is false,
+// otherwise also the wait for the response. A response (if any) reaches the MCU when it travels
+// the path selected by the direction mux (`loopmux`); it is written to `rx` and its size is returned.
+// Returns 0 when no response arrives (e.g. unknown address, or a telegram without response).
+int          aohost_chain_txrx(const uint8_t * tx, int txsize, uint8_t * rx, bool wantresponse, bool loopmux);
+// The duration in us of the last aohost_chain_txrx() (from start of tx to end of rx).
+uint32_t     aohost_chain_txrx_us();
+// Calls `cb` at the start of each telegram sent into the chain (0 to stop); lets a benchmark time up to a telegram.
+void         aohost_chain_ontx(void (*cb)());
+
+
+#endif
@@ -0,0 +1,565 @@
+// aohost_chain.cpp - a simulated OSP chain of RGBI and SAID nodes (with I2C devices)
+/*****************************************************************************
+ * Copyright 2025 by ams OSRAM AG                                            *
+ * All rights are reserved.                                                  *
+ *                                                                           *
+ * IMPORTANT - PLEASE READ CAREFULLY BEFORE COPYING, INSTALLING OR USING     *
+ * THE SOFTWARE.                                                             *
+ *                                                                           *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS       *
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT         *
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS         *
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT  *
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT          *
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY     *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE     *
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.      *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <aoosp.h>      // aoosp_crc(), AOOSP_I2CCFG_xxx
+#include <aohost.h>     // own
+
+
+// The simulation works at telegram level: a telegram is decoded, every node it addresses executes it,
+// and (when the node type knows the telegram and it has a response) the response is framed.
+// Time advances per the latency model below, so commands have realistic (and repeatable) durations.
+// What is not simulated: the LEDs themselves, the ADC, OTP burning, P2RAM modes, sync, test modes.
+
+
+// === Latency model =========================================================
+// SPI at 2.4 MHz from the MCU into the first node; the chain itself runs at the same rate.
+#define AOHOST_LAT_BYTE_NS     3333  // one byte on the wire
+#define AOHOST_LAT_SPI_US      8     // aospi overhead per transaction (chip select, DMA setup)
+#define AOHOST_LAT_HOP_US      1     // a node forwards a telegram (per node passed)
+#define AOHOST_LAT_EXEC_US     5     // a node executes a telegram before its response starts
+#define AOHOST_LAT_RXWAIT_US   500   // aospi gives up waiting for a response (no clock)
+#define AOHOST_LAT_RESET_US    150   // nodes ignore telegrams this long after a reset
+#define AOHOST_LAT_I2C_BITS    9     // bits per byte on I2C (8 data, 1 ack)
+#define AOHOST_LAT_EEWRITE_US  5000  // EEPROM write cycle (device NACKs meanwhile)
+
+
+// === Node model ============================================================
+
+
+#define AOHOST_STATE_UNINIT    0
+#define AOHOST_STATE_SLEEP     1
+#define AOHOST_STATE_ACTIVE    2
+#define AOHOST_STATE_DEEPSLEEP 3
+
+
+// STAT: STATE(2) | SAID:TSTOTP RGBI:OTP | SAID:OV RGBI:COM | CE | LOS | OT | UV
+#define AOHOST_STAT_UV         0x01  // under voltage (set at power-on and reset, cleared by clrerror)
+#define AOHOST_STAT_CE         0x08  // CRC error (in a received telegram)
+#define AOHOST_STAT_TSTOTP     0x20  // SAID: test password accepted
+
+
+// COMST: SAID:DIR | SIO2 | SIO1 (2 bits each: LVDS, EOL, MCU, CAN)
+#define AOHOST_COM_LVDS        0
+#define AOHOST_COM_EOL         1
+#define AOHOST_COM_MCU         2
+#define AOHOST_COM_DIRLOOP     0x10
+
+
+#define AOHOST_SAID_OTP_I2CEN_ADDR 0x0D // OTP byte with the I2C bridge enable
+#define AOHOST_SAID_OTP_I2CEN_BIT  0x08
+#define AOHOST_I2CSPEED_RESET      10   // I2C speed code after reset (100 kHz)
+
+
+#define AOHOST_DEV_EEPROM      0x50
+#define AOHOST_DEV_EEPROM_PAGE 16
+#define AOHOST_DEV_SENSOR      0x48
+
+
+typedef struct aohost_node_s {
+  // Configuration (from the chain description)
+  bool     said;
+  bool     i2cbus;      // SAID has I2C devices on its bus (and the bridge enabled in OTP)
+  bool     hang;        // I2C bus hangs
+  uint8_t  temp;
+  uint8_t  errstuck;    // error flags that clrerror does not clear
+  // Registers (reset by the reset telegram)
+  uint16_t addr;        // 0 when not initialized
+  uint8_t  state;
+  uint8_t  errors;
+  uint8_t  tstotp;
+  uint16_t mult;
+  uint8_t  setup;
+  uint8_t  otth[3];
+  uint8_t  pwm[3][6];
+  uint8_t  cur[3][2];
+  uint8_t  tcoeff[3][4];
+  uint8_t  i2ccfg;      // flags<<4 | speed
+  uint8_t  last[8];     // I2C read data (right aligned)
+  uint64_t i2cdone;     // time (us) the current I2C transaction ends
+  uint8_t  i2cnack;     // NACK flag of the current transaction
+  uint8_t  otp[0x20];   // OTP mirror (survives reset)
+  // I2C devices
+  uint8_t  eeprom[256];
+  uint64_t eebusy;      // time (us) the EEPROM write cycle ends
+  uint8_t  sensor[16];
+} aohost_node_t;
+
+
+static std::vector<aohost_node_t> aohost_chain;
+static bool     aohost_chain_loop;       // chain wired as Loop (last node SIO2 back to the MCU)
+static uint64_t aohost_chain_resetdone;  // time (us) the last reset completes
+static uint32_t aohost_chain_lastus;     // duration of last txrx
+static bool     aohost_chain_configured;
+static void   (*aohost_chain_txcb)();     // called at the start of each telegram (or 0)
+
+
+// Puts node `n` in its reset state (registers only, not the OTP mirror or the I2C devices)
+static void aohost_node_reset(aohost_node_t * n) {
+  n->addr= 0;
+  n->state= AOHOST_STATE_UNINIT;
+  n->errors= AOHOST_STAT_UV;
+  n->tstotp= 0;
+  n->mult= 0;
+  n->setup= n->said ? 0x32 : 0x31;
+  n->otth[0]= 0x00; n->otth[1]= 0x9B; n->otth[2]= 0xA5;
+  memset(n->pwm, 0, sizeof n->pwm);
+  memset(n->cur, 0, sizeof n->cur);
+  memset(n->tcoeff, 0, sizeof n->tcoeff);
+  n->i2ccfg= AOHOST_I2CSPEED_RESET;
+  memset(n->last, 0, sizeof n->last);
+  n->i2cdone= 0;
+  n->i2cnack= 0;
+}
+
+
+// Parses one node description (e.g. "said:i2c:temp=70") into `n`; returns false on error
+static bool aohost_node_parse(const std::string & desc, aohost_node_t * n) {
+  memset(n, 0, sizeof *n);
+  size_t pos= desc.find(':');
+  std::string type= desc.substr(0, pos);
+  if( type=="said" ) n->said= true;
+  else if( type!="rgbi" ) return false;
+  n->temp= n->said ? 0x6F : 0x8C;
+  while( pos!=std::string::npos ) {
+    size_t next= desc.find(':', pos+1);
+    std::string opt= desc.substr(pos+1, next==std::string::npos ? std::string::npos : next-pos-1);
+    char * end;
+    if( opt=="i2c" && n->said ) n->i2cbus= true;
+    else if( opt=="hang" && n->said ) n->hang= true;
+    else if( opt.compare(0,5,"temp=")==0 ) { n->temp= (uint8_t)strtoul(opt.c_str()+5, &end, 16); if( *end || opt.size()==5 ) return false; }
+    else if( opt.compare(0,4,"err=")==0 ) { n->errstuck= (uint8_t)strtoul(opt.c_str()+4, &end, 16) & 0x1F; if( *end || opt.size()==4 ) return false; }
+    else return false;
+    pos= next;
+  }
+  if( n->i2cbus ) {
+    n->otp[AOHOST_SAID_OTP_I2CEN_ADDR]|= AOHOST_SAID_OTP_I2CEN_BIT;
+    for( int i=0; i<256; i++ ) n->eeprom[i]= (uint8_t)(i*7+0x10); // some recognizable content
+    for( int i=0; i<16; i++ ) n->sensor[i]= (uint8_t)(0xA0+i);
+  }
+  aohost_node_reset(n);
+  return true;
+}
+
+
+int aohost_chain_config(const char * spec) {
+  std::vector<aohost_node_t> chain;
+  bool loop= false;
+  const char * s= spec;
+  while( *s ) {
+    while( *s==' ' ) s++;
+    const char * e= s;
+    while( *e && *e!=' ' ) e++;
+    if( e==s ) break;
+    std::string word(s, e-s);
+    if( word=="loop" ) {
+      loop= true;
+    } else {
+      aohost_node_t n;
+      if( !aohost_node_parse(word, &n) ) return -1;
+      chain.push_back(n);
+    }
+    s= e;
+  }
+  aohost_chain= chain;
+  aohost_chain_loop= loop;
+  aohost_chain_resetdone= 0;
+  aohost_chain_configured= true;
+  return (int)aohost_chain.size();
+}
+
+
+static void aohost_chain_default() {
+  if( !aohost_chain_configured ) aohost_chain_config(AOHOST_CHAIN_DEFAULT);
+}
+
+
+int aohost_chain_size() {
+  aohost_chain_default();
+  return (int)aohost_chain.size();
+}
+
+
+uint32_t aohost_chain_txrx_us() {
+  return aohost_chain_lastus;
+}
+
+
+void aohost_chain_ontx(void (*cb)()) {
+  aohost_chain_txcb= cb;
+}
+
+
+// === I2C ===================================================================
+
+
+// Frequency in Hz of I2C speed code `speed` (1 fastest .. 15 slowest)
+static uint32_t aohost_i2c_freq(uint8_t speed) {
+  return speed==0 ? 0 : 1000000/speed;
+}
+
+
+// Max frequency of device `daddr7` on the bus of `n`, 0 if not present
+static uint32_t aohost_i2c_devmax(const aohost_node_t * n, uint8_t daddr7) {
+  if( !n->i2cbus ) return 0;
+  if( daddr7==AOHOST_DEV_EEPROM ) return 400000;
+  if( daddr7==AOHOST_DEV_SENSOR ) return 1000000;
+  return 0;
+}
+
+
+// The I2C bus of `n` is powered via channel 2 (its current drives the pull-ups)
+static bool aohost_i2c_powered(const aohost_node_t * n) {
+  return (n->cur[2][0] & 0x0F) || n->cur[2][1];
+}
+
+
+// Starts an I2C transaction of `bytes` bytes (address included) at `now`; returns true if the device ACKs
+static bool aohost_i2c_start(aohost_node_t * n, uint64_t now, uint8_t daddr7, int bytes) {
+  uint32_t freq= aohost_i2c_freq(n->i2ccfg & 0x0F);
+  uint32_t max= aohost_i2c_devmax(n, daddr7);
+  bool ack= aohost_i2c_powered(n) && max>0 && freq<=max;
+  if( ack && daddr7==AOHOST_DEV_EEPROM && now<n->eebusy ) ack= false; // write cycle
+  if( !ack ) bytes= 1; // transaction stops after the address byte
+  n->i2cdone= n->hang ? UINT64_MAX : now + ((uint64_t)bytes*AOHOST_LAT_I2C_BITS+2)*1000000/freq; // +2: start, stop
+  n->i2cnack= !ack;
+  return ack;
+}
+
+
+static uint8_t aohost_i2c_readreg(aohost_node_t * n, uint64_t now, uint8_t daddr7, uint8_t raddr) {
+  if( daddr7==AOHOST_DEV_EEPROM ) return n->eeprom[raddr];
+  if( raddr==0 ) return (uint8_t)(now/1000); // free running ms counter
+  return n->sensor[raddr%16];
+}
+
+
+static void aohost_i2c_writereg(aohost_node_t * n, uint8_t daddr7, uint8_t raddr, uint8_t val) {
+  if( daddr7==AOHOST_DEV_EEPROM ) n->eeprom[raddr]= val;
+  else if( raddr!=0 ) n->sensor[raddr%16]= val;
+}
+
+
+// i2cread: payload daddr8 raddr count
+static void aohost_i2c_read(aohost_node_t * n, uint64_t now, const uint8_t * payload) {
+  uint8_t daddr7= payload[0]>>1;
+  int count= payload[2]<1 ? 1 : (payload[2]>8 ? 8 : payload[2]);
+  if( now<n->i2cdone ) return; // busy: telegram is ignored
+  // daddr+W, raddr, daddr+R (restart), data
+  if( !aohost_i2c_start(n, now, daddr7, 3+count) ) return;
+  memset(n->last, 0, sizeof n->last);
+  for( int i=0; i<count; i++ ) n->last[8-count+i]= aohost_i2c_readreg(n, now, daddr7, (uint8_t)(payload[1]+i));
+}
+
+
+// i2cwrite: payload daddr8 raddr byte...
+static void aohost_i2c_write(aohost_node_t * n, uint64_t now, const uint8_t * payload, int count) {
+  uint8_t daddr7= payload[0]>>1;
+  if( now<n->i2cdone ) return; // busy: telegram is ignored
+  // daddr+W, raddr, data
+  if( !aohost_i2c_start(n, now, daddr7, 2+count) ) return;
+  for( int i=0; i<count; i++ ) {
+    uint8_t raddr= payload[1]+i;
+    if( daddr7==AOHOST_DEV_EEPROM ) raddr= (payload[1] & ~(AOHOST_DEV_EEPROM_PAGE-1)) | (raddr & (AOHOST_DEV_EEPROM_PAGE-1)); // wraps in page
+    aohost_i2c_writereg(n, daddr7, raddr, payload[2+i]);
+  }
+  if( daddr7==AOHOST_DEV_EEPROM ) n->eebusy= n->i2cdone + AOHOST_LAT_EEWRITE_US;
+}
+
+
+// === Telegrams =============================================================
+
+
+static uint8_t aohost_node_stat(const aohost_node_t * n) {
+  return n->state<<6 | (n->said ? n->tstotp : 0) | n->errors | n->errstuck;
+}
+
+
+// Node `n` executes telegram `tid` with `payload` of `size` bytes at time `now`.
+// Returns the response payload size (written to `resp`), 0 for no response, -1 if the node ignores it.
+static int aohost_node_exec(aohost_node_t * n, uint64_t now, int tid, const uint8_t * payload, int size, uint8_t * resp) {
+  // The _sr variants (bit 5 set) execute the plain telegram and return temp and stat
+  bool sr= (tid & 0x20) && tid!=0x20;
+  int  base= sr ? tid & ~0x20 : tid;
+  int  chn= size>0 ? payload[0] : 0;
+  int  rsize= 0;
+  #define AOHOST_EXPECT(cond) do { if( !(cond) ) return -1; } while(0)
+  switch( base ) {
+    case 0x01: // clrerror
+      AOHOST_EXPECT( size==0 );
+      n->errors= 0;
+      break;
+    case 0x04: case 0x05: case 0x06: // gosleep, goactive, godeepsleep
+      AOHOST_EXPECT( size==0 );
+      n->state= base==0x04 ? AOHOST_STATE_SLEEP : (base==0x05 ? AOHOST_STATE_ACTIVE : AOHOST_STATE_DEEPSLEEP);
+      break;
+    case 0x07: // identify
+      AOHOST_EXPECT( size==0 && !sr );
+      resp[0]= 0x00; resp[1]= 0x00; resp[2]= 0x00; resp[3]= n->said ? 0x40 : 0x00;
+      rsize= 4;
+      break;
+    case 0x0C: // readmult
+      AOHOST_EXPECT( size==0 && !sr );
+      resp[0]= n->mult>>8; resp[1]= n->mult & 0xFF;
+      rsize= 2;
+      break;
+    case 0x0D: // setmult
+      AOHOST_EXPECT( size==2 );
+      n->mult= (payload[0]<<8 | payload[1]) & 0x7FFF;
+      break;
+    case 0x0F: case 0x11: case 0x12: case 0x13: case 0x14: case 0x15: case 0x16: case 0x17: // sync, P2RAM
+      AOHOST_EXPECT( size==0 );
+      break;
+    case 0x18: // i2cread
+      AOHOST_EXPECT( n->said && size==3 );
+      if( n->otp[AOHOST_SAID_OTP_I2CEN_ADDR] & AOHOST_SAID_OTP_I2CEN_BIT ) aohost_i2c_read(n, now, payload);
+      break;
+    case 0x19: // i2cwrite
+      AOHOST_EXPECT( n->said && size>=3 );
+      if( n->otp[AOHOST_SAID_OTP_I2CEN_ADDR] & AOHOST_SAID_OTP_I2CEN_BIT ) aohost_i2c_write(n, now, payload, size-2);
+      break;
+    case 0x1E: // readlast
+      AOHOST_EXPECT( n->said && size==0 && !sr );
+      memcpy(resp, n->last, 8);
+      rsize= 8;
+      break;
+    case 0x40: // readstat
+      AOHOST_EXPECT( size==0 && !sr );
+      resp[0]= aohost_node_stat(n);
+      rsize= 1;
+      break;
+    case 0x42: // readtempstat
+      AOHOST_EXPECT( size==0 && !sr );
+      resp[0]= n->temp; resp[1]= aohost_node_stat(n);
+      rsize= 2;
+      break;
+    case 0x44: { // readcomst
+      AOHOST_EXPECT( size==0 && !sr );
+      int pos= (int)(n-&aohost_chain[0]);
+      bool last= pos==(int)aohost_chain.size()-1;
+      uint8_t sio1= pos==0 ? AOHOST_COM_MCU : AOHOST_COM_LVDS;
+      uint8_t sio2= last ? (aohost_chain_loop ? AOHOST_COM_MCU : AOHOST_COM_EOL) : AOHOST_COM_LVDS;
+      resp[0]= sio2<<2 | sio1 | (n->said && aohost_chain_loop ? AOHOST_COM_DIRLOOP : 0);
+      rsize= 1;
+      break;
+    }
+    case 0x46: // readledst(chn)
+      AOHOST_EXPECT( size==(n->said?1:0) && !sr && chn<3 );
+      resp[0]= 0x00;
+      rsize= 1;
+      break;
+    case 0x48: // readtemp
+      AOHOST_EXPECT( size==0 && !sr );
+      resp[0]= n->temp;
+      rsize= 1;
+      break;
+    case 0x4A: // readotth
+      AOHOST_EXPECT( size==0 && !sr );
+      memcpy(resp, n->otth, 3);
+      rsize= 3;
+      break;
+    case 0x4B: // setotth
+      AOHOST_EXPECT( size==3 );
+      memcpy(n->otth, payload, 3);
+      break;
+    case 0x4C: // readsetup
+      AOHOST_EXPECT( size==0 && !sr );
+      resp[0]= n->setup;
+      rsize= 1;
+      break;
+    case 0x4D: // setsetup
+      AOHOST_EXPECT( size==1 );
+      n->setup= payload[0];
+      break;
+    case 0x4E: // readpwm (RGBI), readpwmchn (SAID)
+      AOHOST_EXPECT( size==(n->said?1:0) && !sr && chn<3 );
+      memcpy(resp, n->pwm[chn], 6);
+      rsize= 6;
+      break;
+    case 0x4F: // setpwm (RGBI), setpwmchn (SAID)
+      AOHOST_EXPECT( n->said ? (size==8 && chn<3) : size==6 );
+      memcpy(n->pwm[n->said?chn:0], payload+(n->said?2:0), 6);
+      break;
+    case 0x50: // readcurchn
+      AOHOST_EXPECT( n->said && size==1 && !sr && chn<3 );
+      memcpy(resp, n->cur[chn], 2);
+      rsize= 2;
+      break;
+    case 0x51: // setcurchn
+      AOHOST_EXPECT( n->said && size==3 && chn<3 );
+      memcpy(n->cur[chn], payload+1, 2);
+      break;
+    case 0x52: // readtcoeff
+      AOHOST_EXPECT( n->said && size==1 && !sr && chn<3 );
+      memcpy(resp, n->tcoeff[chn], 4);
+      rsize= 4;
+      break;
+    case 0x53: // settcoeff
+      AOHOST_EXPECT( n->said && size==5 && chn<3 );
+      memcpy(n->tcoeff[chn], payload+1, 4);
+      break;
+    case 0x56: // readi2ccfg
+      AOHOST_EXPECT( n->said && size==0 && !sr );
+      resp[0]= n->i2ccfg & 0xCF;
+      if( now<n->i2cdone ) resp[0]|= AOOSP_I2CCFG_FLAGS_BUSY<<4;
+      if( n->i2cnack ) resp[0]|= AOOSP_I2CCFG_FLAGS_NACK<<4;
+      rsize= 1;
+      break;
+    case 0x57: // seti2ccfg (the status flags are read-only)
+      AOHOST_EXPECT( n->said && size==1 );
+      if( payload[0] & 0x0F ) n->i2ccfg= payload[0] & 0xCF;
+      break;
+    case 0x58: // readotp
+      AOHOST_EXPECT( size==1 && !sr );
+      for( int i=0; i<8; i++ ) resp[i]= payload[0]+i<0x20 ? n->otp[payload[0]+i] : 0x00;
+      rsize= 8;
+      break;
+    case 0x59: // setotp (writes the mirror; needs the test password)
+      AOHOST_EXPECT( n->said && size>=2 );
+      if( n->tstotp ) for( int i=0; i<size-1; i++ ) if( payload[size-1]+i<0x20 ) n->otp[payload[size-1]+i]= payload[i];
+      break;
+    case 0x5F: { // settestpw
+      AOHOST_EXPECT( n->said && size==6 );
+      uint64_t pw= 0;
+      for( int i=0; i<6; i++ ) pw= pw<<8 | payload[i];
+      n->tstotp= pw==AOHOST_SAID_TESTPW ? AOHOST_STAT_TSTOTP : 0;
+      break;
+    }
+    default:
+      return -1;
+  }
+  #undef AOHOST_EXPECT
+  if( sr ) { resp[0]= n->temp; resp[1]= aohost_node_stat(n); rsize= 2; }
+  return rsize;
+}
+
+
+// Frames a response from node address `addr` for `tid` with `size` bytes in `payload` into `rx`; returns its size
+static int aohost_chain_frame(uint8_t * rx, uint16_t addr, int tid, const uint8_t * payload, int size) {
+  int psi= size<8 ? size : 7;
+  rx[0]= 0xA0 | (addr>>6 & 0x0F);
+  rx[1]= (addr & 0x3F)<<2 | (psi>>1 & 0x03);
+  rx[2]= (psi & 1)<<7 | tid;
+  memcpy(rx+3, payload, size);
+  rx[3+size]= aoosp_crc(rx, 3+size);
+  return 4+size;
+}
+
+
+// Serial cast telegrams (init, p4err, ask): every node takes part. Returns response payload size.
+// `*responder` gets the index of the responding node (-1 if none).
+static int aohost_chain_serialcast(uint16_t addr, int tid, const uint8_t * payload, int size, uint8_t * resp, int * responder) {
+  int num= (int)aohost_chain.size();
+  *responder= -1;
+  if( num==0 ) return 0;
+  switch( tid ) {
+    case 0x02: case 0x03: { // initbidir, initloop: node i gets addr+i; the last one answers
+      if( size!=0 ) return 0;
+      for( int i=0; i<num; i++ ) {
+        aohost_chain[i].addr= addr+i;
+        if( aohost_chain[i].state==AOHOST_STATE_UNINIT ) aohost_chain[i].state= AOHOST_STATE_SLEEP;
+      }
+      // The last node only answers when its SIO2 matches the direction (EOL for BiDir, connected for Loop)
+      if( (tid==0x03)!=aohost_chain_loop ) return 0;
+      *responder= num-1;
+      break;
+    }
+    case 0x08: case 0x09: // p4errbidir, p4errloop: first node with an error answers, otherwise the last
+      if( size!=0 ) return 0;
+      *responder= num-1;
+      for( int i=0; i<num; i++ ) if( (aohost_chain[i].errors|aohost_chain[i].errstuck) & 0x1F ) { *responder= i; break; }
+      break;
+    case 0x0A: case 0x0B: { // asktinfo, askvinfo: aggregated max and min, the last node answers
+      if( size!=0 && size!=2 ) return 0;
+      uint8_t max= size ? payload[0] : 0x00, min= size ? payload[1] : 0xFF;
+      for( int i=0; i<num; i++ ) {
+        uint8_t v= tid==0x0A ? aohost_chain[i].temp : (aohost_chain[i].said ? 0x9A : 0x85);
+        if( v>max ) max= v;
+        if( v<min ) min= v;
+      }
+      resp[0]= max; resp[1]= min;
+      *responder= num-1;
+      return 2;
+    }
+  }
+  if( *responder<0 ) return 0;
+  resp[0]= aohost_chain[*responder].temp;
+  resp[1]= aohost_node_stat(&aohost_chain[*responder]);
+  return 2;
+}
+
+
+int aohost_chain_txrx(const uint8_t * tx, int txsize, uint8_t * rx, bool wantresponse, bool loopmux) {
+  aohost_chain_default();
+  if( aohost_chain_txcb ) aohost_chain_txcb();
+  uint64_t start= aohost_clock_us();
+  int      num= (int)aohost_chain.size();
+  uint64_t now= start + AOHOST_LAT_SPI_US + ((uint64_t)txsize*AOHOST_LAT_BYTE_NS+999)/1000; // telegram sent
+  int      respsize= -1;   // response payload size (-1 for none)
+  int      responder= -1;  // index of node that responds
+  uint8_t  resp[8];
+
+  // Decode; the first node checks the telegram (and drops it when invalid)
+  uint16_t addr= (tx[0] & 0x0F)<<6 | tx[1]>>2;
+  int      psi= (tx[1] & 0x03)<<1 | tx[2]>>7;
+  int      size= psi<7 ? psi : 8;
+  int      tid= tx[2] & 0x7F;
+  bool     valid= txsize>=4 && (tx[0] & 0xF0)==0xA0 && txsize==4+size && tx[txsize-1]==aoosp_crc(tx, txsize-1);
+  bool     inreset= now<aohost_chain_resetdone;
+  if( num>0 && !valid && !inreset ) aohost_chain[0].errors|= AOHOST_STAT_CE;
+
+  if( valid && !inreset ) {
+    const uint8_t * payload= tx+3;
+    if( tid==0x00 ) { // reset: every node (initialized or not)
+      for( int i=0; i<num; i++ ) aohost_node_reset(&aohost_chain[i]);
+      aohost_chain_resetdone= now + AOHOST_LAT_RESET_US;
+    } else if( tid==0x02 || tid==0x03 || tid==0x08 || tid==0x09 || tid==0x0A || tid==0x0B ) {
+      respsize= aohost_chain_serialcast(addr, tid, payload, size, resp, &responder);
+      if( responder<0 ) respsize= -1;
+    } else {
+      for( int i=0; i<num; i++ ) {
+        aohost_node_t * n= &aohost_chain[i];
+        bool hit= n->addr!=0 && ( addr==0 || addr==n->addr || (addr>=AOOSP_ADDR_GROUP0 && addr<AOOSP_ADDR_GROUP0+15 && (n->mult>>(addr-AOOSP_ADDR_GROUP0) & 1)) );
+        if( !hit ) continue;
+        int r= aohost_node_exec(n, now + (i+1)*AOHOST_LAT_HOP_US + AOHOST_LAT_EXEC_US, tid, payload, size, resp);
+        if( r>0 && addr==n->addr ) { respsize= r; responder= i; } // only unicast gets an answer
+      }
+    }
+  }
+
+  // The response travels back (BiDir) or onwards to the MCU (Loop), if the mux selects that path
+  int rxsize= 0;
+  if( respsize>0 && responder>=0 ) {
+    bool reach= loopmux==aohost_chain_loop;
+    int  hops= aohost_chain_loop ? num-responder : responder+1;
+    uint64_t done= now + (uint64_t)(responder+1)*AOHOST_LAT_HOP_US + AOHOST_LAT_EXEC_US + hops*AOHOST_LAT_HOP_US + ((uint64_t)(4+respsize)*AOHOST_LAT_BYTE_NS+999)/1000;
+    if( reach ) rxsize= aohost_chain_frame(rx, aohost_chain[responder].addr, tid, resp, respsize);
+    if( wantresponse ) now= reach ? done : now + AOHOST_LAT_RXWAIT_US;
+  } else if( wantresponse ) {
+    now+= AOHOST_LAT_RXWAIT_US;
+  }
+  aohost_chain_lastus= (uint32_t)(now-start);
+  aohost_clock_advance(aohost_chain_lastus);
+  return rxsize;
+}